@@ -5,6 +5,12 @@
 
 #define LOCTEXT_NAMESPACE "FMassTrafficModule"
 
+// LLM tags
+LLM_DEFINE_TAG(MassTraffic_LaneData);
+LLM_DEFINE_TAG(MassTraffic_Intersections);
+LLM_DEFINE_TAG(MassTraffic_PathFinder);
+LLM_DEFINE_TAG(MassTraffic_Scratch);
+
 // CVars
 int32 GDebugMassTraffic = 0;
 FAutoConsoleVariableRef CVarDebugMassTraffic(
@@ -224,6 +230,15 @@ FAutoConsoleVariableRef CVarMassTrafficOverseer(
 	ECVF_Cheat
 	);
 
+int32 GMassTrafficMesoscopic = 1;
+FAutoConsoleVariableRef CVarMassTrafficMesoscopic(
+	TEXT("MassTraffic.Mesoscopic"),
+	GMassTrafficMesoscopic,
+	TEXT(" 0 = Off. All mesoscopic vehicles are re-emitted as individual vehicles\n")
+	TEXT(" 1 = Simulate lanes far from all viewers as aggregate flow when UMassTrafficSettings::bMesoscopicTraffic is enabled\n"),
+	ECVF_Scalability
+	);
+
 int32 GMassTrafficRepairDamage = 1;
 FAutoConsoleVariableRef CVarMassTrafficRepairDamage(
 	TEXT("MassTraffic.RepairDamage"),
@@ -249,6 +264,24 @@ FAutoConsoleVariableRef CVarMassTrafficNumParkedVehiclesScale(
 	ECVF_Scalability
 	);
 
+int32 GMassTrafficParallelSpawnPointGeneration = 1;
+FAutoConsoleVariableRef CVarMassTrafficParallelSpawnPointGeneration(
+	TEXT("MassTraffic.ParallelSpawnPointGeneration"),
+	GMassTrafficParallelSpawnPointGeneration,
+	TEXT("Whether traffic vehicle spawn points are generated for lanes in parallel. Each lane is seeded independently, so\n")
+	TEXT("the generated points are the same either way."),
+	ECVF_Scalability
+	);
+
+int32 GMassTrafficParallelVisualizationGathering = 1;
+FAutoConsoleVariableRef CVarMassTrafficParallelVisualizationGathering(
+	TEXT("MassTraffic.ParallelVisualizationGathering"),
+	GMassTrafficParallelVisualizationGathering,
+	TEXT("Whether traffic visualization processors gather instanced static mesh transforms & custom data on worker\n")
+	TEXT("threads, leaving only adding them to the representation subsystem on the game thread."),
+	ECVF_Scalability
+	);
+
 float GMassTrafficLODPlayerVehicleDistanceScale = 0.0f;
 FAutoConsoleVariableRef CMassTrafficLODPlayerVehicleDistanceBias(
 	TEXT("MassTraffic.LODPlayerVehicleDistanceScale"),
@@ -281,6 +314,50 @@ FAutoConsoleVariableRef CVarMassTrafficLinearSpeedSleepThreshold(
 	ECVF_Scalability
 	);
 	
+int32 GMassTrafficQueueSleepEnabled = 1;
+FAutoConsoleVariableRef CVarMassTrafficQueueSleepEnabled(
+	TEXT("MassTraffic.QueueSleepEnabled"),
+	GMassTrafficQueueSleepEnabled,
+	TEXT("Whether to allow vehicles stopped in a queue behind another stopped vehicle to skip vehicle control until the lane wakes them.\n"),
+	ECVF_Scalability
+	);
+
+float GMassTrafficQueueSleepSpeedThreshold = 1.0f;
+FAutoConsoleVariableRef CVarMassTrafficQueueSleepSpeedThreshold(
+	TEXT("MassTraffic.QueueSleepSpeedThreshold"),
+	GMassTrafficQueueSleepSpeedThreshold,
+	TEXT("Speed (cm/s) below which vehicles are considered stopped for queue sleeping.\n"),
+	ECVF_Scalability
+	);
+
+int32 GMassTrafficAnalyticMotion = 1;
+FAutoConsoleVariableRef CVarMassTrafficAnalyticMotion(
+	TEXT("MassTraffic.AnalyticMotion"),
+	GMassTrafficAnalyticMotion,
+	TEXT("Whether to allow Low & Off LOD vehicles on free flowing lanes to follow a closed form trajectory, skipping\n")
+	TEXT("target speed & lane exit evaluation until their next vehicle, next lane or lane exit could affect them.\n"),
+	ECVF_Scalability
+	);
+
+int32 GMassTrafficOcclusionCulling = 1;
+FAutoConsoleVariableRef CVarMassTrafficOcclusionCulling(
+	TEXT("MassTraffic.OcclusionCulling"),
+	GMassTrafficOcclusionCulling,
+	TEXT("Whether vehicles on lanes baked as occluded from all viewers (see UMassTrafficSettings::OcclusionData) are\n")
+	TEXT("treated as outside the view frustum for visualization LOD.\n"),
+	ECVF_Scalability
+	);
+
+int32 GMassTrafficTimeSlicing = 1;
+FAutoConsoleVariableRef CVarMassTrafficTimeSlicing(
+	TEXT("MassTraffic.TimeSlicing"),
+	GMassTrafficTimeSlicing,
+	TEXT("Whether expensive traffic processors spread their work across frames within their TimeSliceBudgetMicroseconds.\n")
+	TEXT("0 = Off. Process all work each frame (within any item limits)\n")
+	TEXT("1 = On (default)\n"),
+	ECVF_Scalability
+	);
+
 float GMassTrafficControlInputWakeTolerance = 0.02f;
 FAutoConsoleVariableRef CVarMassTrafficControlInputWakeTolerance(
 	TEXT("MassTraffic.ControlInputWakeTolerance"),
@@ -24,6 +24,7 @@ void UMassTrafficActorVehiclePhysicsProcessor::ConfigureQueries(const TSharedRef
 	ChaosPhysicsVehiclesQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
 	ChaosPhysicsVehiclesQuery.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadOnly);
 	ChaosPhysicsVehiclesQuery.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly);
+	ChaosPhysicsVehiclesQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	ChaosPhysicsVehiclesQuery.AddRequirement<FMassTrafficVehicleDamageFragment>(EMassFragmentAccess::ReadOnly);
 	ChaosPhysicsVehiclesQuery.AddRequirement<FMassActorFragment>(EMassFragmentAccess::ReadWrite);
 	ChaosPhysicsVehiclesQuery.AddRequirement<FMassTrafficDebugFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
@@ -38,9 +39,16 @@ void UMassTrafficActorVehiclePhysicsProcessor::Execute(FMassEntityManager& Entit
 		const TConstArrayView<FMassTrafficPIDVehicleControlFragment> PIDVehicleControlFragments = Context.GetFragmentView<FMassTrafficPIDVehicleControlFragment>();
 		const TConstArrayView<FMassTrafficVehicleDamageFragment> VehicleDamageFragments = Context.GetFragmentView<FMassTrafficVehicleDamageFragment>();
 		const TArrayView<FMassActorFragment> ActorFragments = Context.GetMutableFragmentView<FMassActorFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
 
 		for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 		{
+			// Skip vehicles keeping inactive PID control fragments below Medium LOD. (See all ARCHETYPESTABLELOD.)
+			if (bArchetypeStableSimulationLOD && !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+			{
+				continue;
+			}
+
 			if (RepresentationFragments[EntityIt].CurrentRepresentation != EMassRepresentationType::HighResSpawnedActor)
 			{
 				continue;
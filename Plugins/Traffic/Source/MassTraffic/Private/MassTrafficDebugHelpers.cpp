@@ -5,6 +5,7 @@
 
 #include "MassEntityView.h"
 #include "MassTrafficFragments.h"
+#include "MassTrafficInterpolation.h"
 #include "MassTrafficLaneChange.h"
 
 #include "MassCommonFragments.h"
@@ -278,8 +279,17 @@ void DrawDebugChaosVehicleControl(UWorld* World, const FVector& Location, const
     #endif
 }
 
-void DrawDebugLaneSegment(UWorld* World, const FMassTrafficLaneSegment& LaneSegment, bool bVisLog, const UObject* VisLogOwner)
+void DrawDebugLaneSegment(UWorld* World, const FZoneGraphStorage& ZoneGraphStorage, const FMassTrafficCompactLaneSegment& CompactLaneSegment, bool bVisLog, const UObject* VisLogOwner)
 {
+	if (!GMassTrafficDebugInterpolation && !bVisLog)
+	{
+		return;
+	}
+
+	// (See all COMPACTLANESEGMENT.)
+	FMassTrafficLaneSegment LaneSegment;
+	ResolveLaneSegment(ZoneGraphStorage, CompactLaneSegment, LaneSegment);
+
 #if ENABLE_DRAW_DEBUG
 	if (GMassTrafficDebugInterpolation)
 	{
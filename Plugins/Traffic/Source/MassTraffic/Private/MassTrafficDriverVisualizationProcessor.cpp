@@ -17,12 +17,15 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Driver LOD Full"), STAT_Traffic_DriverLODFull, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Driver LOD Frozen"), STAT_Traffic_DriverLODFrozen, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Driver LOD Off"), STAT_Traffic_DriverLODOff, STATGROUP_Traffic);
 
 UMassTrafficDriverVisualizationProcessor::UMassTrafficDriverVisualizationProcessor()
 	: EntityQuery_Conditional(*this)
 {
 	bAutoRegisterWithProcessingPhases = true;
-	bRequiresGameThreadExecution = true; // due to RW access to FMassRepresentationSubsystemSharedFragment
+	bRequiresGameThreadExecution = true; // due to RW access to FMassRepresentationSubsystemSharedFragment, when adding gathered instances
 	ProcessingPhase = EMassProcessingPhase::PostPhysics;
 	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
 	ExecutionOrder.ExecuteInGroup = UE::MassTraffic::ProcessorGroupNames::PostPhysicsDriverVisualization;
@@ -42,6 +45,7 @@ void UMassTrafficDriverVisualizationProcessor::ConfigureQueries(const TSharedRef
 	EntityQuery_Conditional.AddRequirement<FMassTrafficVehicleDamageFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassActorFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery_Conditional.AddChunkRequirement<FMassVisualizationChunkFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddConstSharedRequirement<FMassTrafficDriversParameters>();
@@ -80,17 +84,23 @@ void UMassTrafficDriverVisualizationProcessor::Execute(FMassEntityManager& Entit
 		}
 	}
 
-	EntityQuery_Conditional.ForEachEntityChunk(Context, [&, this](FMassExecutionContext& QueryContext)
+	// Chunks are processed on worker threads, gathering ISM instances to be added to the representation subsystem
+	// afterwards on the game thread. (See all PARALLELISMGATHER.)
+	UE::MassTraffic::ForEachVisualizationEntityChunk(EntityQuery_Conditional, Context, [&, this](FMassExecutionContext& QueryContext)
 	{
-		// Get mutable ISMInfos to append instances & custom data to
-		UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
-		check(RepresentationSubsystem);
-		FMassInstancedStaticMeshInfoArrayView ISMInfo = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+		TMassTrafficInstanceGatherer<FMassTrafficInstancePlaybackData>::FChunkInstances ChunkInstances = InstanceGatherer.BeginChunk(QueryContext);
 
 		const FMassTrafficDriversParameters& Params = QueryContext.GetConstSharedFragment<FMassTrafficDriversParameters>();
 	
 		float MaxDriverVisualizationDistanceSq = GMassTrafficMaxDriverVisualizationDistance >= 0.0f ? FMath::Square(GMassTrafficMaxDriverVisualizationDistance) : FLT_MAX;
 
+		// Driver LOD tiers. Drivers beyond FrozenPoseDistance aren't drawn at all. (See all DRIVERLOD.)
+		const float FullAnimationDistanceSq = FMath::Square(Params.FullAnimationDistance);
+		MaxDriverVisualizationDistanceSq = FMath::Min(MaxDriverVisualizationDistanceSq, FMath::Square(FMath::Max(Params.FrozenPoseDistance, Params.FullAnimationDistance)));
+		int32 NumChunkFullAnimationDrivers = 0;
+		int32 NumChunkFrozenPoseDrivers = 0;
+		int32 NumChunkOffDrivers = 0;
+
 		TArrayView<FMassRepresentationFragment> RepresentationFragments = QueryContext.GetMutableFragmentView<FMassRepresentationFragment>();
 		const TConstArrayView<FMassViewerInfoFragment> ViewerInfoFragments = QueryContext.GetFragmentView<FMassViewerInfoFragment>();
 		const TConstArrayView<FMassRepresentationLODFragment> RepresentationLODFragments = QueryContext.GetFragmentView<FMassRepresentationLODFragment>();
@@ -99,6 +109,7 @@ void UMassTrafficDriverVisualizationProcessor::Execute(FMassEntityManager& Entit
 		const TConstArrayView<FMassTrafficRandomFractionFragment> RandomFractionFragments = QueryContext.GetFragmentView<FMassTrafficRandomFractionFragment>();
 		const TConstArrayView<FTransformFragment> TransformFragments = QueryContext.GetFragmentView<FTransformFragment>();
 		const TConstArrayView<FMassTrafficPIDVehicleControlFragment> PIDVehicleControlFragments = QueryContext.GetFragmentView<FMassTrafficPIDVehicleControlFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
 		TArrayView<FMassTrafficDriverVisualizationFragment> DriverVisualizationFragments = QueryContext.GetMutableFragmentView<FMassTrafficDriverVisualizationFragment>();
 		TArrayView<FMassActorFragment> ActorFragments = QueryContext.GetMutableFragmentView<FMassActorFragment>();
 
@@ -147,76 +158,97 @@ void UMassTrafficDriverVisualizationProcessor::Execute(FMassEntityManager& Entit
 							
 					const int32 AnimStateVariationIndex = static_cast<int32>(AnimStateVariation);
 					FMassTrafficInstancePlaybackData CustomData;
-					const float SteeringInput = PIDVehicleControlFragments.IsEmpty() ? 0.0f : PIDVehicleControlFragments[EntityIt].Steering;
-					if (SteeringInput >= -PlaybackSteeringThreshold && SteeringInput <= PlaybackSteeringThreshold)
+					if (ViewerInfoFragment.ClosestViewerDistanceSq <= FullAnimationDistanceSq)
 					{
-						if (VehicleControlFragment.Speed > LowSpeedThreshold)
-						{
-							DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::HighSpeedIdle;
-							DriverVisualizationFragment.AnimStateGlobalTime = -RandomFractionFragment.RandomFraction * 10.0f;
-							PopulateAnimPlaybackFromAnimState(
-								AnimData,
-								static_cast<int32>(DriverVisualizationFragment.AnimState),
-								AnimStateVariationIndex,
-								DriverVisualizationFragment.AnimStateGlobalTime,
-								CustomData);
-						}
-						else
-						{
-							const FVector DriverToPlayer = PlayerMeshLocation - DriverTransform.GetLocation();
-							const float DriverToPlayerSizeSqrd = DriverToPlayer.SizeSquared();
-							bool bIsLookIdle = false;
+						++NumChunkFullAnimationDrivers;
 
-							if (DriverToPlayerSizeSqrd < LookIdleMinDistSqrd)
+						// Note: PID control fragments may be kept, inactive, below Medium LOD. (See all ARCHETYPESTABLELOD.)
+						const float SteeringInput = PIDVehicleControlFragments.IsEmpty() || !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive() ? 0.0f : PIDVehicleControlFragments[EntityIt].Steering;
+						if (SteeringInput >= -PlaybackSteeringThreshold && SteeringInput <= PlaybackSteeringThreshold)
+						{
+							if (VehicleControlFragment.Speed > LowSpeedThreshold)
 							{
-								const FVector DriverToPlayerDir = DriverToPlayer.GetSafeNormal();
-								const FVector DriverLeftDir = DriverTransform.GetUnitAxis(EAxis::X);
-								const float LeftDirDotToPlayer = FVector::DotProduct(DriverLeftDir, DriverToPlayerDir);
-								if (FMath::Abs(LeftDirDotToPlayer) >= LookIdleMinDotToPlayer)
-								{
-									ETrafficDriverAnimState NewState =
-										LeftDirDotToPlayer >= 0.0f ?
-										ETrafficDriverAnimState::LookLeftIdle :
-										ETrafficDriverAnimState::LookRightIdle;
+								DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::HighSpeedIdle;
+								DriverVisualizationFragment.AnimStateGlobalTime = -RandomFractionFragment.RandomFraction * 10.0f;
+								PopulateAnimPlaybackFromAnimState(
+									AnimData,
+									static_cast<int32>(DriverVisualizationFragment.AnimState),
+									AnimStateVariationIndex,
+									DriverVisualizationFragment.AnimStateGlobalTime,
+									CustomData);
+							}
+							else
+							{
+								const FVector DriverToPlayer = PlayerMeshLocation - DriverTransform.GetLocation();
+								const float DriverToPlayerSizeSqrd = DriverToPlayer.SizeSquared();
+								bool bIsLookIdle = false;
 
-									if (NewState != DriverVisualizationFragment.AnimState)
+								if (DriverToPlayerSizeSqrd < LookIdleMinDistSqrd)
+								{
+									const FVector DriverToPlayerDir = DriverToPlayer.GetSafeNormal();
+									const FVector DriverLeftDir = DriverTransform.GetUnitAxis(EAxis::X);
+									const float LeftDirDotToPlayer = FVector::DotProduct(DriverLeftDir, DriverToPlayerDir);
+									if (FMath::Abs(LeftDirDotToPlayer) >= LookIdleMinDotToPlayer)
 									{
-										DriverVisualizationFragment.AnimState = NewState;
-										DriverVisualizationFragment.AnimStateGlobalTime = GlobalTime;
+										ETrafficDriverAnimState NewState =
+											LeftDirDotToPlayer >= 0.0f ?
+											ETrafficDriverAnimState::LookLeftIdle :
+											ETrafficDriverAnimState::LookRightIdle;
+
+										if (NewState != DriverVisualizationFragment.AnimState)
+										{
+											DriverVisualizationFragment.AnimState = NewState;
+											DriverVisualizationFragment.AnimStateGlobalTime = GlobalTime;
+										}
+										PopulateAnimPlaybackFromAnimState(
+											AnimData,
+											static_cast<int32>(DriverVisualizationFragment.AnimState),
+											AnimStateVariationIndex,
+											DriverVisualizationFragment.AnimStateGlobalTime,
+											CustomData);
+										bIsLookIdle = true;
 									}
+								}
+
+								if (!bIsLookIdle)
+								{
+									DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::LowSpeedIdle;
+									DriverVisualizationFragment.AnimStateGlobalTime = -RandomFractionFragment.RandomFraction * 10.0f;
 									PopulateAnimPlaybackFromAnimState(
 										AnimData,
 										static_cast<int32>(DriverVisualizationFragment.AnimState),
 										AnimStateVariationIndex,
 										DriverVisualizationFragment.AnimStateGlobalTime,
 										CustomData);
-									bIsLookIdle = true;
 								}
 							}
-
-							if (!bIsLookIdle)
-							{
-								DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::LowSpeedIdle;
-								DriverVisualizationFragment.AnimStateGlobalTime = -RandomFractionFragment.RandomFraction * 10.0f;
-								PopulateAnimPlaybackFromAnimState(
-									AnimData,
-									static_cast<int32>(DriverVisualizationFragment.AnimState),
-									AnimStateVariationIndex,
-									DriverVisualizationFragment.AnimStateGlobalTime,
-									CustomData);
-							}
+						}
+						else
+						{
+							DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::Steering;
+							PopulateAnimEvalFromAnimState(
+								AnimData,
+								static_cast<int32>(DriverVisualizationFragment.AnimState),
+								AnimStateVariationIndex,
+								SteeringInput,
+								FFloatInterval(-1.0f, 1.0f),
+								CustomData);
 						}
 					}
 					else
 					{
-						DriverVisualizationFragment.AnimState = ETrafficDriverAnimState::Steering;
-						PopulateAnimEvalFromAnimState(
-							AnimData,
-							static_cast<int32>(DriverVisualizationFragment.AnimState),
-							AnimStateVariationIndex,
-							SteeringInput,
-							FFloatInterval(-1.0f, 1.0f),
-							CustomData);
+						// Hold the centered steering frame, cached per driver type and variation, leaving the animation
+						// state as is. (See all DRIVERLOD.)
+						++NumChunkFrozenPoseDrivers;
+						const int32 FrozenPoseIndex = FMassTrafficDriversParameters::GetFrozenPoseIndex(DriverVisualizationFragment.DriverTypeIndex, AnimStateVariationIndex);
+						if (Params.DriverTypesFrozenPose.IsValidIndex(FrozenPoseIndex))
+						{
+							CustomData = Params.DriverTypesFrozenPose[FrozenPoseIndex];
+						}
+						else
+						{
+							PopulateFrozenPose(AnimData, AnimStateVariationIndex, CustomData);
+						}
 					}
 
 					// Remove the driver if vehicle is damaged
@@ -245,14 +277,25 @@ void UMassTrafficDriverVisualizationProcessor::Execute(FMassEntityManager& Entit
 					}
 					else
 					{
-						ISMInfo[DriverStaticMeshDescHandle.ToIndex()].AddBatchedTransform(QueryContext.GetEntity(EntityIt)
-							, DriverTransform, DriverPrevTransform, RepresentationLODFragment.LODSignificance);
-						ISMInfo[DriverStaticMeshDescHandle.ToIndex()].AddBatchedCustomData(CustomData, RepresentationLODFragment.LODSignificance);
+						ChunkInstances.Instances.Add({ QueryContext.GetEntity(EntityIt), DriverStaticMeshDescHandle
+							, DriverTransform, DriverPrevTransform, RepresentationLODFragment.LODSignificance, CustomData });
 					}
 				}
 			}
+			else
+			{
+				++NumChunkOffDrivers;
+			}
 		}
+
+		INC_DWORD_STAT_BY(STAT_Traffic_DriverLODFull, NumChunkFullAnimationDrivers);
+		INC_DWORD_STAT_BY(STAT_Traffic_DriverLODFrozen, NumChunkFrozenPoseDrivers);
+		INC_DWORD_STAT_BY(STAT_Traffic_DriverLODOff, NumChunkOffDrivers);
+
+		InstanceGatherer.EndChunk(MoveTemp(ChunkInstances));
 	});
+
+	InstanceGatherer.AddBatchedInstances();
 }
 
 bool UMassTrafficDriverVisualizationProcessor::PopulateAnimEvalFromAnimState(
@@ -275,6 +318,20 @@ bool UMassTrafficDriverVisualizationProcessor::PopulateAnimEvalFromAnimState(
 	return false;
 }
 
+bool UMassTrafficDriverVisualizationProcessor::PopulateFrozenPose(
+	const UAnimToTextureDataAsset* AnimData,
+	int32 VariationIndex,
+	FMassTrafficInstancePlaybackData& OutPlaybackData)
+{
+	return PopulateAnimEvalFromAnimState(
+		AnimData,
+		static_cast<int32>(ETrafficDriverAnimState::Steering),
+		VariationIndex,
+		0.0f,
+		FFloatInterval(-1.0f, 1.0f),
+		OutPlaybackData);
+}
+
 bool UMassTrafficDriverVisualizationProcessor::PopulateAnimPlaybackFromAnimState(
 	const UAnimToTextureDataAsset* AnimData,
 	int32 StateIndex,
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MassTrafficDriverVisualizationTrait.h"
+#include "MassTrafficDriverVisualizationProcessor.h"
 #include "MassTrafficFragments.h"
 #include "MassTrafficSubsystem.h"
 #include "MassExecutionContext.h"
@@ -39,6 +40,13 @@ void UMassTrafficDriverVisualizationTrait::BuildTemplate(FMassEntityTemplateBuil
 			}
 			FStaticMeshInstanceVisualizationDescHandle DriverTypeStaticMeshDescHandle = RepresentationSubsystem->FindOrAddStaticMeshDesc(StaticMeshInstanceVisualizationDesc);
 			RegisteredParams.DriverTypesStaticMeshDescHandle.Add(DriverTypeStaticMeshDescHandle);
+
+			// Cache each variation's frozen pose. (See all DRIVERLOD.)
+			for (int32 AnimStateVariationIndex = 0; AnimStateVariationIndex < static_cast<int32>(EDriverAnimStateVariation::None); ++AnimStateVariationIndex)
+			{
+				FMassTrafficInstancePlaybackData& FrozenPose = RegisteredParams.DriverTypesFrozenPose.AddDefaulted_GetRef();
+				UMassTrafficDriverVisualizationProcessor::PopulateFrozenPose(DriverType.AnimationData.Get(), AnimStateVariationIndex, FrozenPose);
+			}
 		}
 	}
 
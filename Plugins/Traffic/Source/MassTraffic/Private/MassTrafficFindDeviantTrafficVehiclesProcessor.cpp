@@ -27,6 +27,7 @@ UMassTrafficFindDeviantTrafficVehiclesProcessor::UMassTrafficFindDeviantTrafficV
 	, CorrectedTrafficVehicleEntityQuery(*this)
 {
 	bAutoRegisterWithProcessingPhases = true;
+	TimeSliceBudgetMicroseconds = 100.0f;
 	ExecutionOrder.ExecuteInGroup = UE::MassTraffic::ProcessorGroupNames::VehicleBehavior;
 	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::FrameStart);
 	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::PreVehicleBehavior);
@@ -40,6 +41,7 @@ void UMassTrafficFindDeviantTrafficVehiclesProcessor::ConfigureQueries(const TSh
 	NominalTrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficObstacleTag>(EMassFragmentPresence::None);
 	NominalTrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::All);
 	NominalTrafficVehicleEntityQuery.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::All);
+	NominalTrafficVehicleEntityQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	NominalTrafficVehicleEntityQuery.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadOnly);
 	NominalTrafficVehicleEntityQuery.AddRequirement<FMassTrafficVehicleLightsFragment>(EMassFragmentAccess::ReadWrite);
 	NominalTrafficVehicleEntityQuery.AddRequirement<FMassZoneGraphLaneLocationFragment>(EMassFragmentAccess::ReadOnly);
@@ -52,7 +54,9 @@ void UMassTrafficFindDeviantTrafficVehiclesProcessor::ConfigureQueries(const TSh
 	NominalTrafficVehicleEntityQuery.AddConstSharedRequirement<FMassTrafficVehicleVolumeParameters>();
 	NominalTrafficVehicleEntityQuery.AddSubsystemRequirement<UZoneGraphSubsystem>(EMassFragmentAccess::ReadOnly);
 
-	// Known deviant physics vehicles which we check for correction
+	// Known deviant physics vehicles which we check for correction. With archetype stable simulation LOD, this also
+	// implicitly corrects vehicles which keep inactive PID control fragments below Medium LOD, as they no longer have a
+	// high res actor to deviate. (See all ARCHETYPESTABLELOD.)
 	DeviantTrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficObstacleTag>(EMassFragmentPresence::All);
 	DeviantTrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::All);
 	DeviantTrafficVehicleEntityQuery.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::All);
@@ -100,86 +104,101 @@ static void RemoveDeviantFragments(const FMassEntityManager& EntityManager, cons
 
 void UMassTrafficFindDeviantTrafficVehiclesProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
-	// Look for deviant vehicles
-	NominalTrafficVehicleEntityQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& QueryContext)
+	// Look for deviant vehicles, spreading the checks across frames a time slice of entity buckets at a time
+	ForTimeSlicedEntityBuckets(NominalTimeSliceCursor, [&](const FMassTrafficEntityBucketRange& EntityBuckets)
 	{
-		const UZoneGraphSubsystem& ZoneGraphSubsystem = QueryContext.GetSubsystemChecked<UZoneGraphSubsystem>();
+		NominalTrafficVehicleEntityQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& QueryContext)
+		{
+			const UZoneGraphSubsystem& ZoneGraphSubsystem = QueryContext.GetSubsystemChecked<UZoneGraphSubsystem>();
 
-		const FMassTrafficVehicleVolumeParameters& ObstacleParameters = QueryContext.GetConstSharedFragment<FMassTrafficVehicleVolumeParameters>();
-		const TConstArrayView<FMassActorFragment> ActorFragments = QueryContext.GetFragmentView<FMassActorFragment>();
-		const TConstArrayView<FMassRepresentationFragment> RepresentationFragments = QueryContext.GetFragmentView<FMassRepresentationFragment>();
-		const TConstArrayView<FMassTrafficLaneOffsetFragment> LaneOffsetFragments = QueryContext.GetFragmentView<FMassTrafficLaneOffsetFragment>();
-		const TConstArrayView<FMassZoneGraphLaneLocationFragment> ZoneGraphLaneLocationFragments = QueryContext.GetFragmentView<FMassZoneGraphLaneLocationFragment>();
-		const TArrayView<FMassTrafficInterpolationFragment> VehicleMovementInterpolationFragments = QueryContext.GetMutableFragmentView<FMassTrafficInterpolationFragment>();
-		const TArrayView<FMassTrafficNextVehicleFragment> NextVehicleFragments = QueryContext.GetMutableFragmentView<FMassTrafficNextVehicleFragment>();
-		const TArrayView<FMassTrafficVehicleLaneChangeFragment> LaneChangeFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehicleLaneChangeFragment>();
-		const TArrayView<FMassTrafficVehicleLightsFragment> VehicleLightsFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehicleLightsFragment>();
+			const FMassTrafficVehicleVolumeParameters& ObstacleParameters = QueryContext.GetConstSharedFragment<FMassTrafficVehicleVolumeParameters>();
+			const TConstArrayView<FMassActorFragment> ActorFragments = QueryContext.GetFragmentView<FMassActorFragment>();
+			const TConstArrayView<FMassRepresentationFragment> RepresentationFragments = QueryContext.GetFragmentView<FMassRepresentationFragment>();
+			const TConstArrayView<FMassTrafficLaneOffsetFragment> LaneOffsetFragments = QueryContext.GetFragmentView<FMassTrafficLaneOffsetFragment>();
+			const TConstArrayView<FMassZoneGraphLaneLocationFragment> ZoneGraphLaneLocationFragments = QueryContext.GetFragmentView<FMassZoneGraphLaneLocationFragment>();
+			const TArrayView<FMassTrafficInterpolationFragment> VehicleMovementInterpolationFragments = QueryContext.GetMutableFragmentView<FMassTrafficInterpolationFragment>();
+			const TArrayView<FMassTrafficNextVehicleFragment> NextVehicleFragments = QueryContext.GetMutableFragmentView<FMassTrafficNextVehicleFragment>();
+			const TArrayView<FMassTrafficVehicleLaneChangeFragment> LaneChangeFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehicleLaneChangeFragment>();
+			const TArrayView<FMassTrafficVehicleLightsFragment> VehicleLightsFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehicleLightsFragment>();
+			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
 
-		// Loop obstacles
-		for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
-		{
-			const FMassRepresentationFragment& RepresentationFragment = RepresentationFragments[EntityIt];
-			const FMassActorFragment& ActorFragment = ActorFragments[EntityIt];
-			
-			const AActor* Actor = ActorFragment.Get();
-			if (Actor != nullptr && RepresentationFragment.CurrentRepresentation == EMassRepresentationType::HighResSpawnedActor)
+			// Loop obstacles
+			for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
-				FMassTrafficVehicleLightsFragment& VehicleLightsFragment = VehicleLightsFragments[EntityIt];
-				const FMassZoneGraphLaneLocationFragment& ZoneGraphLaneLocationFragment = ZoneGraphLaneLocationFragments[EntityIt];
-				const FMassTrafficLaneOffsetFragment& LaneOffsetFragment = LaneOffsetFragments[EntityIt];
-				FMassTrafficVehicleLaneChangeFragment& LaneChangeFragment = LaneChangeFragments[EntityIt];
-				FMassTrafficInterpolationFragment& VehicleMovementInterpolationFragment = VehicleMovementInterpolationFragments[EntityIt];
-				FMassTrafficNextVehicleFragment& NextVehicleFragment = NextVehicleFragments[EntityIt];
+				if (!EntityBuckets.Contains(QueryContext.GetEntity(EntityIt)))
+				{
+					continue;
+				}
 
-				const FZoneGraphStorage* ZoneGraphStorage = ZoneGraphSubsystem.GetZoneGraphStorage(ZoneGraphLaneLocationFragment.LaneHandle.DataHandle);
-				check(ZoneGraphStorage);
+				// Skip vehicles keeping inactive PID control fragments below Medium LOD. (See all ARCHETYPESTABLELOD.)
+				if (bArchetypeStableSimulationLOD && !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+				{
+					continue;
+				}
 
-				// Get simulated location 
-				const FVector ActorLocation = Actor->GetActorLocation();
+				const FMassRepresentationFragment& RepresentationFragment = RepresentationFragments[EntityIt];
+				const FMassActorFragment& ActorFragment = ActorFragments[EntityIt];
+			
+				const AActor* Actor = ActorFragment.Get();
+				if (Actor != nullptr && RepresentationFragment.CurrentRepresentation == EMassRepresentationType::HighResSpawnedActor)
+				{
+					FMassTrafficVehicleLightsFragment& VehicleLightsFragment = VehicleLightsFragments[EntityIt];
+					const FMassZoneGraphLaneLocationFragment& ZoneGraphLaneLocationFragment = ZoneGraphLaneLocationFragments[EntityIt];
+					const FMassTrafficLaneOffsetFragment& LaneOffsetFragment = LaneOffsetFragments[EntityIt];
+					FMassTrafficVehicleLaneChangeFragment& LaneChangeFragment = LaneChangeFragments[EntityIt];
+					FMassTrafficInterpolationFragment& VehicleMovementInterpolationFragment = VehicleMovementInterpolationFragments[EntityIt];
+					FMassTrafficNextVehicleFragment& NextVehicleFragment = NextVehicleFragments[EntityIt];
 
-				// Get pure lane location
-				FTransform LaneLocationTransform;
-				UE::MassTraffic::InterpolatePositionAndOrientationAlongLane(*ZoneGraphStorage, ZoneGraphLaneLocationFragment.LaneHandle.Index, ZoneGraphLaneLocationFragment.DistanceAlongLane, ETrafficVehicleMovementInterpolationMethod::Linear, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, LaneLocationTransform);
+					const FZoneGraphStorage* ZoneGraphStorage = ZoneGraphSubsystem.GetZoneGraphStorage(ZoneGraphLaneLocationFragment.LaneHandle.DataHandle);
+					check(ZoneGraphStorage);
+
+					// Get simulated location 
+					const FVector ActorLocation = Actor->GetActorLocation();
+
+					// Get pure lane location
+					FTransform LaneLocationTransform;
+					UE::MassTraffic::InterpolatePositionAndOrientationAlongLane(*ZoneGraphStorage, ZoneGraphLaneLocationFragment.LaneHandle.Index, ZoneGraphLaneLocationFragment.DistanceAlongLane, ETrafficVehicleMovementInterpolationMethod::Linear, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, LaneLocationTransform);
 				
-				// Apply lateral offset
-				LaneLocationTransform.AddToTranslation(LaneLocationTransform.GetRotation().GetRightVector() * LaneOffsetFragment.LateralOffset);
+					// Apply lateral offset
+					LaneLocationTransform.AddToTranslation(LaneLocationTransform.GetRotation().GetRightVector() * LaneOffsetFragment.LateralOffset);
 				
-				// Adjust lane location for lane changing
-				UE::MassTraffic::AdjustVehicleTransformDuringLaneChange(LaneChangeFragment, ZoneGraphLaneLocationFragment.DistanceAlongLane, LaneLocationTransform);
+					// Adjust lane location for lane changing
+					UE::MassTraffic::AdjustVehicleTransformDuringLaneChange(LaneChangeFragment, ZoneGraphLaneLocationFragment.DistanceAlongLane, LaneLocationTransform);
 
-				// Has the entity transform and actual simulated actor transform deviated significantly
-				const float Deviation = FVector::Distance(LaneLocationTransform.GetLocation(), ActorLocation);
-				const float VehicleDeviationTolerance = MassTrafficSettings->VehicleDeviationTolerance *
-					(LaneChangeFragment.IsLaneChangeInProgress() ? 1.25f : 1.0f); // ..give a little more tolerance for lane changes (See all LANECHANGEPHYSICS1.)
-				if (Deviation > VehicleDeviationTolerance)
-				{
-					// IMPORTANT!
-					// Make sure we reset the lane change fragment, so it -
-					//		(1) Stops changing the transform of the vehicle.
-					//		(2) Removes any of it's own next-vehicle fragments it might have put on entities.
-					LaneChangeFragment.EndLaneChangeProgression(VehicleLightsFragment, NextVehicleFragment, EntityManager);
+					// Has the entity transform and actual simulated actor transform deviated significantly
+					const float Deviation = FVector::Distance(LaneLocationTransform.GetLocation(), ActorLocation);
+					const float VehicleDeviationTolerance = MassTrafficSettings->VehicleDeviationTolerance *
+						(LaneChangeFragment.IsLaneChangeInProgress() ? 1.25f : 1.0f); // ..give a little more tolerance for lane changes (See all LANECHANGEPHYSICS1.)
+					if (Deviation > VehicleDeviationTolerance)
+					{
+						// IMPORTANT!
+						// Make sure we reset the lane change fragment, so it -
+						//		(1) Stops changing the transform of the vehicle.
+						//		(2) Removes any of it's own next-vehicle fragments it might have put on entities.
+						LaneChangeFragment.EndLaneChangeProgression(VehicleLightsFragment, NextVehicleFragment, EntityManager);
 
-					// This vehicle is deviant, add an FTagFragment_MassTrafficObstacle tag to it so it's
-					// considered for obstacle avoidance.
-					const FMassEntityHandle Entity = QueryContext.GetEntity(EntityIt);
-					QueryContext.Defer().AddTag<FMassTrafficObstacleTag>(Entity);
-					QueryContext.Defer().AddFragment<FMassLookAtTargetFragment>(Entity);
+						// This vehicle is deviant, add an FTagFragment_MassTrafficObstacle tag to it so it's
+						// considered for obstacle avoidance.
+						const FMassEntityHandle Entity = QueryContext.GetEntity(EntityIt);
+						QueryContext.Defer().AddTag<FMassTrafficObstacleTag>(Entity);
+						QueryContext.Defer().AddFragment<FMassLookAtTargetFragment>(Entity);
 
-					QueryContext.Defer().PushCommand<FMassCommandAddFragments<
-						FMassNavigationObstacleGridCellLocationFragment		// Needed to become an avoidance obstacle
-						, FMassCrowdObstacleFragment>>						// Needed to be a zone graph dynamic obstacle
-						(Entity);
+						QueryContext.Defer().PushCommand<FMassCommandAddFragments<
+							FMassNavigationObstacleGridCellLocationFragment		// Needed to become an avoidance obstacle
+							, FMassCrowdObstacleFragment>>						// Needed to be a zone graph dynamic obstacle
+							(Entity);
 
-					FMassPillCollider Pill(ObstacleParameters.HalfWidth, ObstacleParameters.HalfLength);
-					FMassAvoidanceColliderFragment ColliderFragment(Pill);
-					QueryContext.Defer().PushCommand<FMassCommandAddFragmentInstances>(Entity, ColliderFragment);
+						FMassPillCollider Pill(ObstacleParameters.HalfWidth, ObstacleParameters.HalfLength);
+						FMassAvoidanceColliderFragment ColliderFragment(Pill);
+						QueryContext.Defer().PushCommand<FMassCommandAddFragmentInstances>(Entity, ColliderFragment);
 
-					// Debug
-					UE_VLOG_LOCATION(LogOwner, TEXT("MassTraffic Deviants"), Log, ActorLocation, 10.0f, FColor::Red, TEXT("%d Deviated by %f"), QueryContext.GetEntity(EntityIt).Index, Deviation);
-					UE_VLOG_SEGMENT_THICK(LogOwner, TEXT("MassTraffic Deviants"), Log, ActorLocation, LaneLocationTransform.GetLocation(), FColor::Red, 3.0f, TEXT(""));
+						// Debug
+						UE_VLOG_LOCATION(LogOwner, TEXT("MassTraffic Deviants"), Log, ActorLocation, 10.0f, FColor::Red, TEXT("%d Deviated by %f"), QueryContext.GetEntity(EntityIt).Index, Deviation);
+						UE_VLOG_SEGMENT_THICK(LogOwner, TEXT("MassTraffic Deviants"), Log, ActorLocation, LaneLocationTransform.GetLocation(), FColor::Red, 3.0f, TEXT(""));
+					}
 				}
 			}
-		}
+		});
 	});
 
 	// Check known deviant vehicles to see if they're still deviant
@@ -5,6 +5,7 @@
 #include "MassEntityView.h"
 #include "MassExecutionContext.h"
 #include "MassZoneGraphNavigationFragments.h"
+#include "Misc/MemStack.h"
 
 
 UMassTrafficFindNextVehicleProcessor::UMassTrafficFindNextVehicleProcessor()
@@ -15,6 +16,7 @@ UMassTrafficFindNextVehicleProcessor::UMassTrafficFindNextVehicleProcessor()
 
 void UMassTrafficFindNextVehicleProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
+	EntityQuery.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	EntityQuery.AddRequirement<FMassZoneGraphLaneLocationFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddRequirement<FMassTrafficNextVehicleFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadWrite);
@@ -26,8 +28,12 @@ void UMassTrafficFindNextVehicleProcessor::Execute(FMassEntityManager& EntityMan
 {
 	UMassTrafficSubsystem& MassTrafficSubsystem = Context.GetMutableSubsystemChecked<UMassTrafficSubsystem>();
 
-	// Gather all fragments
-	TArray<FMassEntityHandle> AllVehicles;
+	// Gather all fragments, into scratch memory from the thread's linear memory stack
+	// (See all SCRATCHMEMORY.)
+	LLM_SCOPE_BYTAG(MassTraffic_Scratch);
+	FMemMark MemMark(FMemStack::Get());
+	TArray<FMassEntityHandle, TMemStackAllocator<>> AllVehicles;
+	AllVehicles.Reserve(EntityQuery.GetNumMatchingEntities());
 	EntityQuery.ForEachEntityChunk(Context, [&](const FMassExecutionContext& QueryContext)
 	{
 		for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
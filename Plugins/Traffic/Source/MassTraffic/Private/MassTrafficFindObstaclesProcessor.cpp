@@ -14,8 +14,11 @@
 #include "MassTrafficVehicleSimulationTrait.h"
 #include "MassTrafficVehicleVolumeTrait.h"
 #include "ZoneGraphSubsystem.h"
+#include "Misc/MemStack.h"
 #include "VisualLogger/VisualLogger.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Obstacle List Scratch Vehicles"), STAT_Traffic_ObstacleListScratchVehicles, STATGROUP_Traffic);
+
 struct FMassTrafficVehicleVolumeParameters;
 
 void FindNearbyLanes(const FZoneGraphStorage& Storage, const FBox& Bounds, const FZoneGraphTagFilter TagFilter, TArray<int32>& OutLanes)
@@ -82,7 +85,14 @@ void UMassTrafficFindObstaclesProcessor::Execute(FMassEntityManager& EntityManag
 		// Re-bind obstacles to vehicles on nearby lanes
 		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FindVehiclesForObstacles"))
 
-		TMap<FMassEntityHandle, TArray<FMassEntityHandle>> ObstacleListsToAdd;
+		// Per vehicle obstacle arrays are allocated from the thread's linear memory stack, released at the end of scope.
+		// The map itself stays on the heap, tagged so what remains per frame shows up in LLM. (See all SCRATCHMEMORY.)
+		LLM_SCOPE_BYTAG(MassTraffic_Scratch);
+		FMemMark MemMark(FMemStack::Get());
+		TMap<FMassEntityHandle, TArray<FMassEntityHandle, TMemStackAllocator<>>> ObstacleListsToAdd;
+
+		// Reused for every obstacle
+		TArray<FZoneGraphLaneHandle> NearbyLanes;
 		
 		ObstacleEntityQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& QueryContext)
 		{
@@ -122,7 +132,7 @@ void UMassTrafficFindObstaclesProcessor::Execute(FMassEntityManager& EntityManag
 				#endif
 
 				// Find nearby lanes for this obstacle
-				TArray<FZoneGraphLaneHandle> NearbyLanes;
+				NearbyLanes.Reset();
 				FBox SearchBox = FBox::BuildAABB(TransformFragment.GetTransform().GetLocation(), FVector(FVector2D(MassTrafficSettings->ObstacleSearchRadius), MassTrafficSettings->ObstacleSearchHeight));
 				ZoneGraphSubsystem.FindOverlappingLanes(SearchBox, GetDefault<UMassTrafficSettings>()->TrafficLaneFilter, NearbyLanes);
 
@@ -204,11 +214,13 @@ void UMassTrafficFindObstaclesProcessor::Execute(FMassEntityManager& EntityManag
 			}
 		});
 
+		INC_DWORD_STAT_BY(STAT_Traffic_ObstacleListScratchVehicles, ObstacleListsToAdd.Num());
+
 		// Add obstacle list fragments
 		for (const auto& VehicleToObstacles : ObstacleListsToAdd)
 		{
 			FMassTrafficObstacleListFragment NewObstacleListFragment;
-			NewObstacleListFragment.Obstacles = VehicleToObstacles.Value;
+			NewObstacleListFragment.Obstacles.Append(VehicleToObstacles.Value);
 			Context.Defer().PushCommand<FMassCommandAddFragmentInstances>(VehicleToObstacles.Key, NewObstacleListFragment);
 		}
 	}
@@ -399,6 +399,33 @@ void FMassTrafficIntersectionFragment::Finalize(const FMassTrafficLaneToTrafficL
 }
 
 
+//
+// FMassTrafficAnalyticMotionFragment
+//
+
+
+float FMassTrafficAnalyticMotionFragment::GetTimeAtDistance(const float DistanceAlongLane) const
+{
+	const float DistanceToTravel = DistanceAlongLane - StartDistance;
+	if (DistanceToTravel <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const float AccelerationTime = GetAccelerationTime();
+	const float AccelerationDistance = StartSpeed * AccelerationTime + 0.5f * Acceleration * FMath::Square(AccelerationTime);
+	if (DistanceToTravel <= AccelerationDistance)
+	{
+		// Solve StartSpeed * T + 0.5 * Acceleration * T^2 = DistanceToTravel for the first T >= 0. Speed never drops
+		// below TargetSpeed while changing speed, so the discriminant is only negative through rounding.
+		const float Discriminant = FMath::Square(StartSpeed) + 2.0f * Acceleration * DistanceToTravel;
+		return (FMath::Sqrt(FMath::Max(Discriminant, 0.0f)) - StartSpeed) / Acceleration;
+	}
+
+	return TargetSpeed > 0.0f ? AccelerationTime + (DistanceToTravel - AccelerationDistance) / TargetSpeed : TNumericLimits<float>::Max();
+}
+
+
 //
 // FDataFragment_TrafficVehicleLaneChange
 //
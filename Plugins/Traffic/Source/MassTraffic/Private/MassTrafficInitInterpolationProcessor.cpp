@@ -3,6 +3,7 @@
 #include "MassTrafficInitInterpolationProcessor.h"
 #include "MassTraffic.h"
 #include "MassTrafficChooseNextLaneProcessor.h"
+#include "MassTrafficDebugHelpers.h"
 #include "MassTrafficFragments.h"
 #include "MassTrafficInterpolation.h"
 #include "MassExecutionContext.h"
@@ -50,13 +51,7 @@ void UMassTrafficInitInterpolationProcessor::Execute(FMassEntityManager& EntityM
 			UE::MassTraffic::InterpolatePositionAndOrientationAlongLane(*ZoneGraphStorage, LaneLocationFragment.LaneHandle.Index, LaneLocationFragment.DistanceAlongLane, ETrafficVehicleMovementInterpolationMethod::Linear, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, TransformFragment.GetMutableTransform());
 
 			// Debug
-			if (GMassTrafficDebugInterpolation)
-			{
-				DrawDebugPoint(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment.StartPoint, 20.0f, FColor::Red);
-				DrawDebugPoint(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment.StartControlPoint, 20.0f, FColor::Green);
-				DrawDebugPoint(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment.EndControlPoint, 20.0f, FColor::Blue);
-				DrawDebugPoint(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment.EndPoint, 20.0f, FColor::Cyan);
-			}
+			UE::MassTraffic::DrawDebugLaneSegment(World, *ZoneGraphStorage, VehicleMovementInterpolationFragment.LaneLocationLaneSegment);
 		}
 	});
 }
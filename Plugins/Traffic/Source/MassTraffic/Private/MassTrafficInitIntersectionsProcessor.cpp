@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MassTrafficInitIntersectionsProcessor.h"
+#include "MassTraffic.h"
 #include "MassCommonFragments.h"
 #include "MassTrafficFragments.h"
 #include "MassTrafficDelegates.h"
@@ -27,6 +28,8 @@ void UMassTrafficInitIntersectionsProcessor::ConfigureQueries(const TSharedRef<F
 
 void UMassTrafficInitIntersectionsProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
+	LLM_SCOPE_BYTAG(MassTraffic_Intersections);
+
 	// Cast AuxData to required FMassTrafficIntersectionsSpawnData
 	FInstancedStruct& AuxInput = Context.GetMutableAuxData();
 	if (!ensure(AuxInput.GetPtr<FMassTrafficIntersectionsSpawnData>()))
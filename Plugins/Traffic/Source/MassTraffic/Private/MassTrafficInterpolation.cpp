@@ -14,7 +14,7 @@ namespace MassTraffic
 {
 
 FORCEINLINE bool IsValidLaneSegmentForDistanceAlongLane(
-	const FMassTrafficPositionOnlyLaneSegment& LaneSegment,
+	const FMassTrafficCompactLaneSegment& LaneSegment,
 	const FZoneGraphStorage& ZoneGraphStorage,
 	const int32 LaneIndex,
 	const float DistanceAlongLane
@@ -23,11 +23,11 @@ FORCEINLINE bool IsValidLaneSegmentForDistanceAlongLane(
 	return LaneIndex == LaneSegment.LaneHandle.Index && ZoneGraphStorage.DataHandle == LaneSegment.LaneHandle.DataHandle && FMath::IsWithinInclusive(DistanceAlongLane, LaneSegment.StartProgression, LaneSegment.EndProgression);
 }
 	
-void InitPositionOnlyLaneSegment(
+void InitCompactLaneSegment(
 	const FZoneGraphStorage& ZoneGraphStorage,
 	int32 LaneIndex,
 	float DistanceAlongLane,
-	FMassTrafficPositionOnlyLaneSegment& InOutLaneSegment
+	FMassTrafficCompactLaneSegment& InOutLaneSegment
 )
 {
 	const FZoneLaneData& LaneData = ZoneGraphStorage.Lanes[LaneIndex];
@@ -59,9 +59,19 @@ void InitPositionOnlyLaneSegment(
 	InOutLaneSegment.StartPointIndex = LaneSegmentStartPointIndex;
 	
 	InOutLaneSegment.StartProgression = ZoneGraphStorage.LanePointProgressions[LaneSegmentStartPointIndex];
-	InOutLaneSegment.StartPoint = ZoneGraphStorage.LanePoints[LaneSegmentStartPointIndex]; 
-	
 	InOutLaneSegment.EndProgression = ZoneGraphStorage.LanePointProgressions[LaneSegmentEndPointIndex];
+}
+
+// Fills in the segment points for the lane segment's (already initialized) point indices
+FORCEINLINE void ResolvePositionOnlyLaneSegmentPoints(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	FMassTrafficPositionOnlyLaneSegment& InOutLaneSegment
+)
+{
+	const int32 LaneSegmentStartPointIndex = InOutLaneSegment.StartPointIndex;
+	const int32 LaneSegmentEndPointIndex = LaneSegmentStartPointIndex + 1;
+	
+	InOutLaneSegment.StartPoint = ZoneGraphStorage.LanePoints[LaneSegmentStartPointIndex]; 
 	InOutLaneSegment.EndPoint = ZoneGraphStorage.LanePoints[LaneSegmentEndPointIndex];
 
 	const float TangentDistance = FVector::Distance(InOutLaneSegment.StartPoint, InOutLaneSegment.EndPoint) / 3.0f;
@@ -69,6 +79,39 @@ void InitPositionOnlyLaneSegment(
 	InOutLaneSegment.EndControlPoint = InOutLaneSegment.EndPoint - ZoneGraphStorage.LaneTangentVectors[LaneSegmentEndPointIndex] * TangentDistance; 
 }
 
+// Fills in the segment points & up vectors for the lane segment's (already initialized) point indices
+FORCEINLINE void ResolveLaneSegmentPoints(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	FMassTrafficLaneSegment& InOutLaneSegment
+)
+{
+	ResolvePositionOnlyLaneSegmentPoints(ZoneGraphStorage, InOutLaneSegment);
+
+	InOutLaneSegment.LaneSegmentStartUp = ZoneGraphStorage.LaneUpVectors[InOutLaneSegment.StartPointIndex];
+	InOutLaneSegment.LaneSegmentEndUp = ZoneGraphStorage.LaneUpVectors[InOutLaneSegment.StartPointIndex + 1];
+}
+
+void ResolveLaneSegment(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	const FMassTrafficCompactLaneSegment& CompactLaneSegment,
+	FMassTrafficLaneSegment& OutLaneSegment
+)
+{
+	static_cast<FMassTrafficCompactLaneSegment&>(OutLaneSegment) = CompactLaneSegment;
+	ResolveLaneSegmentPoints(ZoneGraphStorage, OutLaneSegment);
+}
+
+void InitPositionOnlyLaneSegment(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	int32 LaneIndex,
+	float DistanceAlongLane,
+	FMassTrafficPositionOnlyLaneSegment& InOutLaneSegment
+)
+{
+	InitCompactLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
+	ResolvePositionOnlyLaneSegmentPoints(ZoneGraphStorage, InOutLaneSegment);
+}
+
 void InitLaneSegment(
     const FZoneGraphStorage& ZoneGraphStorage,
     int32 LaneIndex,
@@ -76,10 +119,8 @@ void InitLaneSegment(
     FMassTrafficLaneSegment& InOutLaneSegment
 )
 {
-	InitPositionOnlyLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
-
-	InOutLaneSegment.LaneSegmentStartUp = ZoneGraphStorage.LaneUpVectors[InOutLaneSegment.StartPointIndex];
-	InOutLaneSegment.LaneSegmentEndUp = ZoneGraphStorage.LaneUpVectors[InOutLaneSegment.StartPointIndex + 1];
+	InitCompactLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
+	ResolveLaneSegmentPoints(ZoneGraphStorage, InOutLaneSegment);
 }
 	
 void InterpolatePositionAlongLane(
@@ -121,23 +162,16 @@ void InterpolatePositionAlongLane(
 	check(!OutPosition.ContainsNaN());
 }
 
-void InterpolatePositionAndOrientationAlongLane(
-    const FZoneGraphStorage& ZoneGraphStorage, 
-    int32 LaneIndex,
-    float DistanceAlongLane,
-    ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
-    FMassTrafficLaneSegment& InOutLaneSegment,
-    FVector& OutPosition,
-    FQuat& OutOrientation)
+// Evaluates the lane location & orientation at DistanceAlongLane, which must be within LaneSegment
+FORCEINLINE void EvaluateLaneSegment(
+	const FMassTrafficLaneSegment& LaneSegment,
+	float DistanceAlongLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FVector& OutPosition,
+	FQuat& OutOrientation)
 {
-	// Out of current segment range?
-	if (!IsValidLaneSegmentForDistanceAlongLane(InOutLaneSegment, ZoneGraphStorage, LaneIndex, DistanceAlongLane))
-	{
-		InitLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
-	}
-	
 	// Segment alpha 
-	const float Alpha = FMath::GetRangePct(InOutLaneSegment.StartProgression, InOutLaneSegment.EndProgression, DistanceAlongLane);
+	const float Alpha = FMath::GetRangePct(LaneSegment.StartProgression, LaneSegment.EndProgression, DistanceAlongLane);
 		
 	// Interpolate along segment 
 	FVector InterpolatedLocation(ForceInitToZero);
@@ -147,22 +181,22 @@ void InterpolatePositionAndOrientationAlongLane(
 		// Cheap Lerp from P1 to P2 for position and Slerp for orientation
 		case ETrafficVehicleMovementInterpolationMethod::Linear:
 
-			InterpolatedLocation = FMath::Lerp(InOutLaneSegment.StartPoint, InOutLaneSegment.EndPoint, Alpha);			
-			InterpolatedForwardVector = InOutLaneSegment.EndPoint - InOutLaneSegment.StartPoint; // Doesn't need to be unit length for FRotationMatrix::MakeFromXZ below
+			InterpolatedLocation = FMath::Lerp(LaneSegment.StartPoint, LaneSegment.EndPoint, Alpha);			
+			InterpolatedForwardVector = LaneSegment.EndPoint - LaneSegment.StartPoint; // Doesn't need to be unit length for FRotationMatrix::MakeFromXZ below
 			
 			break;
 		
 		// Cubic Centripetal Catmull-Rom interpolation from P1 to P2 for position and Slerp for orientation
 		case ETrafficVehicleMovementInterpolationMethod::CubicBezier:
 
-			InterpolatedLocation = UE::CubicBezier::Eval(InOutLaneSegment.StartPoint, InOutLaneSegment.StartControlPoint, InOutLaneSegment.EndControlPoint, InOutLaneSegment.EndPoint, Alpha);
-			InterpolatedForwardVector = UE::CubicBezier::EvalDerivate(InOutLaneSegment.StartPoint, InOutLaneSegment.StartControlPoint, InOutLaneSegment.EndControlPoint, InOutLaneSegment.EndPoint, Alpha);
+			InterpolatedLocation = UE::CubicBezier::Eval(LaneSegment.StartPoint, LaneSegment.StartControlPoint, LaneSegment.EndControlPoint, LaneSegment.EndPoint, Alpha);
+			InterpolatedForwardVector = UE::CubicBezier::EvalDerivate(LaneSegment.StartPoint, LaneSegment.StartControlPoint, LaneSegment.EndControlPoint, LaneSegment.EndPoint, Alpha);
 			
 			break;
 	}
 
 	// Lerp UpVector along segment and combine with forward spline tangent direction to form the final orientation  
-	const FVector InterpolatedUpVector = FMath::Lerp(InOutLaneSegment.LaneSegmentStartUp, InOutLaneSegment.LaneSegmentEndUp, Alpha); 
+	const FVector InterpolatedUpVector = FMath::Lerp(LaneSegment.LaneSegmentStartUp, LaneSegment.LaneSegmentEndUp, Alpha); 
 	const FQuat InterpolatedOrientation = FRotationMatrix::MakeFromXZ(InterpolatedForwardVector, InterpolatedUpVector).ToQuat();
 
 	OutPosition = InterpolatedLocation;
@@ -173,6 +207,46 @@ void InterpolatePositionAndOrientationAlongLane(
 	check(!OutOrientation.ContainsNaN());
 }
 
+void InterpolatePositionAndOrientationAlongLane(
+    const FZoneGraphStorage& ZoneGraphStorage, 
+    int32 LaneIndex,
+    float DistanceAlongLane,
+    ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+    FMassTrafficLaneSegment& InOutLaneSegment,
+    FVector& OutPosition,
+    FQuat& OutOrientation)
+{
+	// Out of current segment range?
+	if (!IsValidLaneSegmentForDistanceAlongLane(InOutLaneSegment, ZoneGraphStorage, LaneIndex, DistanceAlongLane))
+	{
+		InitLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
+	}
+
+	EvaluateLaneSegment(InOutLaneSegment, DistanceAlongLane, InterpolationMethod, OutPosition, OutOrientation);
+}
+
+void InterpolatePositionAndOrientationAlongLane(
+    const FZoneGraphStorage& ZoneGraphStorage, 
+    int32 LaneIndex,
+    float DistanceAlongLane,
+    ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+    FMassTrafficCompactLaneSegment& InOutLaneSegment,
+    FVector& OutPosition,
+    FQuat& OutOrientation)
+{
+	// Out of current segment range?
+	if (!IsValidLaneSegmentForDistanceAlongLane(InOutLaneSegment, ZoneGraphStorage, LaneIndex, DistanceAlongLane))
+	{
+		InitCompactLaneSegment(ZoneGraphStorage, LaneIndex, DistanceAlongLane, InOutLaneSegment);
+	}
+
+	// Reconstruct the full segment from lane data (See all COMPACTLANESEGMENT.)
+	FMassTrafficLaneSegment LaneSegment;
+	ResolveLaneSegment(ZoneGraphStorage, InOutLaneSegment, LaneSegment);
+	
+	EvaluateLaneSegment(LaneSegment, DistanceAlongLane, InterpolationMethod, OutPosition, OutOrientation);
+}
+
 void InterpolatePositionAlongContinuousLanes(
 	const FZoneGraphStorage& ZoneGraphStorage,
 	int32 CurrentLaneIndex,
@@ -216,7 +290,10 @@ void InterpolatePositionAndOrientationAlongContinuousLanes(
 	}
 }
 
-void InterpolatePositionAndOrientationAlongContinuousLanes(
+// Shared by the full and compact lane segment overloads below, which pick the matching
+// InterpolatePositionAndOrientationAlongLane overload. (See all COMPACTLANESEGMENT.)
+template<typename TLaneSegment>
+FORCEINLINE void InterpolatePositionAndOrientationAlongContinuousLanesImpl(
 	const FZoneGraphStorage& ZoneGraphStorage,
 	int32 PreviousLaneIndex,
 	float PreviousLaneLength,
@@ -225,7 +302,7 @@ void InterpolatePositionAndOrientationAlongContinuousLanes(
 	int32 NextLaneIndex,
 	float DistanceAlongCurrentLane,
 	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
-	FMassTrafficLaneSegment& InOutLaneSegment,
+	TLaneSegment& InOutLaneSegment,
 	FVector& OutPosition,
 	FQuat& OutOrientation)
 {
@@ -242,6 +319,38 @@ void InterpolatePositionAndOrientationAlongContinuousLanes(
 		InterpolatePositionAndOrientationAlongLane(ZoneGraphStorage, CurrentLaneIndex, DistanceAlongCurrentLane, InterpolationMethod, InOutLaneSegment, OutPosition, OutOrientation);
 	}
 }
+
+void InterpolatePositionAndOrientationAlongContinuousLanes(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	int32 PreviousLaneIndex,
+	float PreviousLaneLength,
+	int32 CurrentLaneIndex,
+	float CurrentLaneLength,
+	int32 NextLaneIndex,
+	float DistanceAlongCurrentLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficLaneSegment& InOutLaneSegment,
+	FVector& OutPosition,
+	FQuat& OutOrientation)
+{
+	InterpolatePositionAndOrientationAlongContinuousLanesImpl(ZoneGraphStorage, PreviousLaneIndex, PreviousLaneLength, CurrentLaneIndex, CurrentLaneLength, NextLaneIndex, DistanceAlongCurrentLane, InterpolationMethod, InOutLaneSegment, OutPosition, OutOrientation);
+}
+
+void InterpolatePositionAndOrientationAlongContinuousLanes(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	int32 PreviousLaneIndex,
+	float PreviousLaneLength,
+	int32 CurrentLaneIndex,
+	float CurrentLaneLength,
+	int32 NextLaneIndex,
+	float DistanceAlongCurrentLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficCompactLaneSegment& InOutLaneSegment,
+	FVector& OutPosition,
+	FQuat& OutOrientation)
+{
+	InterpolatePositionAndOrientationAlongContinuousLanesImpl(ZoneGraphStorage, PreviousLaneIndex, PreviousLaneLength, CurrentLaneIndex, CurrentLaneLength, NextLaneIndex, DistanceAlongCurrentLane, InterpolationMethod, InOutLaneSegment, OutPosition, OutOrientation);
+}
 	
 }
 }
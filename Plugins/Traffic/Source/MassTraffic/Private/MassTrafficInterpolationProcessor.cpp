@@ -31,7 +31,10 @@ void UMassTrafficInterpolationProcessor::ConfigureQueries(const TSharedRef<FMass
 {
 	// the following are the common requirements for both both queries
 	EntityQueryNonOffLOD_Conditional.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
-	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::None);
+	// With archetype stable simulation LOD, vehicles keep PID control fragments below Medium LOD so are instead filtered
+	// per entity. (See all ARCHETYPESTABLELOD.)
+	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly, GetDefault<UMassTrafficSettings>()->bArchetypeStableSimulationLOD ? EMassFragmentPresence::Optional : EMassFragmentPresence::None);
+	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassZoneGraphLaneLocationFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassTrafficLaneOffsetFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQueryNonOffLOD_Conditional.AddRequirement<FMassTrafficVehicleControlFragment>(EMassFragmentAccess::ReadOnly);
@@ -71,9 +74,18 @@ void UMassTrafficInterpolationProcessor::Execute(FMassEntityManager& EntityManag
 		const TConstArrayView<FMassTrafficDebugFragment> DebugFragments = QueryContext.GetFragmentView<FMassTrafficDebugFragment>();
 		const TArrayView<FMassTrafficInterpolationFragment> VehicleMovementInterpolationFragments = QueryContext.GetMutableFragmentView<FMassTrafficInterpolationFragment>();
 		const TArrayView<FTransformFragment> TransformFragments = QueryContext.GetMutableFragmentView<FTransformFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
+		const bool bHasPIDVehicleControl = !QueryContext.GetFragmentView<FMassTrafficPIDVehicleControlFragment>().IsEmpty();
 
 		for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
 		{
+			// Skip vehicles with active PID control, kept in this archetype by archetype stable simulation LOD.
+			// (See all ARCHETYPESTABLELOD.)
+			if (bHasPIDVehicleControl && SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+			{
+				continue;
+			}
+
 			const FMassTrafficVehicleControlFragment& VehicleControlFragment = VehicleControlFragments[EntityIt];
 			const FMassZoneGraphLaneLocationFragment& ZoneGraphLaneLocationFragment = LaneLocationFragments[EntityIt];
 			const FMassTrafficLaneOffsetFragment& LaneOffsetFragment = LaneOffsetFragments[EntityIt];
@@ -137,7 +149,7 @@ void UMassTrafficInterpolationProcessor::Execute(FMassEntityManager& EntityManag
 			UE::MassTraffic::AdjustVehicleTransformDuringLaneChange(LaneChangeFragment, ZoneGraphLaneLocationFragment.DistanceAlongLane, TransformFragment.GetMutableTransform(), World, bVisLog, LogOwner);
 
 			// Debug
-			UE::MassTraffic::DrawDebugLaneSegment(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, bVisLog, LogOwner);
+			UE::MassTraffic::DrawDebugLaneSegment(World, *ZoneGraphStorage, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, bVisLog, LogOwner);
 		}
 	});
 
@@ -176,7 +188,7 @@ void UMassTrafficInterpolationProcessor::Execute(FMassEntityManager& EntityManag
 				, TransformFragment.GetMutableTransform(), World, bVisLog, LogOwner);
 
 			// Debug
-			UE::MassTraffic::DrawDebugLaneSegment(World, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, bVisLog, LogOwner);
+			UE::MassTraffic::DrawDebugLaneSegment(World, *ZoneGraphStorage, VehicleMovementInterpolationFragment.LaneLocationLaneSegment, bVisLog, LogOwner);
 		}
 	});
 }
\ No newline at end of file
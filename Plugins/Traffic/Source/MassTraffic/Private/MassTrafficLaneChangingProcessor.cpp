@@ -602,6 +602,7 @@ UMassTrafficLaneChangingProcessor::UMassTrafficLaneChangingProcessor()
 void UMassTrafficLaneChangingProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) 
 {
 	StartNewLaneChangesEntityQuery_Conditional.AddTagRequirement<FMassTrafficParkedVehicleTag>(EMassFragmentPresence::None);
+	StartNewLaneChangesEntityQuery_Conditional.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	StartNewLaneChangesEntityQuery_Conditional.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
 	StartNewLaneChangesEntityQuery_Conditional.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	StartNewLaneChangesEntityQuery_Conditional.AddRequirement<FMassTrafficNextVehicleFragment>(EMassFragmentAccess::ReadWrite);
@@ -622,6 +623,7 @@ void UMassTrafficLaneChangingProcessor::ConfigureQueries(const TSharedRef<FMassE
 	StartNewLaneChangesEntityQuery_Conditional.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadWrite);
 
 	UpdateLaneChangesEntityQuery_Conditional.AddTagRequirement<FMassTrafficParkedVehicleTag>(EMassFragmentPresence::None);
+	UpdateLaneChangesEntityQuery_Conditional.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	UpdateLaneChangesEntityQuery_Conditional.AddRequirement<FMassTrafficVehicleLightsFragment>(EMassFragmentAccess::ReadWrite);
 	UpdateLaneChangesEntityQuery_Conditional.AddRequirement<FMassZoneGraphLaneLocationFragment>(EMassFragmentAccess::ReadOnly);
 	UpdateLaneChangesEntityQuery_Conditional.AddRequirement<FMassSimulationVariableTickFragment>(EMassFragmentAccess::ReadOnly);
@@ -123,7 +123,10 @@ void UMassTrafficLightUpdateCustomVisualizationProcessor::Execute(FMassEntityMan
 
 				AActor* Actor = ActorInfo.GetMutable();
 
-				// We only support StaticMeshInstances for traffic lights.
+				// We only support StaticMeshInstances for traffic lights. Every visible light has to be re-added with
+				// its custom data every frame, even if its state hasn't changed: batched instances are only kept for
+				// the frame they're added in, and their custom data must line up with them. Only updating intersections
+				// whose lights changed would need engine side support for persistent instances.
 				if(VisualizationFragment.CurrentRepresentation == EMassRepresentationType::StaticMeshInstance)
 				{
 					// Visualize lights
@@ -0,0 +1,437 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassTrafficMesoscopicProcessor.h"
+#include "MassTraffic.h"
+#include "MassTrafficInterpolation.h"
+#include "MassTrafficLaneChange.h"
+#include "MassTrafficMovement.h"
+#include "MassTrafficOverseerProcessor.h"
+#include "MassTrafficSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassEntityView.h"
+#include "MassExecutionContext.h"
+#include "MassLODSubsystem.h"
+#include "MassRepresentationFragments.h"
+#include "MassZoneGraphNavigationFragments.h"
+#include "ZoneGraphSubsystem.h"
+
+// Stats
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mesoscopic Lanes"), STAT_Traffic_MesoscopicLanes, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mesoscopic Vehicles"), STAT_Traffic_MesoscopicVehicles, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mesoscopic Vehicles Absorbed"), STAT_Traffic_MesoscopicVehiclesAbsorbed, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mesoscopic Vehicles Emitted"), STAT_Traffic_MesoscopicVehiclesEmitted, STATGROUP_Traffic);
+
+UMassTrafficMesoscopicProcessor::UMassTrafficMesoscopicProcessor()
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = UE::MassTraffic::ProcessorGroupNames::FrameStart;
+	ExecutionOrder.ExecuteAfter.Add(UMassTrafficOverseerProcessor::StaticClass()->GetFName());
+}
+
+void UMassTrafficMesoscopicProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	ProcessorRequirements.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadWrite);
+	ProcessorRequirements.AddSubsystemRequirement<UMassLODSubsystem>(EMassFragmentAccess::ReadOnly);
+	ProcessorRequirements.AddSubsystemRequirement<UZoneGraphSubsystem>(EMassFragmentAccess::ReadOnly);
+}
+
+void UMassTrafficMesoscopicProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("TrafficMesoscopic"))
+
+	UMassTrafficSubsystem& MassTrafficSubsystem = Context.GetMutableSubsystemChecked<UMassTrafficSubsystem>();
+	const UMassLODSubsystem& LODSubsystem = Context.GetSubsystemChecked<UMassLODSubsystem>();
+	const TArray<FViewerInfo>& Viewers = LODSubsystem.GetViewers();
+
+	// When disabled, all lanes return to individual vehicle simulation, re-emitting their aggregated vehicles
+	const bool bMesoscopicTraffic = MassTrafficSettings->bMesoscopicTraffic && GMassTrafficMesoscopic > 0;
+
+	const float EnterMesoscopicDistance = MassTrafficSettings->MesoscopicLaneDistance;
+	const float ExitMesoscopicDistance = FMath::Max(MassTrafficSettings->MesoscopicLaneDistance - MassTrafficSettings->MesoscopicLaneDistanceHysteresis, 0.0f);
+	int32 NumTransitionsRemaining = MassTrafficSettings->MaxMesoscopicTransitionsPerFrame;
+	int32 NumVehiclesAbsorbed = 0;
+
+	// Each lane is stepped once per pass, so steps cover the time since the lane's previous step: roughly one pass.
+	// The current pass's time is used until it overtakes the last, so long passes don't hold vehicles back.
+	LanePassTime += Context.GetDeltaTimeSeconds();
+	const float StepDeltaTime = FMath::Max(LanePassTime, LastLanePassTime);
+
+	EmissionLanes.Reset();
+
+	const TArrayView<FMassTrafficZoneGraphData*> TrafficZoneGraphDatas = MassTrafficSubsystem.GetMutableTrafficZoneGraphData();
+	int32 NumLanes = 0;
+	for (const FMassTrafficZoneGraphData* TrafficZoneGraphData : TrafficZoneGraphDatas)
+	{
+		NumLanes += TrafficZoneGraphData->TrafficLaneDataArray.Num();
+	}
+	const int32 MaxLanesPerSlice = FMath::DivideAndRoundUp(NumLanes, FMath::Max(MassTrafficSettings->NumMesoscopicLanePartitions, 1));
+
+	// For this frame's time slice of lanes, update which are mesoscopic, absorbing Off LOD vehicles on mesoscopic
+	// lanes, and step the cell transmission model. Vehicles aggregated on non-mesoscopic lanes they can't be emitted
+	// onto keep flowing too, until they reach a lane they can be. Non-mesoscopic lanes with vehicles to emit are
+	// collected for emission below.
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("UpdateMesoscopicLanes"))
+
+		FMassTrafficTimeSlice LaneTimeSlice = MakeTimeSlice(LaneTimeSliceCursor, NumLanes, MaxLanesPerSlice);
+
+		int32 FirstLaneIndex = 0;
+		for (FMassTrafficZoneGraphData* TrafficZoneGraphData : TrafficZoneGraphDatas)
+		{
+			TArray<FZoneGraphTrafficLaneData>& TrafficLaneDataArray = TrafficZoneGraphData->TrafficLaneDataArray;
+			const int32 ZoneGraphFirstLaneIndex = FirstLaneIndex;
+			FirstLaneIndex += TrafficLaneDataArray.Num();
+			if (LaneTimeSlice.IsBudgetSpent())
+			{
+				break;
+			}
+
+			for (int32 LaneIndex = FMath::Max(LaneTimeSlice.GetResumeItemIndex() - ZoneGraphFirstLaneIndex, 0); LaneIndex < TrafficLaneDataArray.Num() && LaneTimeSlice.ShouldProcessItem(ZoneGraphFirstLaneIndex + LaneIndex); ++LaneIndex)
+			{
+				FZoneGraphTrafficLaneData& TrafficLaneData = TrafficLaneDataArray[LaneIndex];
+
+				// Without any viewers (e.g: before they register) we keep lanes as they are, rather than absorbing
+				// everything.
+				if (!bMesoscopicTraffic)
+				{
+					TrafficLaneData.bIsMesoscopic = false;
+				}
+				else if (!Viewers.IsEmpty())
+				{
+					float DistanceToNearestViewer = TNumericLimits<float>::Max();
+					for (const FViewerInfo& Viewer : Viewers)
+					{
+						if (Viewer.Handle.IsValid())
+						{
+							const float DistanceToViewer = FMath::Max(FVector::Distance(TrafficLaneData.CenterLocation, Viewer.Location) - TrafficLaneData.Radius, 0.0f);
+							DistanceToNearestViewer = FMath::Min(DistanceToNearestViewer, DistanceToViewer);
+						}
+					}
+
+					TrafficLaneData.bIsMesoscopic = DistanceToNearestViewer > (TrafficLaneData.bIsMesoscopic ? ExitMesoscopicDistance : EnterMesoscopicDistance);
+				}
+
+				const bool bCanTransitionVehicles = CanTransitionVehiclesOnLane(TrafficLaneData);
+				if (TrafficLaneData.bIsMesoscopic)
+				{
+					++PassNumMesoscopicLanes;
+
+					if (NumTransitionsRemaining > 0)
+					{
+						const int32 NumLaneVehiclesAbsorbed = AbsorbVehicles(EntityManager, Context, TrafficLaneData, NumTransitionsRemaining);
+						NumTransitionsRemaining -= NumLaneVehiclesAbsorbed;
+						NumVehiclesAbsorbed += NumLaneVehiclesAbsorbed;
+					}
+				}
+
+				if (!TrafficLaneData.MesoscopicVehicles.IsEmpty() && (TrafficLaneData.bIsMesoscopic || !bCanTransitionVehicles))
+				{
+					SendMesoscopicFlow(TrafficLaneData, StepDeltaTime);
+				}
+
+				// Vehicles received since this lane's last step only join it now, after it has sent its own, so
+				// vehicles move at most one lane per step regardless of lane order. They queue behind the lane's
+				// existing vehicles, having entered at its start.
+				if (!TrafficLaneData.MesoscopicInflow.IsEmpty())
+				{
+					TrafficLaneData.MesoscopicVehicles.Append(TrafficLaneData.MesoscopicInflow);
+					TrafficLaneData.MesoscopicInflow.Reset();
+				}
+
+				if (!TrafficLaneData.bIsMesoscopic && bCanTransitionVehicles && !TrafficLaneData.MesoscopicVehicles.IsEmpty())
+				{
+					EmissionLanes.Add(&TrafficLaneData);
+				}
+
+				PassNumMesoscopicVehicles += TrafficLaneData.MesoscopicVehicles.Num();
+			}
+		}
+
+		if (LaneTimeSlice.Finish())
+		{
+			LastLanePassTime = LanePassTime;
+			LanePassTime = 0.0f;
+
+			LastPassNumMesoscopicLanes = PassNumMesoscopicLanes;
+			LastPassNumMesoscopicVehicles = PassNumMesoscopicVehicles;
+			PassNumMesoscopicLanes = 0;
+			PassNumMesoscopicVehicles = 0;
+		}
+	}
+
+	// Re-emit absorbed vehicles onto the tail of the non-mesoscopic lanes they have flowed to. Any left over wait for
+	// the lane's next update.
+	int32 NumVehiclesEmitted = 0;
+	if (!EmissionLanes.IsEmpty() && NumTransitionsRemaining > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("EmitMesoscopicVehicles"))
+
+		for (FZoneGraphTrafficLaneData* EmissionLane : EmissionLanes)
+		{
+			const int32 NumLaneVehiclesEmitted = EmitVehicles(EntityManager, Context, *EmissionLane, NumTransitionsRemaining);
+			NumTransitionsRemaining -= NumLaneVehiclesEmitted;
+			NumVehiclesEmitted += NumLaneVehiclesEmitted;
+			if (NumTransitionsRemaining <= 0)
+			{
+				break;
+			}
+		}
+	}
+
+	// Stats
+	INC_DWORD_STAT_BY(STAT_Traffic_MesoscopicLanes, LastPassNumMesoscopicLanes);
+	INC_DWORD_STAT_BY(STAT_Traffic_MesoscopicVehicles, LastPassNumMesoscopicVehicles);
+	INC_DWORD_STAT_BY(STAT_Traffic_MesoscopicVehiclesAbsorbed, NumVehiclesAbsorbed);
+	INC_DWORD_STAT_BY(STAT_Traffic_MesoscopicVehiclesEmitted, NumVehiclesEmitted);
+}
+
+int32 UMassTrafficMesoscopicProcessor::AbsorbVehicles(
+	FMassEntityManager& EntityManager,
+	FMassExecutionContext& Context,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	const int32 MaxVehicles
+) const
+{
+	if (!CanTransitionVehiclesOnLane(TrafficLaneData))
+	{
+		return 0;
+	}
+
+	// Absorb vehicles from the tail of the lane forwards, stopping at the first one that can't be. Absorbing only tail
+	// vehicles means no vehicle on this lane is left following an absorbed one.
+	int32 NumVehiclesAbsorbed = 0;
+	while (NumVehiclesAbsorbed < MaxVehicles && TrafficLaneData.TailVehicle.IsSet())
+	{
+		const FMassEntityHandle VehicleEntity = TrafficLaneData.TailVehicle;
+		const FMassEntityView VehicleEntityView(EntityManager, VehicleEntity);
+
+		// Only absorb regular, unrepresented Off LOD traffic vehicles. Recyclable vehicles are left to the overseer
+		// and vehicles with trailers, or restricted to trunk lanes, can't be re-emitted on any lane.
+		if (!VehicleEntityView.HasTag<FMassTrafficVehicleTag>()
+			|| VehicleEntityView.GetFragmentData<FMassTrafficSimulationLODFragment>().LOD != EMassLOD::Off
+			|| VehicleEntityView.GetFragmentData<FMassRepresentationFragment>().CurrentRepresentation != EMassRepresentationType::None
+			|| VehicleEntityView.GetFragmentData<FMassTrafficVehicleLaneChangeFragment>().IsLaneChangeInProgress()
+			|| VehicleEntityView.GetFragmentDataPtr<FMassTrafficConstrainedTrailerFragment>() != nullptr)
+		{
+			break;
+		}
+
+		FMassTrafficVehicleControlFragment& VehicleControlFragment = VehicleEntityView.GetFragmentData<FMassTrafficVehicleControlFragment>();
+		if (VehicleControlFragment.bRestrictedToTrunkLanesOnly)
+		{
+			break;
+		}
+
+		const bool bRemoved = UE::MassTraffic::RemoveTailVehicleFromLane(
+			VehicleEntity,
+			TrafficLaneData,
+			VehicleControlFragment,
+			VehicleEntityView.GetFragmentData<FAgentRadiusFragment>(),
+			VehicleEntityView.GetFragmentData<FMassTrafficRandomFractionFragment>(),
+			VehicleEntityView.GetFragmentData<FMassTrafficNextVehicleFragment>(),
+			*MassTrafficSettings,
+			EntityManager);
+		if (!bRemoved)
+		{
+			break;
+		}
+
+		// Absorbed vehicles were ahead of any vehicles already aggregated here, which joined at the lane's start. They
+		// keep occupying the lane, now at the aggregate spacing.
+		TrafficLaneData.MesoscopicVehicles.Insert(VehicleEntity, 0);
+		TrafficLaneData.AddVehicleOccupancy(MassTrafficSettings->MesoscopicVehicleSpacing);
+
+		// Hand the vehicle over to the mesoscopic simulation
+		Context.Defer().SwapTags<FMassTrafficVehicleTag, FMassTrafficMesoscopicVehicleTag>(VehicleEntity);
+
+		++NumVehiclesAbsorbed;
+	}
+
+	return NumVehiclesAbsorbed;
+}
+
+int32 UMassTrafficMesoscopicProcessor::EmitVehicles(
+	FMassEntityManager& EntityManager,
+	FMassExecutionContext& Context,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	const int32 MaxVehicles
+) const
+{
+	const UZoneGraphSubsystem& ZoneGraphSubsystem = Context.GetSubsystemChecked<UZoneGraphSubsystem>();
+	const float FreeFlowSpeed = TrafficLaneData.ConstData.SpeedLimit * GMassTrafficSpeedLimitScale;
+
+	int32 NumVehiclesEmitted = 0;
+	int32 NumVehiclesConsumed = 0;
+	for (; NumVehiclesConsumed < TrafficLaneData.MesoscopicVehicles.Num() && NumVehiclesEmitted < MaxVehicles; ++NumVehiclesConsumed)
+	{
+		const FMassEntityHandle VehicleEntity = TrafficLaneData.MesoscopicVehicles[NumVehiclesConsumed];
+
+		// Vehicles destroyed while aggregated are simply dropped
+		if (!EntityManager.IsEntityValid(VehicleEntity))
+		{
+			TrafficLaneData.RemoveVehicleOccupancy(MassTrafficSettings->MesoscopicVehicleSpacing);
+			continue;
+		}
+
+		const FMassEntityView VehicleEntityView(EntityManager, VehicleEntity);
+		const FAgentRadiusFragment& RadiusFragment = VehicleEntityView.GetFragmentData<FAgentRadiusFragment>();
+
+		// Find room at the tail of the lane, spreading vehicles out along otherwise empty lanes rather than bunching
+		// them up at the end. Vehicles join traffic at the speed of the vehicle they follow, or the lane's free flow
+		// speed if there is none.
+		const int32 NumVehiclesToSpace = FMath::Max(TrafficLaneData.NumVehiclesOnLane - TrafficLaneData.MesoscopicInflow.Num(), 1);
+		const float VehicleSpacing = FMath::Max(MassTrafficSettings->MesoscopicVehicleSpacing, TrafficLaneData.Length / NumVehiclesToSpace);
+		float DistanceAlongLane = 0.0f;
+		float Speed = FreeFlowSpeed;
+		if (TrafficLaneData.TailVehicle.IsSet())
+		{
+			const FMassEntityView TailVehicleEntityView(EntityManager, TrafficLaneData.TailVehicle);
+			const float TailDistanceAlongLane = TailVehicleEntityView.GetFragmentData<FMassZoneGraphLaneLocationFragment>().DistanceAlongLane;
+			const float TailRadius = TailVehicleEntityView.GetFragmentData<FAgentRadiusFragment>().Radius;
+			DistanceAlongLane = FMath::Min(TailDistanceAlongLane - VehicleSpacing, TailDistanceAlongLane - TailRadius - RadiusFragment.Radius);
+			Speed = FMath::Min(TailVehicleEntityView.GetFragmentData<FMassTrafficVehicleControlFragment>().Speed, FreeFlowSpeed);
+		}
+		else
+		{
+			DistanceAlongLane = FMath::Min(TrafficLaneData.Length - VehicleSpacing * 0.5f, TrafficLaneData.Length - RadiusFragment.Radius);
+		}
+
+		if (DistanceAlongLane < RadiusFragment.Radius)
+		{
+			// No room left on this lane this frame
+			break;
+		}
+
+		FMassTrafficVehicleControlFragment& VehicleControlFragment = VehicleEntityView.GetFragmentData<FMassTrafficVehicleControlFragment>();
+		FMassZoneGraphLaneLocationFragment& LaneLocationFragment = VehicleEntityView.GetFragmentData<FMassZoneGraphLaneLocationFragment>();
+
+		// Swap the aggregate occupancy for the vehicle's own
+		TrafficLaneData.RemoveVehicleOccupancy(MassTrafficSettings->MesoscopicVehicleSpacing);
+		UE::MassTraffic::InsertVehicleAsLaneTail(
+			VehicleEntity,
+			TrafficLaneData,
+			DistanceAlongLane,
+			VehicleControlFragment,
+			RadiusFragment,
+			VehicleEntityView.GetFragmentData<FMassTrafficRandomFractionFragment>(),
+			LaneLocationFragment,
+			VehicleEntityView.GetFragmentData<FMassTrafficNextVehicleFragment>(),
+			VehicleEntityView.GetFragmentData<FMassTrafficObstacleAvoidanceFragment>(),
+			*MassTrafficSettings,
+			EntityManager);
+
+		VehicleControlFragment.Speed = Speed;
+
+		// Set the new lane location as PrevTransform too, otherwise computed velocity for this frame would be
+		// enormous. @see UMassTrafficOverseerProcessor::MoveVehicleToFreeSpaceOnRandomLane
+		const FZoneGraphStorage* ZoneGraphStorage = ZoneGraphSubsystem.GetZoneGraphStorage(LaneLocationFragment.LaneHandle.DataHandle);
+		check(ZoneGraphStorage);
+		FTransform NewLaneLocationTransform;
+		UE::MassTraffic::InterpolatePositionAndOrientationAlongLane(
+			*ZoneGraphStorage,
+			LaneLocationFragment.LaneHandle.Index,
+			LaneLocationFragment.DistanceAlongLane,
+			ETrafficVehicleMovementInterpolationMethod::CubicBezier,
+			VehicleEntityView.GetFragmentData<FMassTrafficInterpolationFragment>().LaneLocationLaneSegment,
+			NewLaneLocationTransform);
+		NewLaneLocationTransform.AddToTranslation(NewLaneLocationTransform.GetRotation().GetRightVector() * VehicleEntityView.GetFragmentData<FMassTrafficLaneOffsetFragment>().LateralOffset);
+		VehicleEntityView.GetFragmentData<FMassRepresentationFragment>().PrevTransform = NewLaneLocationTransform;
+		VehicleEntityView.GetFragmentData<FTransformFragment>().SetTransform(NewLaneLocationTransform);
+
+		// Back to being an individual traffic vehicle
+		Context.Defer().SwapTags<FMassTrafficMesoscopicVehicleTag, FMassTrafficVehicleTag>(VehicleEntity);
+
+		++NumVehiclesEmitted;
+	}
+
+	TrafficLaneData.MesoscopicVehicles.RemoveAt(0, NumVehiclesConsumed, EAllowShrinking::No);
+
+	return NumVehiclesEmitted;
+}
+
+void UMassTrafficMesoscopicProcessor::SendMesoscopicFlow(FZoneGraphTrafficLaneData& TrafficLaneData, const float DeltaTime) const
+{
+	const float FreeFlowSpeed = TrafficLaneData.ConstData.SpeedLimit * GMassTrafficSpeedLimitScale;
+	// Vehicles received since the last step aren't on the lane yet
+	const int32 NumVehicles = TrafficLaneData.NumVehiclesOnLane - TrafficLaneData.MesoscopicInflow.Num();
+
+	// Sending: The fraction of the lane's vehicles that would reach its end this step at free flow speed. Fractions of
+	// a vehicle carry over to later steps, until a whole one can be sent.
+	const float SendingFraction = TrafficLaneData.Length > 0.0f ? FMath::Clamp(FreeFlowSpeed * DeltaTime / TrafficLaneData.Length, 0.0f, 1.0f) : 1.0f;
+	TrafficLaneData.MesoscopicOutflow += TrafficLaneData.MesoscopicVehicles.Num() * SendingFraction;
+
+	// Send whole vehicles from the front of the lane, each to the first next lane with room to receive it. Vehicles
+	// pick their first choice of next lane by entity index, spreading them evenly but consistently across next lanes.
+	int32 NumSentVehicles = 0;
+	const int32 NumNextLanes = TrafficLaneData.NextLanes.Num();
+	while (TrafficLaneData.MesoscopicOutflow >= 1.0f && NumSentVehicles < TrafficLaneData.MesoscopicVehicles.Num() && NumNextLanes > 0)
+	{
+		const FMassEntityHandle VehicleEntity = TrafficLaneData.MesoscopicVehicles[NumSentVehicles];
+
+		FZoneGraphTrafficLaneData* ReceivingLane = nullptr;
+		for (int32 NextLaneOffset = 0; NextLaneOffset < NumNextLanes && !ReceivingLane; ++NextLaneOffset)
+		{
+			FZoneGraphTrafficLaneData* NextLane = TrafficLaneData.NextLanes[(VehicleEntity.Index + NextLaneOffset) % NumNextLanes];
+			if (GetMesoscopicReceivingCapacity(*NextLane) >= 1.0f)
+			{
+				ReceivingLane = NextLane;
+			}
+		}
+		if (!ReceivingLane)
+		{
+			// Blocked downstream
+			break;
+		}
+
+		// The vehicle's occupancy moves with it
+		ReceivingLane->MesoscopicInflow.Add(VehicleEntity);
+		ReceivingLane->AddVehicleOccupancy(MassTrafficSettings->MesoscopicVehicleSpacing);
+		TrafficLaneData.RemoveVehicleOccupancy(MassTrafficSettings->MesoscopicVehicleSpacing);
+		TrafficLaneData.MesoscopicOutflow -= 1.0f;
+		++NumSentVehicles;
+	}
+	TrafficLaneData.MesoscopicVehicles.RemoveAt(0, NumSentVehicles, EAllowShrinking::No);
+
+	// Don't bank outflow while blocked or empty, so the lane can't later release a burst beyond its free flow rate
+	TrafficLaneData.MesoscopicOutflow = TrafficLaneData.MesoscopicVehicles.IsEmpty() ? 0.0f : FMath::Min(TrafficLaneData.MesoscopicOutflow, 1.0f);
+
+	// Flow (vehicles/s) and space mean speed (flow / density) of the lane this step
+	const float Flow = DeltaTime > 0.0f ? NumSentVehicles / DeltaTime : 0.0f;
+	TrafficLaneData.MesoscopicFlow = Flow;
+	TrafficLaneData.MesoscopicSpeed = NumVehicles > 0 ? FMath::Min(Flow * TrafficLaneData.Length / NumVehicles, FreeFlowSpeed) : FreeFlowSpeed;
+}
+
+float UMassTrafficMesoscopicProcessor::GetMesoscopicReceivingCapacity(const FZoneGraphTrafficLaneData& TrafficLaneData) const
+{
+	if (!TrafficLaneData.bIsOpen)
+	{
+		return 0.0f;
+	}
+
+	// Aggregated vehicles, pending or not, already occupy the lane. NumVehiclesOnLane mustn't overflow either.
+	const float MaxVehiclesToReceive = static_cast<float>(TNumericLimits<uint8>::Max() - TrafficLaneData.NumVehiclesOnLane);
+
+	// Non-mesoscopic lanes receive vehicles to emit, so can only receive as many as they have space for
+	if (!TrafficLaneData.bIsMesoscopic && CanTransitionVehiclesOnLane(TrafficLaneData))
+	{
+		return FMath::Clamp(TrafficLaneData.SpaceAvailable / MassTrafficSettings->MesoscopicVehicleSpacing, 0.0f, MaxVehiclesToReceive);
+	}
+
+	return FMath::Clamp(GetMesoscopicCapacity(TrafficLaneData) - TrafficLaneData.NumVehiclesOnLane, 0.0f, MaxVehiclesToReceive);
+}
+
+float UMassTrafficMesoscopicProcessor::GetMesoscopicCapacity(const FZoneGraphTrafficLaneData& TrafficLaneData) const
+{
+	// Always allow at least one vehicle, so very short lanes don't block flow  
+	return FMath::Max(TrafficLaneData.Length / MassTrafficSettings->MesoscopicVehicleSpacing * TrafficLaneData.MaxDensity, 1.0f);
+}
+
+bool UMassTrafficMesoscopicProcessor::CanTransitionVehiclesOnLane(const FZoneGraphTrafficLaneData& TrafficLaneData)
+{
+	return !TrafficLaneData.ConstData.bIsIntersectionLane
+		&& TrafficLaneData.MergingLanes.IsEmpty()
+		&& TrafficLaneData.SplittingLanes.IsEmpty()
+		&& TrafficLaneData.NumVehiclesLaneChangingOntoLane == 0
+		&& TrafficLaneData.NumVehiclesLaneChangingOffOfLane == 0
+		&& !UE::MassTraffic::AreVehiclesCurrentlyApproachingLaneFromIntersection(TrafficLaneData);
+}
@@ -936,4 +936,124 @@ bool TeleportVehicleToAnotherLane(
 	return true;
 }
 
+bool RemoveTailVehicleFromLane(
+	const FMassEntityHandle VehicleEntity,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	FMassTrafficVehicleControlFragment& VehicleControlFragment,
+	const FAgentRadiusFragment& RadiusFragment,
+	const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+	FMassTrafficNextVehicleFragment& NextVehicleFragment,
+	const UMassTrafficSettings& MassTrafficSettings,
+	const FMassEntityManager& EntityManager
+)
+{
+	// If vehicle can't stop, it's committed itself and registered with the next lane. Leave it be.
+	if (VehicleControlFragment.bCantStopAtLaneExit || TrafficLaneData.TailVehicle != VehicleEntity)
+	{
+		return false;
+	}
+
+	// The vehicle ahead, if it's still on this lane, becomes the new tail. As we were the tail, nothing on this lane
+	// references us as its next vehicle.
+	FMassEntityHandle NewTailVehicle;
+	if (NextVehicleFragment.HasNextVehicle())
+	{
+		const FMassZoneGraphLaneLocationFragment& NextLaneLocationFragment = EntityManager.GetFragmentDataChecked<FMassZoneGraphLaneLocationFragment>(NextVehicleFragment.GetNextVehicle());
+		if (NextLaneLocationFragment.LaneHandle == TrafficLaneData.LaneHandle)
+		{
+			NewTailVehicle = NextVehicleFragment.GetNextVehicle();
+		}
+	}
+	TrafficLaneData.TailVehicle = NewTailVehicle;
+	NextVehicleFragment = FMassTrafficNextVehicleFragment();
+
+	// Give back the space we took on the lane
+	const float SpaceTakenByVehicle = GetSpaceTakenByVehicleOnLane(RadiusFragment.Radius, RandomFractionFragment.RandomFraction, MassTrafficSettings.MinimumDistanceToNextVehicleRange);
+	TrafficLaneData.RemoveVehicleOccupancy(SpaceTakenByVehicle);
+
+	// We're no longer approaching our chosen next lane
+	if (VehicleControlFragment.NextLane)
+	{
+		--VehicleControlFragment.NextLane->NumVehiclesApproachingLane;
+		VehicleControlFragment.NextLane = nullptr;
+	}
+
+	return true;
+}
+
+void InsertVehicleAsLaneTail(
+	const FMassEntityHandle VehicleEntity,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	const float DistanceAlongLane,
+	FMassTrafficVehicleControlFragment& VehicleControlFragment,
+	const FAgentRadiusFragment& RadiusFragment,
+	const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+	FMassZoneGraphLaneLocationFragment& LaneLocationFragment,
+	FMassTrafficNextVehicleFragment& NextVehicleFragment,
+	FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+	const UMassTrafficSettings& MassTrafficSettings,
+	const FMassEntityManager& EntityManager
+)
+{
+	// Break any stale NextVehicle references to VehicleEntity from vehicles already on the lane, as we are about to be
+	// behind them all. @see TeleportVehicleToAnotherLane
+	TrafficLaneData.ForEachVehicleOnLane(EntityManager, [VehicleEntity](const FMassEntityView& VehicleMassEntityView, struct FMassTrafficNextVehicleFragment& LaneVehicle_NextVehicleFragment, struct FMassZoneGraphLaneLocationFragment& LaneVehicle_LaneLocationFragment)
+	{
+		if (LaneVehicle_NextVehicleFragment.GetNextVehicle() == VehicleEntity)
+		{
+			LaneVehicle_NextVehicleFragment.UnsetNextVehicle();
+			return false;
+		}
+
+		return true;
+	});
+
+	// Follow the current tail vehicle and become the new tail
+	const FMassEntityHandle OldTailVehicle = TrafficLaneData.TailVehicle;
+	AvoidanceFragment.DistanceToNext = TNumericLimits<float>::Max();
+	if (OldTailVehicle.IsSet())
+	{
+		NextVehicleFragment.SetNextVehicle(VehicleEntity, OldTailVehicle);
+
+		const FMassEntityView OldTailVehicleEntityView(EntityManager, OldTailVehicle);
+		const FMassZoneGraphLaneLocationFragment& OldTail_LaneLocationFragment = OldTailVehicleEntityView.GetFragmentData<FMassZoneGraphLaneLocationFragment>();
+		const FAgentRadiusFragment& OldTail_RadiusFragment = OldTailVehicleEntityView.GetFragmentData<FAgentRadiusFragment>();
+		AvoidanceFragment.DistanceToNext = FMath::Max((OldTail_LaneLocationFragment.DistanceAlongLane - DistanceAlongLane) - OldTail_RadiusFragment.Radius - RadiusFragment.Radius, 0.0f);
+	}
+	else
+	{
+		NextVehicleFragment.UnsetNextVehicle();
+	}
+	TrafficLaneData.TailVehicle = VehicleEntity;
+
+	// Take up space on the lane
+	const float SpaceTakenByVehicle = GetSpaceTakenByVehicleOnLane(RadiusFragment.Radius, RandomFractionFragment.RandomFraction, MassTrafficSettings.MinimumDistanceToNextVehicleRange);
+	TrafficLaneData.AddVehicleOccupancy(SpaceTakenByVehicle);
+
+	VehicleControlFragment.CurrentLaneConstData = TrafficLaneData.ConstData;
+	VehicleControlFragment.PreviousLaneIndex = INDEX_NONE;
+
+	LaneLocationFragment.LaneHandle = TrafficLaneData.LaneHandle;
+	LaneLocationFragment.DistanceAlongLane = DistanceAlongLane;
+	LaneLocationFragment.LaneLength = TrafficLaneData.Length;
+
+	// As in MoveVehicleToNextLane, pre-set the next lane if there's only one
+	if (TrafficLaneData.NextLanes.Num() == 1)
+	{
+		VehicleControlFragment.NextLane = TrafficLaneData.NextLanes[0];
+		++VehicleControlFragment.NextLane->NumVehiclesApproachingLane;
+
+		TrafficLaneData.UpdateDownstreamFlowDensity(MassTrafficSettings.DownstreamFlowDensityMixtureFraction);
+
+		if (!NextVehicleFragment.HasNextVehicle() && VehicleControlFragment.NextLane->TailVehicle.IsSet())
+		{
+			NextVehicleFragment.SetNextVehicle(VehicleEntity, VehicleControlFragment.NextLane->TailVehicle);
+		}
+	}
+	else
+	{
+		VehicleControlFragment.NextLane = nullptr;
+	}
+}
+
 }
@@ -0,0 +1,228 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassTrafficOcclusion.h"
+
+#include "Algo/AnyOf.h"
+#include "MassTraffic.h"
+#include "MassTrafficSettings.h"
+#include "MassTrafficUtils.h"
+#include "ZoneGraphData.h"
+#include "ZoneGraphQuery.h"
+#include "ZoneGraphSubsystem.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Misc/ScopedSlowTask.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "MassTrafficOcclusion"
+
+void FMassTrafficBakedZoneGraphOcclusion::BuildCellLookup()
+{
+	CellLookup.Reset();
+	CellLookup.Reserve(Cells.Num());
+	for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+	{
+		CellLookup.Add(Cells[CellIndex].Cell, CellIndex);
+	}
+}
+
+const FMassTrafficBakedZoneGraphOcclusion* UMassTrafficOcclusionDataAsset::FindZoneGraphOcclusion(const FZoneGraphStorage& ZoneGraphStorage) const
+{
+	if (ZoneGraphOcclusion.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const uint32 BakeHash = GetOcclusionBakeHash(ZoneGraphStorage);
+	return ZoneGraphOcclusion.FindByPredicate([BakeHash](const FMassTrafficBakedZoneGraphOcclusion& Occlusion)
+	{
+		return Occlusion.BakeHash == BakeHash;
+	});
+}
+
+uint32 UMassTrafficOcclusionDataAsset::GetOcclusionBakeHash(const FZoneGraphStorage& ZoneGraphStorage)
+{
+	// Only lanes passing the traffic lane filter are baked, lane densities don't matter here
+	const UMassTrafficSettings* MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+	return HashCombineFast(UE::MassTraffic::GetZoneGraphStorageHash(ZoneGraphStorage), UE::MassTraffic::GetTrafficLaneSettingsHash(MassTrafficSettings->TrafficLaneFilter, {}));
+}
+
+void UMassTrafficOcclusionDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	for (FMassTrafficBakedZoneGraphOcclusion& Occlusion : ZoneGraphOcclusion)
+	{
+		Occlusion.BuildCellLookup();
+	}
+}
+
+#if WITH_EDITOR
+
+void UMassTrafficOcclusionDataAsset::BakeOcclusionFromMap()
+{
+	ZoneGraphOcclusion.Reset();
+
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const UZoneGraphSubsystem* ZoneGraphSubsystem = UWorld::GetSubsystem<UZoneGraphSubsystem>(World);
+	if (!ensure(ZoneGraphSubsystem))
+	{
+		return;
+	}
+
+	const UMassTrafficSettings* MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+	const TConstArrayView<FRegisteredZoneGraphData> RegisteredZoneGraphDataArray = ZoneGraphSubsystem->GetRegisteredZoneGraphData();
+
+	FScopedSlowTask SlowTask(RegisteredZoneGraphDataArray.Num(), LOCTEXT("BakingOcclusionFromMap", "Baking traffic occlusion"));
+	SlowTask.MakeDialog(/*bShowCancelButton*/true);
+
+	for (const FRegisteredZoneGraphData& RegisteredZoneGraphData : RegisteredZoneGraphDataArray)
+	{
+		SlowTask.EnterProgressFrame();
+		if (!RegisteredZoneGraphData.bInUse || !RegisteredZoneGraphData.ZoneGraphData)
+		{
+			continue;
+		}
+		const FZoneGraphStorage& ZoneGraphStorage = RegisteredZoneGraphData.ZoneGraphData->GetStorage();
+
+		FMassTrafficBakedZoneGraphOcclusion& Occlusion = ZoneGraphOcclusion.AddDefaulted_GetRef();
+		if (!BakeZoneGraphOcclusion(*World, ZoneGraphStorage, MassTrafficSettings->TrafficLaneFilter, Occlusion))
+		{
+			ZoneGraphOcclusion.Reset();
+			return;
+		}
+		Occlusion.BakeHash = GetOcclusionBakeHash(ZoneGraphStorage);
+	}
+
+	Modify();
+}
+
+bool UMassTrafficOcclusionDataAsset::BakeZoneGraphOcclusion(const UWorld& World, const FZoneGraphStorage& ZoneGraphStorage, const FZoneGraphTagFilter& LaneFilter, FMassTrafficBakedZoneGraphOcclusion& OutOcclusion) const
+{
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MassTrafficOcclusionBake), /*bTraceComplex*/false);
+	const float MaxOcclusionDistanceSq = FMath::Square(MaxOcclusionDistance);
+	const float MinLaneSampleSpacing = FMath::Max(LaneSampleSpacing, 100.0f);
+	const int32 NumViewerSamplesPerSide = FMath::Max(ViewerSamplesPerCellSide, 2);
+
+	OutOcclusion.Cells.Reset();
+	OutOcclusion.CellSize = CellSize;
+	OutOcclusion.ViewerHeightTolerance = ViewerHeightTolerance;
+
+	// Sample points along all traffic lanes, and the viewer cells containing them along with their average height.
+	// LaneSamplePoints for LaneIndices[I] are LaneSampleStarts[I] to LaneSampleStarts[I + 1].
+	TArray<int32> LaneIndices;
+	TArray<int32> LaneSampleStarts;
+	TArray<FVector> LaneSamplePoints;
+	TMap<FIntPoint, FVector2D> CellHeights; // X = Sum of sample heights, Y = Number of samples
+	for (int32 LaneIndex = 0; LaneIndex < ZoneGraphStorage.Lanes.Num(); ++LaneIndex)
+	{
+		if (!LaneFilter.Pass(ZoneGraphStorage.Lanes[LaneIndex].Tags))
+		{
+			continue;
+		}
+
+		float LaneLength = 0.0f;
+		UE::ZoneGraph::Query::GetLaneLength(ZoneGraphStorage, LaneIndex, LaneLength);
+
+		LaneIndices.Add(LaneIndex);
+		LaneSampleStarts.Add(LaneSamplePoints.Num());
+		const int32 NumLaneSamples = FMath::Max(FMath::CeilToInt32(LaneLength / MinLaneSampleSpacing) + 1, 2);
+		for (int32 SampleIndex = 0; SampleIndex < NumLaneSamples; ++SampleIndex)
+		{
+			FZoneGraphLaneLocation LaneLocation;
+			UE::ZoneGraph::Query::CalculateLocationAlongLane(ZoneGraphStorage, LaneIndex, LaneLength * SampleIndex / (NumLaneSamples - 1), LaneLocation);
+			LaneSamplePoints.Add(LaneLocation.Position);
+
+			FVector2D& CellHeight = CellHeights.FindOrAdd(OutOcclusion.GetCell(LaneLocation.Position), FVector2D::ZeroVector);
+			CellHeight.X += LaneLocation.Position.Z;
+			CellHeight.Y += 1.0f;
+		}
+	}
+	LaneSampleStarts.Add(LaneSamplePoints.Num());
+
+	FScopedSlowTask SlowTask(CellHeights.Num(), FText::Format(LOCTEXT("BakingOcclusion", "Baking traffic occlusion for {0} viewer cells"), CellHeights.Num()));
+
+	const int32 NumLaneBitWords = FMath::DivideAndRoundUp(ZoneGraphStorage.Lanes.Num(), 32);
+	OutOcclusion.Cells.Reserve(CellHeights.Num());
+	TArray<FVector> ViewerLocations;
+	for (const TPair<FIntPoint, FVector2D>& CellHeight : CellHeights)
+	{
+		SlowTask.EnterProgressFrame();
+		if (SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+
+		FMassTrafficBakedOcclusionCell& BakedCell = OutOcclusion.Cells.AddDefaulted_GetRef();
+		BakedCell.Cell = CellHeight.Key;
+		BakedCell.VisibleLaneBits.SetNumZeroed(NumLaneBitWords);
+
+		const float LaneZ = CellHeight.Value.X / CellHeight.Value.Y;
+		const float ViewerZ = LaneZ + ViewerHeight;
+		BakedCell.ViewerZ = ViewerZ;
+		const FVector CellMin(CellHeight.Key.X * CellSize, CellHeight.Key.Y * CellSize, ViewerZ);
+		const FVector CellCenter = CellMin + FVector(CellSize * 0.5f, CellSize * 0.5f, 0.0f);
+
+		// Test from a grid of points across the cell, at the bottom, middle and top of its height band, but not below
+		// its lanes. A lane is only baked as occluded if it's hidden from all of them, so the bake errs towards
+		// visible. Gaps between occluders narrower than the viewer sample spacing can still be missed.
+		const float ViewerSampleSpacing = CellSize / (NumViewerSamplesPerSide - 1);
+		ViewerLocations.Reset();
+		for (const float ViewerSampleZ : { ViewerZ - ViewerHeightTolerance, ViewerZ, ViewerZ + ViewerHeightTolerance })
+		{
+			if (ViewerSampleZ < LaneZ)
+			{
+				continue;
+			}
+			for (int32 Y = 0; Y < NumViewerSamplesPerSide; ++Y)
+			{
+				for (int32 X = 0; X < NumViewerSamplesPerSide; ++X)
+				{
+					ViewerLocations.Add(FVector(CellMin.X + X * ViewerSampleSpacing, CellMin.Y + Y * ViewerSampleSpacing, ViewerSampleZ));
+				}
+			}
+		}
+
+		for (int32 LaneIndicesIndex = 0; LaneIndicesIndex < LaneIndices.Num(); ++LaneIndicesIndex)
+		{
+			const TConstArrayView<FVector> SamplePoints(&LaneSamplePoints[LaneSampleStarts[LaneIndicesIndex]], LaneSampleStarts[LaneIndicesIndex + 1] - LaneSampleStarts[LaneIndicesIndex]);
+
+			// Lanes too far away to occlude are left visible, as are lanes passing through this or a neighboring cell,
+			// which viewers can be right next to
+			bool bIsVisible = !Algo::AnyOf(SamplePoints, [&CellCenter, MaxOcclusionDistanceSq](const FVector& SamplePoint)
+			{
+				return FVector::DistSquared2D(CellCenter, SamplePoint) < MaxOcclusionDistanceSq;
+			});
+			bIsVisible = bIsVisible || Algo::AnyOf(SamplePoints, [&OutOcclusion, &BakedCell](const FVector& SamplePoint)
+			{
+				const FIntPoint SampleCell = OutOcclusion.GetCell(SamplePoint);
+				return FMath::Abs(SampleCell.X - BakedCell.Cell.X) <= 1 && FMath::Abs(SampleCell.Y - BakedCell.Cell.Y) <= 1;
+			});
+			for (int32 SampleIndex = 0; SampleIndex < SamplePoints.Num() && !bIsVisible; ++SampleIndex)
+			{
+				const FVector SampleTarget = SamplePoints[SampleIndex] + FVector(0.0f, 0.0f, VehicleHeight);
+				bIsVisible = Algo::AnyOf(ViewerLocations, [&World, &SampleTarget, &QueryParams, this](const FVector& ViewerLocation)
+				{
+					return !World.LineTraceTestByChannel(ViewerLocation, SampleTarget, TraceChannel, QueryParams);
+				});
+			}
+
+			if (bIsVisible)
+			{
+				const int32 LaneIndex = LaneIndices[LaneIndicesIndex];
+				BakedCell.VisibleLaneBits[LaneIndex >> 5] |= 1u << (LaneIndex & 31);
+			}
+		}
+	}
+
+	OutOcclusion.BuildCellLookup();
+
+	UE_LOG(LogMassTraffic, Log, TEXT("%s - Baked occlusion for %d traffic lanes from %d viewer cells."), ANSI_TO_TCHAR(__FUNCTION__), LaneIndices.Num(), OutOcclusion.Cells.Num());
+
+	return true;
+}
+
+#endif
+
+#undef LOCTEXT_NAMESPACE
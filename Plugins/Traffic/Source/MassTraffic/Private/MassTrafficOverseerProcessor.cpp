@@ -6,6 +6,7 @@
 #include "MassExecutionContext.h"
 #include "MassEntityView.h"
 #include "MassClientBubbleHandler.h"
+#include "MassLODSubsystem.h"
 #include "MassCommonFragments.h"
 #include "MassNavigationFragments.h"
 #include "MassRepresentationFragments.h"
@@ -27,6 +28,7 @@ UMassTrafficOverseerProcessor::UMassTrafficOverseerProcessor()
 	: RecyclableTrafficVehicleEntityQuery(*this)
 {
 	bAutoRegisterWithProcessingPhases = true;
+	TimeSliceBudgetMicroseconds = 200.0f;
 	ExecutionOrder.ExecuteInGroup = UE::MassTraffic::ProcessorGroupNames::FrameStart;
 	ExecutionOrder.ExecuteAfter.Add(UMassTrafficFrameStartFieldOperationsProcessor::StaticClass()->GetFName());
 }
@@ -53,6 +55,7 @@ void UMassTrafficOverseerProcessor::ConfigureQueries(const TSharedRef<FMassEntit
 
 	ProcessorRequirements.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadWrite);
 	ProcessorRequirements.AddSubsystemRequirement<UZoneGraphSubsystem>(EMassFragmentAccess::ReadOnly);
+	ProcessorRequirements.AddSubsystemRequirement<UMassLODSubsystem>(EMassFragmentAccess::ReadOnly);
 }
 
 void UMassTrafficOverseerProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
@@ -76,164 +79,224 @@ void UMassTrafficOverseerProcessor::Execute(FMassEntityManager& EntityManager, F
 		return;			   		 
 	}
 
-	// Get player view location. Note: This implementation only supports a single viewer.
-	APlayerController* LocalPlayerController = nullptr;
-	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	// Capture the Mass LOD viewers at the start of each lane pass. These include remote viewers, so density
+	// management also works on dedicated servers and for every connected player.
+	if (LaneTimeSliceCursor.NextItemIndex == 0)
 	{
-		APlayerController* PlayerController = Iterator->Get();
-		if (PlayerController && PlayerController->IsLocalController())
+		PassViewers.Reset();
+		for (const FViewerInfo& Viewer : Context.GetSubsystemChecked<UMassLODSubsystem>().GetViewers())
 		{
-			LocalPlayerController = PlayerController;
-			break;
+			if (!Viewer.Handle.IsValid())
+			{
+				continue;
+			}
+
+			FPassViewer& PassViewer = PassViewers.AddDefaulted_GetRef();
+			PassViewer.Location = Viewer.Location;
+			PassViewer.Direction = Viewer.Rotation.Vector();
+
+			// Enclose the frustum in a cone through its corners
+			const float TanHalfHorizontalFOV = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(Viewer.FOV, 1.0f, 179.0f) * 0.5f));
+			const float TanHalfVerticalFOV = TanHalfHorizontalFOV / FMath::Max(Viewer.AspectRatio, UE_KINDA_SMALL_NUMBER);
+			PassViewer.HalfViewAngle = FMath::Atan(FMath::Sqrt(FMath::Square(TanHalfHorizontalFOV) + FMath::Square(TanHalfVerticalFOV)));
 		}
 	}
-	if (!LocalPlayerController)
+	if (PassViewers.IsEmpty())
 	{
 		return;
 	}
-	FVector LocalPlayerViewLocation(ForceInitToZero);
-	FRotator LocalPlayerViewRotation(ForceInit);
-	LocalPlayerController->GetPlayerViewPoint(LocalPlayerViewLocation, LocalPlayerViewRotation);
+	const bool bExcludeLanesInViewerFrustums = MassTrafficSettings->bExcludeLanesInViewerFrustums;
+
+	const TArrayView<FMassTrafficZoneGraphData*> TrafficZoneGraphDatas = LocalMassTrafficSubsystem.GetMutableTrafficZoneGraphData();
+	int32 NumLanes = 0;
+	for (const FMassTrafficZoneGraphData* TrafficZoneGraphData : TrafficZoneGraphDatas)
+	{
+		NumLanes += TrafficZoneGraphData->TrafficLaneDataArray.Num();
+	}
+	const int32 MaxLanesPerSlice = FMath::DivideAndRoundUp(NumLanes, FMath::Max(MassTrafficSettings->NumDensityManagementLanePartitions, 1));
+
+	bool bCompletedLanePass = false;
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("UpdateLaneViewerDistances"))
+
+		// Refresh a time slice of lanes' distances to the nearest viewer this frame to amortise performance costs
+		// across several frames, resuming where the last frame left off. Each slice is also capped to one
+		// NumDensityManagementLanePartitions'th of the lanes.
+		FMassTrafficTimeSlice LaneTimeSlice = MakeTimeSlice(LaneTimeSliceCursor, NumLanes, MaxLanesPerSlice);
+
+		int32 FirstLaneIndex = 0;
+		for (FMassTrafficZoneGraphData* TrafficZoneGraphData : TrafficZoneGraphDatas)
+		{
+			TArray<FZoneGraphTrafficLaneData>& TrafficLaneDataArray = TrafficZoneGraphData->TrafficLaneDataArray;
+			const int32 ZoneGraphFirstLaneIndex = FirstLaneIndex;
+			FirstLaneIndex += TrafficLaneDataArray.Num();
+			if (LaneTimeSlice.IsBudgetSpent())
+			{
+				break;
+			}
+
+			for (int32 LaneIndex = FMath::Max(LaneTimeSlice.GetResumeItemIndex() - ZoneGraphFirstLaneIndex, 0); LaneIndex < TrafficLaneDataArray.Num() && LaneTimeSlice.ShouldProcessItem(ZoneGraphFirstLaneIndex + LaneIndex); ++LaneIndex)
+			{
+				FZoneGraphTrafficLaneData& TrafficLaneData = TrafficLaneDataArray[LaneIndex];
+
+				// Find the distance to the nearest viewer, and whether any viewer can see the lane
+				float DistanceToNearestViewer = TNumericLimits<float>::Max();
+				bool bIsInViewerFrustum = false;
+				for (const FPassViewer& PassViewer : PassViewers)
+				{
+					const FVector ViewerToLane = TrafficLaneData.CenterLocation - PassViewer.Location;
+					const float ViewerToLaneDistance = ViewerToLane.Size();
+					DistanceToNearestViewer = FMath::Min(DistanceToNearestViewer, FMath::Max(ViewerToLaneDistance - TrafficLaneData.Radius, 0.0f));
+
+					if (bExcludeLanesInViewerFrustums && !bIsInViewerFrustum)
+					{
+						// Does the lane's bounding sphere overlap the viewer's frustum cone?
+						if (ViewerToLaneDistance <= TrafficLaneData.Radius)
+						{
+							bIsInViewerFrustum = true;
+						}
+						else
+						{
+							const float AngleToLane = FMath::Acos(FMath::Clamp(FVector::DotProduct(ViewerToLane / ViewerToLaneDistance, PassViewer.Direction), -1.0f, 1.0f));
+							const float LaneAngularRadius = FMath::Asin(TrafficLaneData.Radius / ViewerToLaneDistance);
+							bIsInViewerFrustum = AngleToLane - LaneAngularRadius <= PassViewer.HalfViewAngle;
+						}
+					}
+				}
+				TrafficLaneData.DistanceToNearestViewer = DistanceToNearestViewer;
+				TrafficLaneData.bIsInViewerFrustum = bIsInViewerFrustum;
+			}
+		}
+
+		bCompletedLanePass = LaneTimeSlice.Finish();
+	}
 
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FindTransferLanes"))
 
 		// Reset scratch buffers
 		BusiestLanes.Reset(MassTrafficSettings->NumBusiestLanesToTransferFrom);
-		BusiestLaneDensityExcesses.Reset(MassTrafficSettings->NumBusiestLanesToTransferFrom);
 		LeastBusiestLanes.Reset(MassTrafficSettings->NumLeastBusiestLanesToTransferTo);
-		LeastBusiestLaneDensities.Reset(MassTrafficSettings->NumLeastBusiestLanesToTransferTo);
 		LeastBusiestLaneLocations.Reset(MassTrafficSettings->NumLeastBusiestLanesToTransferTo);
 
-		// Find NumManagedLanes busies & least busiest lanes
-		float MinBusiestLaneDensityExcess = TNumericLimits<float>::Max();
-		int32 MinBusiestLaneDensityExcessIndex = 0;
-		float MaxLeastBusiestLaneDensity = TNumericLimits<float>::Min();
-		int32 MaxLeastBusiestLaneDensityIndex = 0;
-		for (FMassTrafficZoneGraphData* TrafficZoneGraphData : LocalMassTrafficSubsystem.GetMutableTrafficZoneGraphData())
+		// Make sure a lane is viable for teleporting cars, there are various reasons we can't:
+		auto IsOKToTeleport = [](const FZoneGraphTrafficLaneData& TrafficLaneData)
 		{
-			// Get partition of lanes to operate on this frame to amortise performance costs across several frames  
-			const int32 PartitionSize = FMath::DivideAndRoundUp(TrafficZoneGraphData->TrafficLaneDataArray.Num(), MassTrafficSettings->NumDensityManagementLanePartitions);
-			const int32 TrafficLanePartitionStart = PartitionSize * PartitionIndex;
-			const TArrayView<FZoneGraphTrafficLaneData> TrafficLanesPartition = MakeArrayView(TrafficZoneGraphData->TrafficLaneDataArray).Mid(TrafficLanePartitionStart, PartitionSize); 
-			for (FZoneGraphTrafficLaneData& TrafficLaneData : TrafficLanesPartition) 
+			return
+				// Don't transfer from / to merging or splitting lanes
+				TrafficLaneData.MergingLanes.IsEmpty() && 
+				TrafficLaneData.SplittingLanes.IsEmpty() &&
+				// Don't transfer from / to lanes with in progress lane changes
+				TrafficLaneData.NumVehiclesLaneChangingOffOfLane == 0 &&
+				TrafficLaneData.NumVehiclesLaneChangingOntoLane == 0 &&
+				// Don't transfer from / to lanes that are downstream from active intersection lanes
+				!UE::MassTraffic::AreVehiclesCurrentlyApproachingLaneFromIntersection(TrafficLaneData);
+		};
+
+		// Density buckets across the whole network are kept up to date as vehicles move between lanes, so we can take
+		// the busiest and least busiest lanes straight from the most extreme buckets each frame. Lanes within a bucket
+		// are unordered. At most MaxLanesPerSlice lanes are considered for each, in case many are filtered out, with
+		// each bucket's scan resuming where it left off last frame so lanes further into large buckets aren't starved.
+		// (See all DENSITYBUCKETS.)
+		const int32 NumZoneGraphs = TrafficZoneGraphDatas.Num();
+		DensityBucketScanFirstZoneGraph = NumZoneGraphs > 0 ? (DensityBucketScanFirstZoneGraph + 1) % NumZoneGraphs : 0;
+		auto ScanDensityBucket = [](const TArray<FZoneGraphTrafficLaneData*>& BucketLanes, int32& ScanStart, int32& NumLanesToConsider, auto&& ConsiderLane)
+		{
+			const int32 NumBucketLanes = BucketLanes.Num();
+			if (NumBucketLanes == 0)
+			{
+				return;
+			}
+
+			// Lanes are swap removed from buckets, so the cursor may have been left beyond the end
+			const int32 FirstLaneIndex = ScanStart % NumBucketLanes;
+			int32 NumLanesExamined = 0;
+			while (NumLanesExamined < NumBucketLanes && NumLanesToConsider > 0)
 			{
-				// Make sure this lane is viable for teleporting cars, there are various reasons we can't:
-				const bool bOKToTeleport =
-					// Don't transfer from / to merging or splitting lanes
-					TrafficLaneData.MergingLanes.IsEmpty() && 
-					TrafficLaneData.SplittingLanes.IsEmpty() &&
-					// Don't transfer from / to lanes with in progress lane changes
-					TrafficLaneData.NumVehiclesLaneChangingOffOfLane == 0 &&
-					TrafficLaneData.NumVehiclesLaneChangingOntoLane == 0 &&
-					// Don't transfer from / to lanes that are downstream from active intersection lanes
-					!UE::MassTraffic::AreVehiclesCurrentlyApproachingLaneFromIntersection(TrafficLaneData); 
-
-				if (!bOKToTeleport)
+				--NumLanesToConsider;
+				const bool bContinue = ConsiderLane(*BucketLanes[(FirstLaneIndex + NumLanesExamined) % NumBucketLanes]);
+				++NumLanesExamined;
+				if (!bContinue)
 				{
-					continue;
+					break;
 				}
+			}
+			ScanStart = (FirstLaneIndex + NumLanesExamined) % NumBucketLanes;
+		};
 
-				// Sort lanes based on how far above their max densities they are
-				const float BasicLaneDensity = TrafficLaneData.BasicDensity();
-				const float FunctionalLaneDensity = TrafficLaneData.FunctionalDensity();
-				const float LaneDensityExcess = BasicLaneDensity - TrafficLaneData.MaxDensity;
+		int32 NumBusiestLanesToConsider = MaxLanesPerSlice;
+		const int32 MinBusiestLaneBucket = FMassTrafficLaneDensityBuckets::GetExcessDensityBucket(0.0f);
+		for (int32 Bucket = FMassTrafficLaneDensityBuckets::NumBuckets - 1; Bucket >= MinBusiestLaneBucket; --Bucket)
+		{
+			for (int32 ZoneGraphOffset = 0; ZoneGraphOffset < NumZoneGraphs; ++ZoneGraphOffset)
+			{
+				if (BusiestLanes.Num() >= MassTrafficSettings->NumBusiestLanesToTransferFrom)
+				{
+					break;
+				}
 
-				// Test distance to player
-				const float DistanceToPlayer = FMath::Max(FVector::Distance(TrafficLaneData.CenterLocation, LocalPlayerViewLocation) - TrafficLaneData.Radius, 0.0f);
-				const bool bIsInBusiestLaneDistanceRange = MassTrafficSettings->BusiestLaneDistanceToPlayerRange.Contains(DistanceToPlayer);
-				const bool bIsInLeastBusiestLaneDistanceRange = MassTrafficSettings->LeastBusiestLaneDistanceToPlayerRange.Contains(DistanceToPlayer);
-				
-				// Collect NumBusiestLanesToTransferFrom of the busiest lanes
-				if (
-					// Is in range to player 
-					bIsInBusiestLaneDistanceRange
-					// Is lane in excess of it's max density?
-					&& LaneDensityExcess >= 0.0f
-					// In the trunk lanes phase, only transfer from trunk lanes so we don't transfer trunk-lane-only
-					// vehicles onto non trunk lanes. Outside the trunk lanes phase, we still transfer vehicles off
-					// trunk lanes but make sure to skip restricted vehicles  
-					&& (!bTrunkLanesPhase || TrafficLaneData.ConstData.bIsTrunkLane)
-				)
+				FMassTrafficLaneDensityBuckets& DensityBuckets = TrafficZoneGraphDatas[(DensityBucketScanFirstZoneGraph + ZoneGraphOffset) % NumZoneGraphs]->DensityBuckets;
+				ScanDensityBucket(DensityBuckets.ExcessDensityBuckets[Bucket], DensityBuckets.ExcessDensityBucketScanStarts[Bucket], NumBusiestLanesToConsider, [&](FZoneGraphTrafficLaneData& TrafficLaneData)
 				{
-					if (BusiestLanes.Num() < MassTrafficSettings->NumBusiestLanesToTransferFrom)
+					if (
+						// Is in range to player and out of view?
+						!TrafficLaneData.bIsInViewerFrustum
+						&& MassTrafficSettings->BusiestLaneDistanceToPlayerRange.Contains(TrafficLaneData.DistanceToNearestViewer)
+						// Is lane in excess of it's max density? (The bucket range extends slightly below 0)
+						&& TrafficLaneData.BasicDensity() - TrafficLaneData.MaxDensity >= 0.0f
+						// In the trunk lanes phase, only transfer from trunk lanes so we don't transfer trunk-lane-only
+						// vehicles onto non trunk lanes. Outside the trunk lanes phase, we still transfer vehicles off
+						// trunk lanes but make sure to skip restricted vehicles  
+						&& (!bTrunkLanesPhase || TrafficLaneData.ConstData.bIsTrunkLane)
+						&& IsOKToTeleport(TrafficLaneData)
+					)
 					{
 						BusiestLanes.Add(&TrafficLaneData);
-						BusiestLaneDensityExcesses.Add(LaneDensityExcess);
-						if (LaneDensityExcess < MinBusiestLaneDensityExcess)
-						{
-							MinBusiestLaneDensityExcess = LaneDensityExcess;
-							MinBusiestLaneDensityExcessIndex = BusiestLanes.Num() - 1;
-						}
 					}
-					else if (LaneDensityExcess > MinBusiestLaneDensityExcess)
-					{
-						// Write over the current min, effectively popping it out of the list
-						BusiestLanes[MinBusiestLaneDensityExcessIndex] = &TrafficLaneData;
-						BusiestLaneDensityExcesses[MinBusiestLaneDensityExcessIndex] = LaneDensityExcess;
 
-						// Find the new min
-						MinBusiestLaneDensityExcess = TNumericLimits<float>::Max();
-						for (int32 BusiestLanesIndex = 0; BusiestLanesIndex < BusiestLanes.Num(); ++BusiestLanesIndex)
-						{
-							const float& BusiestLaneDensity = BusiestLaneDensityExcesses[BusiestLanesIndex];
-							if (BusiestLaneDensity < MinBusiestLaneDensityExcess)
-							{
-								MinBusiestLaneDensityExcess = BusiestLaneDensity;
-								MinBusiestLaneDensityExcessIndex = BusiestLanesIndex;
-							}
-						}
-					}
+					return BusiestLanes.Num() < MassTrafficSettings->NumBusiestLanesToTransferFrom;
+				});
+			}
+		}
+
+		// Note: We don't allow intersection lanes as target lanes to avoid the complexity of obeying intersection
+		//		logic.
+		int32 NumLeastBusiestLanesToConsider = MaxLanesPerSlice;
+		const int32 MaxLeastBusiestLaneBucket = FMassTrafficLaneDensityBuckets::GetFunctionalDensityBucket(MassTrafficSettings->LeastBusiestLaneMaxDensity);
+		for (int32 Bucket = 0; Bucket <= MaxLeastBusiestLaneBucket; ++Bucket)
+		{
+			for (int32 ZoneGraphOffset = 0; ZoneGraphOffset < NumZoneGraphs; ++ZoneGraphOffset)
+			{
+				if (LeastBusiestLanes.Num() >= MassTrafficSettings->NumLeastBusiestLanesToTransferTo)
+				{
+					break;
 				}
 
-				// Collect NumLeastBusiestLanesToTransferTo of the least busiest lanes
-				// Note: We don't allow intersection lanes as target lanes to avoid the complexity of obeying
-				//		intersection logic.
-				if (
-					// Is in range to player?
-					bIsInLeastBusiestLaneDistanceRange
-					// Enough space to bother trying to transfer here?
-					&& FunctionalLaneDensity <= MassTrafficSettings->LeastBusiestLaneMaxDensity
-					// Only transfer onto open lanes
-					&& TrafficLaneData.bIsOpen
-					// Never transfer onto intersection lanes
-					&& !TrafficLaneData.ConstData.bIsIntersectionLane
-					// In the trunk lanes phase, only consider trunk lanes to transfer onto, so we don't put
-					// trunk-lane-only vehicles onto non-trunk lanes
-					&& (!bTrunkLanesPhase || TrafficLaneData.ConstData.bIsTrunkLane)
-				)
+				FMassTrafficLaneDensityBuckets& DensityBuckets = TrafficZoneGraphDatas[(DensityBucketScanFirstZoneGraph + ZoneGraphOffset) % NumZoneGraphs]->DensityBuckets;
+				ScanDensityBucket(DensityBuckets.FunctionalDensityBuckets[Bucket], DensityBuckets.FunctionalDensityBucketScanStarts[Bucket], NumLeastBusiestLanesToConsider, [&](FZoneGraphTrafficLaneData& TrafficLaneData)
 				{
-					if (LeastBusiestLanes.Num() < MassTrafficSettings->NumLeastBusiestLanesToTransferTo)
+					if (
+						// Is in range to player and out of view?
+						!TrafficLaneData.bIsInViewerFrustum
+						&& MassTrafficSettings->LeastBusiestLaneDistanceToPlayerRange.Contains(TrafficLaneData.DistanceToNearestViewer)
+						// Enough space to bother trying to transfer here?
+						&& TrafficLaneData.FunctionalDensity() <= MassTrafficSettings->LeastBusiestLaneMaxDensity
+						// Only transfer onto open lanes
+						&& TrafficLaneData.bIsOpen
+						// Never transfer onto intersection lanes
+						&& !TrafficLaneData.ConstData.bIsIntersectionLane
+						// In the trunk lanes phase, only consider trunk lanes to transfer onto, so we don't put
+						// trunk-lane-only vehicles onto non-trunk lanes
+						&& (!bTrunkLanesPhase || TrafficLaneData.ConstData.bIsTrunkLane)
+						&& IsOKToTeleport(TrafficLaneData)
+					)
 					{
 						LeastBusiestLanes.Add(&TrafficLaneData);
-						LeastBusiestLaneDensities.Add(FunctionalLaneDensity);
 						LeastBusiestLaneLocations.Add(TrafficLaneData.CenterLocation);
-						if (FunctionalLaneDensity > MaxLeastBusiestLaneDensity)
-						{
-							MaxLeastBusiestLaneDensity = FunctionalLaneDensity;
-							MaxLeastBusiestLaneDensityIndex = LeastBusiestLanes.Num() - 1;
-						}
-					}
-					else if (FunctionalLaneDensity < MaxLeastBusiestLaneDensity)
-					{
-						// Write over the current max, effectively popping it out of the list
-						LeastBusiestLanes[MaxLeastBusiestLaneDensityIndex] = &TrafficLaneData;
-						LeastBusiestLaneDensities[MaxLeastBusiestLaneDensityIndex] = FunctionalLaneDensity;
-						LeastBusiestLaneLocations[MaxLeastBusiestLaneDensityIndex] = TrafficLaneData.CenterLocation;
-
-						// Find the new min
-						MaxLeastBusiestLaneDensity = TNumericLimits<float>::Min();
-						for (int32 LeastBusiestLanesIndex = 0; LeastBusiestLanesIndex < LeastBusiestLanes.Num(); ++LeastBusiestLanesIndex)
-						{
-							const float& LeastBusiestLaneDensity = LeastBusiestLaneDensities[LeastBusiestLanesIndex];
-							if (LeastBusiestLaneDensity > MaxLeastBusiestLaneDensity)
-							{
-								MaxLeastBusiestLaneDensity = LeastBusiestLaneDensity;
-								MaxLeastBusiestLaneDensityIndex = LeastBusiestLanesIndex;
-							}
-						}
 					}
-				}
+
+					return LeastBusiestLanes.Num() < MassTrafficSettings->NumLeastBusiestLanesToTransferTo;
+				});
 			}
 		}
 	}
@@ -458,11 +521,8 @@ void UMassTrafficOverseerProcessor::Execute(FMassEntityManager& EntityManager, F
 		}
 	}
 
-	// Advance frame index for next frame
-	PartitionIndex = (PartitionIndex + 1) % MassTrafficSettings->NumDensityManagementLanePartitions;
-
-	// If we've done a full loop of partitions, flip/flop to/from trunk lanes only phase
-	if (PartitionIndex == 0)
+	// If we've done a full pass over all lanes, flip/flop to/from trunk lanes only phase
+	if (bCompletedLanePass)
 	{
 		bTrunkLanesPhase = !bTrunkLanesPhase;
 	}
@@ -5,7 +5,9 @@
 #include "EngineUtils.h"
 #include "MassTrafficInitParkedVehiclesProcessor.h"
 #include "MassTrafficParkingSpotActor.h"
+#include "MassTrafficSpawnPoints.h"
 #include "MassTrafficSubsystem.h"
+#include "MassTrafficUtils.h"
 #include "Algo/Accumulate.h"
 
 void UMassTrafficParkedVehicleSpawnDataGenerator::Generate(
@@ -63,14 +65,26 @@ void UMassTrafficParkedVehicleSpawnDataGenerator::Generate(
 	}
 	
 	TMap<FName, TArray<FTransform>> ParkingSpotsMap;
-	for(TActorIterator<AMassTrafficParkingSpotActor> It(World); It; ++It)
+	const TArray<FMassTrafficBakedParkingSpaces>* BakedParkingSpacesList = BakedSpawnPoints ? BakedSpawnPoints->FindParkingSpaces(*World) : nullptr;
+	if (BakedParkingSpacesList)
 	{
-		FName ParkingSpaceType = It->GetParkingSpaceType();
-		if (!ParkingSpaceType.IsValid())
+		for (const FMassTrafficBakedParkingSpaces& BakedParkingSpaces : *BakedParkingSpacesList)
 		{
-			ParkingSpaceType = DefaultParkingSpaceType;
+			const FName ParkingSpaceType = BakedParkingSpaces.ParkingSpaceType.IsValid() ? BakedParkingSpaces.ParkingSpaceType : DefaultParkingSpaceType;
+			ParkingSpotsMap.FindOrAdd(ParkingSpaceType).Append(BakedParkingSpaces.Transforms);
+		}
+	}
+	else
+	{
+		for(TActorIterator<AMassTrafficParkingSpotActor> It(World); It; ++It)
+		{
+			FName ParkingSpaceType = It->GetParkingSpaceType();
+			if (!ParkingSpaceType.IsValid())
+			{
+				ParkingSpaceType = DefaultParkingSpaceType;
+			}
+			ParkingSpotsMap.FindOrAdd(ParkingSpaceType).Add(It->GetTransform());
 		}
-		ParkingSpotsMap.FindOrAdd(ParkingSpaceType).Add(It->GetTransform());
 	}
 	
 	// Track available parking spaces
@@ -124,9 +138,9 @@ void UMassTrafficParkedVehicleSpawnDataGenerator::Generate(
 	}
 	
 	// Get a list of obstacles to avoid when spawning
-	const float ObstacleRadiusSquared = FMath::Square(ObstacleExclusionRadius);
 	TArray<FVector> ObstacleLocationsToAvoid;
 	MassTrafficSubsystem->GetAllObstacleLocations(ObstacleLocationsToAvoid);
+	const UE::MassTraffic::FObstacleExclusionGrid ObstacleExclusionGrid(ObstacleLocationsToAvoid, ObstacleExclusionRadius);
 
 	// Prepare results
 	TArray<FMassEntitySpawnDataGeneratorResult> Results;
@@ -162,17 +176,7 @@ void UMassTrafficParkedVehicleSpawnDataGenerator::Generate(
 			{
 				const FVector ParkingSpacePosition = SpawnData.Transforms[ParkingSpaceIndex].GetLocation();
 
-				bool bOverlapsObstacle = false;
-				for(const FVector & ObstacleLocation : ObstacleLocationsToAvoid)
-				{
-					if (FVector::DistSquared(ParkingSpacePosition, ObstacleLocation) < ObstacleRadiusSquared)
-					{
-						bOverlapsObstacle = true;
-						break;
-					}
-				}
-
-				if (bOverlapsObstacle)
+				if (ObstacleExclusionGrid.IsExcluded(ParkingSpacePosition))
 				{
 					SpawnData.Transforms.RemoveAtSwap(ParkingSpaceIndex);
 				}
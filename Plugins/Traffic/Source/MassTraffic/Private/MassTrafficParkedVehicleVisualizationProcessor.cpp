@@ -71,11 +71,12 @@ void UMassTrafficParkedVehicleUpdateCustomVisualizationProcessor::Execute(FMassE
 	// 
 	// Otherwise the total mesh instance count (e.g: 7 traffic + 3 parked) would be mismatched with the
 	// total custom data count (e.g: 7 traffic + 0 parked)
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
+	//
+	// Instances are gathered on worker threads, then added to the representation subsystem here on the game thread.
+	// (See all PARALLELISMGATHER.)
+	UE::MassTraffic::ForEachVisualizationEntityChunk(EntityQuery, Context, [this](FMassExecutionContext& Context)
 		{
-			UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
-			check(RepresentationSubsystem);
-			FMassInstancedStaticMeshInfoArrayView ISMInfo = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+			TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData>::FChunkInstances ChunkInstances = InstanceGatherer.BeginChunk(Context);
 
 			TConstArrayView<FTransformFragment> TransformList = Context.GetFragmentView<FTransformFragment>();
 			TConstArrayView<FMassTrafficRandomFractionFragment> RandomFractionFragments = Context.GetFragmentView<FMassTrafficRandomFractionFragment>();
@@ -92,14 +93,17 @@ void UMassTrafficParkedVehicleUpdateCustomVisualizationProcessor::Execute(FMassE
 				{
 					const FMassTrafficPackedVehicleInstanceCustomData PackedCustomData = FMassTrafficVehicleInstanceCustomData::MakeParkedVehicleCustomData(RandomFractionFragment);
 					
-					ISMInfo[Visualization.StaticMeshDescHandle.ToIndex()].AddBatchedTransform(Context.GetEntity(EntityIt)
-						, TransformFragment.GetTransform(), Visualization.PrevTransform, VisualizationLODFragment.LODSignificance);
-					ISMInfo[Visualization.StaticMeshDescHandle.ToIndex()].AddBatchedCustomData(PackedCustomData, VisualizationLODFragment.LODSignificance);
+					ChunkInstances.Instances.Add({ Context.GetEntity(EntityIt), Visualization.StaticMeshDescHandle
+						, TransformFragment.GetTransform(), Visualization.PrevTransform, VisualizationLODFragment.LODSignificance, PackedCustomData });
 				}
 				Visualization.PrevTransform = TransformFragment.GetTransform();
 			}
+
+			InstanceGatherer.EndChunk(MoveTemp(ChunkInstances));
 		});
 
+	InstanceGatherer.AddBatchedInstances();
+
 #if ENABLE_VISUAL_LOG
 	
 	// Debug draw current visualization
@@ -3,6 +3,7 @@
 
 #include "MassTrafficPathFinder.h"
 
+#include "MassTraffic.h"
 #include "MassTrafficFragments.h"
 #include "MassTrafficInterpolation.h"
 #include "MassTrafficSubsystem.h"
@@ -22,6 +23,8 @@ FMassTrafficPathFinder::~FMassTrafficPathFinder()
 //------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool FMassTrafficPathFinder::Init(UMassTrafficSubsystem* InMassTrafficSubsystem, UZoneGraphSubsystem* InZoneGraphSubsystem, FZoneGraphTagFilter InZoneGraphTagFilter,float InLaneSearchRadius)
 {
+	LLM_SCOPE_BYTAG(MassTraffic_PathFinder);
+
 	MassTrafficSubsystem = InMassTrafficSubsystem;
 	ZoneGraphSubsystem = InZoneGraphSubsystem;
 	ZoneGraphTagFilter = InZoneGraphTagFilter;
@@ -52,6 +55,8 @@ bool FMassTrafficPathFinder::Init(UMassTrafficSubsystem* InMassTrafficSubsystem,
 //------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool FMassTrafficPathFinder::SearchPath(const FVector& Start, const FVector& End, FTrafficPath& TrafficPath)
 {
+	LLM_SCOPE_BYTAG(MassTraffic_PathFinder);
+
 	if (!FindNearestLane(Start, LaneSearchRadius, TrafficPath.Origin))
 		return false;
 	
@@ -219,3 +224,9 @@ float FMassTrafficPathFinder::CalculatePathLength(const FTrafficPath& TrafficPat
 	Length += TrafficPath.Destination.DistanceAlongLane;
 	return Length;
 }
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------
+SIZE_T FMassTrafficPathFinder::GetAllocatedSize() const
+{
+	return Lanes.GetAllocatedSize() + LaneNodes.GetAllocatedSize() + OpenList.GetAllocatedSize();
+}
@@ -9,12 +9,18 @@
 #include "Chaos/PBDJointConstraintUtilities.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Physics/Experimental/ChaosInterfaceUtils.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Misc/DataValidation.h"
+#include "UObject/ObjectSaveContext.h"
+#endif
 
 Chaos::FSimpleEngineConfig FMassTrafficSimpleVehiclePhysicsSim::DefaultEngineConfig;
-Chaos::FSimpleDifferentialConfig FMassTrafficSimpleVehiclePhysicsSim::DefaultDifferentialConfig;
 Chaos::FSimpleTransmissionConfig FMassTrafficSimpleVehiclePhysicsSim::DefaultTransmissionConfig;
-Chaos::FSimpleSteeringConfig FMassTrafficSimpleVehiclePhysicsSim::DefaultSteeringConfig;
-Chaos::FSimpleAerodynamicsConfig FMassTrafficSimpleVehiclePhysicsSim::DefaultAerodynamicsConfig;
 
 void UE::MassTraffic::ExtractPhysicsVehicleConfig(
 	// TSubclassOf<AWheeledVehiclePawn> PhysicsActorClass,
@@ -94,42 +100,26 @@ void UE::MassTraffic::ExtractPhysicsVehicleConfig(
 	OutVehicleSim.EngineSim = SimpleWheeledVehicle->Engine[0];
 	OutVehicleSim.EngineSim.SetupPtr = &OutVehicleConfig.EngineConfig;
 
-	OutVehicleConfig.DifferentialConfig = SimpleWheeledVehicle->Differential[0].Setup();
-	OutVehicleSim.DifferentialSim = SimpleWheeledVehicle->Differential[0];
-	OutVehicleSim.DifferentialSim.SetupPtr = &OutVehicleConfig.DifferentialConfig;
-
 	OutVehicleConfig.TransmissionConfig = SimpleWheeledVehicle->Transmission[0].Setup();
 	OutVehicleSim.TransmissionSim = SimpleWheeledVehicle->Transmission[0];
 	OutVehicleSim.TransmissionSim.SetupPtr = &OutVehicleConfig.TransmissionConfig;
 
+	// Differential, steering, aerodynamics & axles carry no per-vehicle state, so we only keep their config which is
+	// shared by all vehicles of this type
+	OutVehicleConfig.DifferentialConfig = SimpleWheeledVehicle->Differential[0].Setup();
 	OutVehicleConfig.SteeringConfig = SimpleWheeledVehicle->Steering[0].Setup();
-	OutVehicleSim.SteeringSim = SimpleWheeledVehicle->Steering[0];
-	OutVehicleSim.SteeringSim.SetupPtr = &OutVehicleConfig.SteeringConfig;
-
 	OutVehicleConfig.AerodynamicsConfig = SimpleWheeledVehicle->Aerodynamics[0].Setup();
-	OutVehicleSim.AerodynamicsSim = SimpleWheeledVehicle->Aerodynamics[0];
-	OutVehicleSim.AerodynamicsSim.SetupPtr = &OutVehicleConfig.AerodynamicsConfig;
 
-	// Pre-allocate all Configs up-front so we have stable address for all of the to set in the sims
-	OutVehicleConfig.AxleConfigs.SetNum(SimpleWheeledVehicle->Axles.Num());
-	OutVehicleConfig.WheelConfigs.SetNum(SimpleWheeledVehicle->Wheels.Num());
-	OutVehicleConfig.SuspensionConfigs.SetNum(SimpleWheeledVehicle->Suspension.Num());
-	
-	OutVehicleSim.AxleSims.Reset();
+	OutVehicleConfig.AxleConfigs.Reset();
 	for (int32 AxleIndex = 0; AxleIndex < SimpleWheeledVehicle->Axles.Num(); ++AxleIndex)
 	{
-		const Chaos::FAxleSim& AxleSim = SimpleWheeledVehicle->Axles[AxleIndex];
-
-		Chaos::FAxleConfig& OutAxleConfig = OutVehicleConfig.AxleConfigs[AxleIndex];
-		OutAxleConfig = AxleSim.Setup;
-
-		Chaos::FAxleSim& OutAxleSim = OutVehicleSim.AxleSims.AddDefaulted_GetRef();
-		OutAxleSim = AxleSim;
-
-		// For the simulation fragment to be trivially relocatable, we redirect the SetupPtr to our stable pointer
-		OutAxleSim.SetupPtr = &OutAxleConfig;
+		OutVehicleConfig.AxleConfigs.Add(SimpleWheeledVehicle->Axles[AxleIndex].Setup);
 	}
 
+	// Pre-allocate all Configs up-front so we have stable address for all of the to set in the sims
+	OutVehicleConfig.WheelConfigs.SetNum(SimpleWheeledVehicle->Wheels.Num());
+	OutVehicleConfig.SuspensionConfigs.SetNum(SimpleWheeledVehicle->Suspension.Num());
+
 	OutVehicleSim.WheelSims.Reset();
 	OutVehicleConfig.MaxSteeringAngle = 0.0f;
 	for (int32 WheelIndex = 0; WheelIndex < SimpleWheeledVehicle->Wheels.Num(); ++WheelIndex)
@@ -172,6 +162,543 @@ void UE::MassTraffic::ExtractPhysicsVehicleConfig(
 	}
 }
 
+bool UE::MassTraffic::SpawnAndExtractPhysicsVehicleConfig(
+	UWorld& World,
+	TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor,
+	FMassTrafficSimpleVehiclePhysicsConfig& OutVehicleConfig,
+	FMassTrafficSimpleVehiclePhysicsSim& OutVehicleSim
+)
+{
+	// Spawn a temp copy of the physics actor to mine properties off.
+	// Note: we do this instead of using the CDO for the actor, to get at the finalised FBodyInstance
+	// details.
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.bNoFail = true;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	AWheeledVehiclePawn* TempPhysicsActor = World.SpawnActor<AWheeledVehiclePawn>(PhysicsVehicleTemplateActor.Get(), SpawnParameters);
+	if (!TempPhysicsActor)
+	{
+		UE_LOG(LogMassTraffic, Error, TEXT("Couldn't spawn PhysicsActorClass (%s) to mine simple vehicle physics params from"), *GetNameSafe(PhysicsVehicleTemplateActor.Get()));
+		return false;
+	}
+
+	// Mine physics BP for physics config
+	ExtractPhysicsVehicleConfig(TempPhysicsActor, OutVehicleConfig, OutVehicleSim);
+
+	TempPhysicsActor->Destroy();
+
+	return true;
+}
+
+void UE::MassTraffic::InitPhysicsVehicleSim(
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfig,
+	TConstArrayView<FVector> WheelRestingPositions,
+	FMassTrafficSimpleVehiclePhysicsSim& OutVehicleSim
+)
+{
+	check(WheelRestingPositions.Num() == VehicleConfig.SuspensionConfigs.Num());
+
+	OutVehicleSim.SetupPtr = &VehicleConfig;
+	OutVehicleSim.EngineSim = Chaos::FSimpleEngineSim(&VehicleConfig.EngineConfig);
+	OutVehicleSim.TransmissionSim = Chaos::FSimpleTransmissionSim(&VehicleConfig.TransmissionConfig);
+
+	OutVehicleSim.WheelSims.Reset();
+	for (const Chaos::FSimpleWheelConfig& WheelConfig : VehicleConfig.WheelConfigs)
+	{
+		OutVehicleSim.WheelSims.Emplace(&WheelConfig);
+	}
+
+	OutVehicleSim.SuspensionSims.Reset();
+	OutVehicleSim.WheelLocalLocations.Reset();
+	for (int32 SuspensionIndex = 0; SuspensionIndex < VehicleConfig.SuspensionConfigs.Num(); ++SuspensionIndex)
+	{
+		// Resting positions are already in actor space. @see ExtractPhysicsVehicleConfig 
+		Chaos::FSimpleSuspensionSim& OutSuspensionSim = OutVehicleSim.SuspensionSims.Emplace_GetRef(&VehicleConfig.SuspensionConfigs[SuspensionIndex]);
+		OutSuspensionSim.SetLocalRestingPosition(WheelRestingPositions[SuspensionIndex]);
+
+		OutVehicleSim.WheelLocalLocations.Add(WheelRestingPositions[SuspensionIndex]);
+	}
+}
+
+namespace UE::MassTraffic::Private
+{
+	/**
+	 * Bump when changing what SerializeChaosVehicleConfigsInternal writes. The engine version is stored along side,
+	 * as configs with no indirect data are stored as raw bytes and their layout may change between engine versions.
+	 * 2: Chaos graphs are no longer stored re-sampled, but built again from the vehicle's setups.
+	 */
+	constexpr int32 ChaosVehicleConfigsVersion = 2;
+	constexpr int32 ChaosVehicleConfigsEngineVersion = ENGINE_MAJOR_VERSION * 100 + ENGINE_MINOR_VERSION;
+
+	/** Serializes the raw bytes of a Chaos config with no indirect data */
+	template<typename TConfig>
+	bool SerializeChaosConfig(FArchive& Ar, TConfig& Config)
+	{
+		static_assert(std::is_trivially_copyable_v<TConfig>, "Chaos configs with indirect data must be serialized field by field");
+
+		TArray<uint8> Bytes;
+		if (Ar.IsSaving())
+		{
+			Bytes.SetNumUninitialized(sizeof(TConfig));
+			FMemory::Memcpy(Bytes.GetData(), &Config, sizeof(TConfig));
+		}
+
+		Ar << Bytes;
+
+		if (Ar.IsLoading())
+		{
+			if (Bytes.Num() != sizeof(TConfig))
+			{
+				return false;
+			}
+			FMemory::Memcpy(&Config, Bytes.GetData(), sizeof(TConfig));
+		}
+
+		return true;
+	}
+
+	template<typename TEnum>
+	void SerializeEnumAsByte(FArchive& Ar, TEnum& Value)
+	{
+		uint8 Byte = static_cast<uint8>(Value);
+		Ar << Byte;
+		Value = static_cast<TEnum>(Byte);
+	}
+
+	// Chaos graphs are skipped. @see UMassTrafficVehiclePhysicsDataAsset::BuildChaosGraphs
+
+	bool SerializeChaosConfig(FArchive& Ar, Chaos::FSimpleEngineConfig& Config)
+	{
+		Ar << Config.MaxTorque;
+		Ar << Config.MaxRPM;
+		Ar << Config.EngineIdleRPM;
+		Ar << Config.EngineBrakeEffect;
+		Ar << Config.EngineRevUpMPS;
+		Ar << Config.EngineRevDownRate;
+		return true;
+	}
+
+	bool SerializeChaosConfig(FArchive& Ar, Chaos::FSimpleTransmissionConfig& Config)
+	{
+		Ar << Config.ForwardRatios;
+		Ar << Config.ReverseRatios;
+		Ar << Config.FinalDriveRatio;
+		Ar << Config.ChangeUpRPM;
+		Ar << Config.ChangeDownRPM;
+		Ar << Config.GearChangeTime;
+		Ar << Config.TransmissionEfficiency;
+		SerializeEnumAsByte(Ar, Config.TransmissionType);
+		Ar << Config.AutoReverse;
+		return true;
+	}
+
+	bool SerializeChaosConfig(FArchive& Ar, Chaos::FSimpleSteeringConfig& Config)
+	{
+		SerializeEnumAsByte(Ar, Config.SteeringType);
+		Ar << Config.AngleRatio;
+		Ar << Config.TrackWidth;
+		Ar << Config.WheelBase;
+		return true;
+	}
+
+	bool SerializeChaosConfig(FArchive& Ar, Chaos::FSimpleWheelConfig& Config)
+	{
+		Ar << Config.Offset;
+		Ar << Config.WheelMass;
+		Ar << Config.WheelRadius;
+		Ar << Config.WheelWidth;
+		Ar << Config.MaxSteeringAngle;
+		Ar << Config.MaxBrakeTorque;
+		Ar << Config.HandbrakeTorque;
+		Ar << Config.SteeringEnabled;
+		Ar << Config.HandbrakeEnabled;
+		SerializeEnumAsByte(Ar, Config.AxleType);
+		Ar << Config.EngineEnabled;
+		Ar << Config.ABSEnabled;
+		Ar << Config.TractionControlEnabled;
+		Ar << Config.FrictionMultiplier;
+		Ar << Config.CorneringStiffness;
+		Ar << Config.SideSlipModifier;
+		Ar << Config.SlipThreshold;
+		Ar << Config.SkidThreshold;
+		Ar << Config.MaxSpinRotation;
+		SerializeEnumAsByte(Ar, Config.ExternalTorqueCombineMethod);
+		return true;
+	}
+
+	bool SerializeChaosConfig(FArchive& Ar, Chaos::FAxleConfig& Config)
+	{
+		Ar << Config.WheelIndex;
+		Ar << Config.RollbarScaling;
+		return true;
+	}
+
+	template<typename TConfig, typename TAllocator>
+	bool SerializeChaosConfigs(FArchive& Ar, TArray<TConfig, TAllocator>& Configs, const int32 MaxConfigs)
+	{
+		int32 NumConfigs = Configs.Num();
+		Ar << NumConfigs;
+		if (Ar.IsLoading())
+		{
+			if (NumConfigs < 0 || NumConfigs > MaxConfigs)
+			{
+				Ar.SetError();
+				return false;
+			}
+			Configs.SetNum(NumConfigs);
+		}
+
+		bool bSuccess = true;
+		for (TConfig& Config : Configs)
+		{
+			bSuccess &= SerializeChaosConfig(Ar, Config);
+		}
+		return bSuccess;
+	}
+
+	bool SerializeChaosVehicleConfigsInternal(FArchive& Ar, FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfig)
+	{
+		bool bSuccess = true;
+		bSuccess &= SerializeChaosConfig(Ar, VehicleConfig.EngineConfig);
+		bSuccess &= SerializeChaosConfig(Ar, VehicleConfig.TransmissionConfig);
+		bSuccess &= SerializeChaosConfig(Ar, VehicleConfig.DifferentialConfig);
+		bSuccess &= SerializeChaosConfig(Ar, VehicleConfig.SteeringConfig);
+		bSuccess &= SerializeChaosConfig(Ar, VehicleConfig.AerodynamicsConfig);
+		bSuccess &= SerializeChaosConfigs(Ar, VehicleConfig.AxleConfigs, FMassTrafficSimpleVehiclePhysicsConfig::MaxAxles);
+		bSuccess &= SerializeChaosConfigs(Ar, VehicleConfig.WheelConfigs, FMassTrafficSimpleVehiclePhysicsConfig::MaxWheels);
+		bSuccess &= SerializeChaosConfigs(Ar, VehicleConfig.SuspensionConfigs, FMassTrafficSimpleVehiclePhysicsConfig::MaxWheels);
+		return bSuccess && !Ar.IsError();
+	}
+
+	/** @return Config serialized by SerializeChaosConfig, to compare configs by */
+	template<typename TConfig>
+	TArray<uint8> GetChaosConfigBytes(TConfig Config)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		SerializeChaosConfig(Writer, Config);
+		return Bytes;
+	}
+
+	/** @return true if the graphs evaluated by EvaluateA & EvaluateB match across [0, MaxX] */
+	bool AreChaosGraphsEqual(TFunctionRef<float(float)> EvaluateA, TFunctionRef<float(float)> EvaluateB, const float MaxX)
+	{
+		constexpr int32 NumComparisonSamples = 256;
+		for (int32 SampleIndex = 0; SampleIndex < NumComparisonSamples; ++SampleIndex)
+		{
+			const float X = MaxX * SampleIndex / (NumComparisonSamples - 1);
+			if (!FMath::IsNearlyEqual(EvaluateA(X), EvaluateB(X), UE_KINDA_SMALL_NUMBER))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+bool UE::MassTraffic::DiffPhysicsVehicleConfigs(
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfigA,
+	const FMassTrafficSimpleVehiclePhysicsSim& VehicleSimA,
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfigB,
+	const FMassTrafficSimpleVehiclePhysicsSim& VehicleSimB,
+	TArray<FString>& OutConfigDifferences,
+	TArray<FString>& OutSimDifferences
+)
+{
+	using namespace UE::MassTraffic::Private;
+
+	// Reflected values
+	for (TFieldIterator<FProperty> PropertyIt(FMassTrafficSimpleVehiclePhysicsConfig::StaticStruct()); PropertyIt; ++PropertyIt)
+	{
+		if (!PropertyIt->Identical_InContainer(&VehicleConfigA, &VehicleConfigB))
+		{
+			OutConfigDifferences.Add(PropertyIt->GetName());
+		}
+	}
+
+	// Chaos configs, other than their graphs
+	auto DiffChaosConfig = [&OutConfigDifferences](const FString& Name, const auto& ConfigA, const auto& ConfigB)
+	{
+		if (GetChaosConfigBytes(ConfigA) != GetChaosConfigBytes(ConfigB))
+		{
+			OutConfigDifferences.Add(Name);
+		}
+	};
+	DiffChaosConfig(TEXT("EngineConfig"), VehicleConfigA.EngineConfig, VehicleConfigB.EngineConfig);
+	DiffChaosConfig(TEXT("TransmissionConfig"), VehicleConfigA.TransmissionConfig, VehicleConfigB.TransmissionConfig);
+	DiffChaosConfig(TEXT("DifferentialConfig"), VehicleConfigA.DifferentialConfig, VehicleConfigB.DifferentialConfig);
+	DiffChaosConfig(TEXT("SteeringConfig"), VehicleConfigA.SteeringConfig, VehicleConfigB.SteeringConfig);
+	DiffChaosConfig(TEXT("AerodynamicsConfig"), VehicleConfigA.AerodynamicsConfig, VehicleConfigB.AerodynamicsConfig);
+
+	if (VehicleConfigA.AxleConfigs.Num() != VehicleConfigB.AxleConfigs.Num()
+		|| VehicleConfigA.WheelConfigs.Num() != VehicleConfigB.WheelConfigs.Num()
+		|| VehicleConfigA.SuspensionConfigs.Num() != VehicleConfigB.SuspensionConfigs.Num())
+	{
+		OutConfigDifferences.Add(TEXT("Number of axles, wheels or suspensions"));
+	}
+	else
+	{
+		for (int32 AxleIndex = 0; AxleIndex < VehicleConfigA.AxleConfigs.Num(); ++AxleIndex)
+		{
+			DiffChaosConfig(FString::Printf(TEXT("AxleConfigs[%d]"), AxleIndex), VehicleConfigA.AxleConfigs[AxleIndex], VehicleConfigB.AxleConfigs[AxleIndex]);
+		}
+		for (int32 WheelIndex = 0; WheelIndex < VehicleConfigA.WheelConfigs.Num(); ++WheelIndex)
+		{
+			const Chaos::FSimpleWheelConfig& WheelConfigA = VehicleConfigA.WheelConfigs[WheelIndex];
+			const Chaos::FSimpleWheelConfig& WheelConfigB = VehicleConfigB.WheelConfigs[WheelIndex];
+			DiffChaosConfig(FString::Printf(TEXT("WheelConfigs[%d]"), WheelIndex), WheelConfigA, WheelConfigB);
+
+			// Lateral slip is evaluated by slip angle in degrees
+			if (!AreChaosGraphsEqual([&WheelConfigA](float X) { return WheelConfigA.LateralSlipGraph.EvaluateY(X); }, [&WheelConfigB](float X) { return WheelConfigB.LateralSlipGraph.EvaluateY(X); }, /*MaxX*/90.0f))
+			{
+				OutConfigDifferences.Add(FString::Printf(TEXT("WheelConfigs[%d].LateralSlipGraph"), WheelIndex));
+			}
+		}
+		for (int32 SuspensionIndex = 0; SuspensionIndex < VehicleConfigA.SuspensionConfigs.Num(); ++SuspensionIndex)
+		{
+			DiffChaosConfig(FString::Printf(TEXT("SuspensionConfigs[%d]"), SuspensionIndex), VehicleConfigA.SuspensionConfigs[SuspensionIndex], VehicleConfigB.SuspensionConfigs[SuspensionIndex]);
+		}
+	}
+
+	// Chaos graphs, compared by value as they don't expose their points
+	if (!AreChaosGraphsEqual([&VehicleConfigA](float X) { return VehicleConfigA.EngineConfig.TorqueCurve.GetValue(X); }, [&VehicleConfigB](float X) { return VehicleConfigB.EngineConfig.TorqueCurve.GetValue(X); }, /*MaxX*/1.0f))
+	{
+		OutConfigDifferences.Add(TEXT("EngineConfig.TorqueCurve"));
+	}
+	if (!AreChaosGraphsEqual([&VehicleConfigA](float X) { return VehicleConfigA.SteeringConfig.SpeedVsSteeringCurve.GetValue(X); }, [&VehicleConfigB](float X) { return VehicleConfigB.SteeringConfig.SpeedVsSteeringCurve.GetValue(X); }, /*MaxX*/1.0f))
+	{
+		OutConfigDifferences.Add(TEXT("SteeringConfig.SpeedVsSteeringCurve"));
+	}
+
+	// Sims
+	if (VehicleSimA.SuspensionSims.Num() != VehicleSimB.SuspensionSims.Num() || VehicleSimA.WheelLocalLocations.Num() != VehicleSimB.WheelLocalLocations.Num())
+	{
+		OutSimDifferences.Add(TEXT("Number of suspension sims or wheel locations"));
+	}
+	else
+	{
+		for (int32 SuspensionIndex = 0; SuspensionIndex < VehicleSimA.SuspensionSims.Num(); ++SuspensionIndex)
+		{
+			if (!VehicleSimA.SuspensionSims[SuspensionIndex].GetLocalRestingPosition().Equals(VehicleSimB.SuspensionSims[SuspensionIndex].GetLocalRestingPosition(), UE_KINDA_SMALL_NUMBER)
+				|| !VehicleSimA.WheelLocalLocations[SuspensionIndex].Equals(VehicleSimB.WheelLocalLocations[SuspensionIndex], UE_KINDA_SMALL_NUMBER))
+			{
+				OutSimDifferences.Add(FString::Printf(TEXT("SuspensionSims[%d] resting position"), SuspensionIndex));
+			}
+		}
+	}
+	if (!FMath::IsNearlyEqual(VehicleSimA.EngineSim.GetEngineRPM(), VehicleSimB.EngineSim.GetEngineRPM(), 1.0f))
+	{
+		OutSimDifferences.Add(TEXT("EngineSim RPM"));
+	}
+	if (VehicleSimA.TransmissionSim.GetCurrentGear() != VehicleSimB.TransmissionSim.GetCurrentGear())
+	{
+		OutSimDifferences.Add(TEXT("TransmissionSim gear"));
+	}
+
+	return OutConfigDifferences.IsEmpty() && OutSimDifferences.IsEmpty();
+}
+
+bool UE::MassTraffic::SerializeChaosVehicleConfigs(FArchive& Ar, FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfig)
+{
+	using namespace UE::MassTraffic::Private;
+
+	// The configs are stored as a versioned, size prefixed blob so that stale data can be skipped over as a whole on
+	// load, leaving the rest of Ar intact
+	int32 Version = ChaosVehicleConfigsVersion;
+	int32 EngineVersion = ChaosVehicleConfigsEngineVersion;
+	Ar << Version;
+	Ar << EngineVersion;
+
+	TArray<uint8> Bytes;
+	if (Ar.IsSaving())
+	{
+		FMemoryWriter Writer(Bytes);
+		SerializeChaosVehicleConfigsInternal(Writer, VehicleConfig);
+	}
+
+	Ar << Bytes;
+
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || Version != ChaosVehicleConfigsVersion || EngineVersion != ChaosVehicleConfigsEngineVersion)
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(Bytes);
+		return SerializeChaosVehicleConfigsInternal(Reader, VehicleConfig) && Reader.AtEnd();
+	}
+
+	return !Ar.IsError();
+}
+
+bool UMassTrafficVehiclePhysicsDataAsset::HasExtractedPhysicsVehicleConfig(TSubclassOf<AWheeledVehiclePawn> InPhysicsVehicleTemplateActor) const
+{
+	return bChaosConfigsValid
+		&& ExtractedPhysicsVehicleTemplateActor == InPhysicsVehicleTemplateActor
+		&& WheelRestingPositions.Num() == SimpleVehiclePhysicsConfig.SuspensionConfigs.Num()
+		&& WheelClasses.Num() == SimpleVehiclePhysicsConfig.WheelConfigs.Num();
+}
+
+void UMassTrafficVehiclePhysicsDataAsset::BuildChaosGraphs(FMassTrafficSimpleVehiclePhysicsConfig& InOutVehicleConfig) const
+{
+	// Build through the same setup calls UChaosWheeledVehicleMovementComponent::SetupVehicle uses, so the graphs come
+	// out exactly as they do for the actor. Only the graphs are taken, the rest of each config was extracted as is.
+	FVehicleEngineConfig EngineSetupCopy = EngineSetup;
+	InOutVehicleConfig.EngineConfig.TorqueCurve = EngineSetupCopy.GetPhysicsEngineConfig().TorqueCurve;
+
+	FVehicleSteeringConfig SteeringSetupCopy = SteeringSetup;
+	InOutVehicleConfig.SteeringConfig.SpeedVsSteeringCurve = SteeringSetupCopy.GetPhysicsSteeringConfig(FVector2D::ZeroVector).SpeedVsSteeringCurve;
+
+	for (int32 WheelIndex = 0; WheelIndex < WheelClasses.Num() && WheelIndex < InOutVehicleConfig.WheelConfigs.Num(); ++WheelIndex)
+	{
+		if (UChaosVehicleWheel* WheelCDO = WheelClasses[WheelIndex] ? WheelClasses[WheelIndex]->GetDefaultObject<UChaosVehicleWheel>() : nullptr)
+		{
+			InOutVehicleConfig.WheelConfigs[WheelIndex].LateralSlipGraph = WheelCDO->GetPhysicsWheelConfig().LateralSlipGraph;
+		}
+	}
+}
+
+void UMassTrafficVehiclePhysicsDataAsset::InitPhysicsVehicleTemplate(FMassTrafficSimpleVehiclePhysicsTemplate& OutTemplate) const
+{
+	check(HasExtractedPhysicsVehicleConfig(ExtractedPhysicsVehicleTemplateActor));
+
+	OutTemplate.PhysicsVehicleTemplateActor = ExtractedPhysicsVehicleTemplateActor;
+	OutTemplate.SimpleVehiclePhysicsConfig = SimpleVehiclePhysicsConfig;
+	BuildChaosGraphs(OutTemplate.SimpleVehiclePhysicsConfig);
+	UE::MassTraffic::InitPhysicsVehicleSim(OutTemplate.SimpleVehiclePhysicsConfig, WheelRestingPositions, OutTemplate.SimpleVehiclePhysicsFragmentTemplate.VehicleSim);
+}
+
+#if WITH_EDITOR
+void UMassTrafficVehiclePhysicsDataAsset::ExtractPhysicsVehicleConfig()
+{
+	Modify();
+	ExtractPhysicsVehicleConfigInternal();
+}
+
+bool UMassTrafficVehiclePhysicsDataAsset::ExtractPhysicsVehicleConfigInternal()
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!ensure(World) || !PhysicsVehicleTemplateActor)
+	{
+		return false;
+	}
+
+	const AWheeledVehiclePawn* PhysicsVehicleCDO = PhysicsVehicleTemplateActor->GetDefaultObject<AWheeledVehiclePawn>();
+	const UChaosWheeledVehicleMovementComponent* VehicleMovementComponent = PhysicsVehicleCDO ? Cast<UChaosWheeledVehicleMovementComponent>(PhysicsVehicleCDO->GetVehicleMovementComponent()) : nullptr;
+	if (!VehicleMovementComponent)
+	{
+		UE_LOG(LogMassTraffic, Error, TEXT("%s has no UChaosWheeledVehicleMovementComponent to extract a physics config from"), *GetNameSafe(PhysicsVehicleTemplateActor.Get()));
+		return false;
+	}
+
+	// Extract into a temporary sim, as we only keep the config & resting positions to re-create the sim from
+	FMassTrafficSimpleVehiclePhysicsSim VehicleSim;
+	if (!UE::MassTraffic::SpawnAndExtractPhysicsVehicleConfig(*World, PhysicsVehicleTemplateActor, SimpleVehiclePhysicsConfig, VehicleSim))
+	{
+		return false;
+	}
+
+	ExtractedPhysicsVehicleTemplateActor = PhysicsVehicleTemplateActor;
+	WheelRestingPositions = VehicleSim.WheelLocalLocations;
+	bChaosConfigsValid = true;
+
+	// Keep what the Chaos graphs are built from. Wheel sims are created in WheelSetups order.
+	EngineSetup = VehicleMovementComponent->EngineSetup;
+	SteeringSetup = VehicleMovementComponent->SteeringSetup;
+	WheelClasses.Reset();
+	for (const FChaosWheelSetup& WheelSetup : VehicleMovementComponent->WheelSetups)
+	{
+		WheelClasses.Add(WheelSetup.WheelClass);
+	}
+
+	return true;
+}
+
+void UMassTrafficVehiclePhysicsDataAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// However long ago this was last extracted, cooked data must match the PhysicsVehicleTemplateActor cooked with it
+	if (ObjectSaveContext.IsCooking() && PhysicsVehicleTemplateActor)
+	{
+		if (!ExtractPhysicsVehicleConfigInternal())
+		{
+			UE_LOG(LogMassTraffic, Warning, TEXT("Couldn't extract physics config from %s while cooking %s. Cooking the last extracted config."), *GetNameSafe(PhysicsVehicleTemplateActor.Get()), *GetName());
+		}
+	}
+}
+
+EDataValidationResult UMassTrafficVehiclePhysicsDataAsset::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+	if (!PhysicsVehicleTemplateActor)
+	{
+		return Result;
+	}
+
+	if (!HasExtractedPhysicsVehicleConfig(PhysicsVehicleTemplateActor))
+	{
+		Context.AddError(FText::FromString(FString::Printf(TEXT("%s has no up to date physics config extracted from %s. Run ExtractPhysicsVehicleConfig."), *GetName(), *GetNameSafe(PhysicsVehicleTemplateActor.Get()))));
+		return EDataValidationResult::Invalid;
+	}
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return Result;
+	}
+
+	// Extract from the actor as the runtime fallback would, and compare to what we'd build
+	FMassTrafficSimpleVehiclePhysicsConfig ExtractedVehicleConfig;
+	FMassTrafficSimpleVehiclePhysicsSim ExtractedVehicleSim;
+	if (!UE::MassTraffic::SpawnAndExtractPhysicsVehicleConfig(*World, PhysicsVehicleTemplateActor, ExtractedVehicleConfig, ExtractedVehicleSim))
+	{
+		Context.AddWarning(FText::FromString(FString::Printf(TEXT("Couldn't spawn %s to validate %s against"), *GetNameSafe(PhysicsVehicleTemplateActor.Get()), *GetName())));
+		return Result;
+	}
+
+	FMassTrafficSimpleVehiclePhysicsTemplate VehiclePhysicsTemplate;
+	InitPhysicsVehicleTemplate(VehiclePhysicsTemplate);
+
+	TArray<FString> ConfigDifferences;
+	TArray<FString> SimDifferences;
+	UE::MassTraffic::DiffPhysicsVehicleConfigs(VehiclePhysicsTemplate.SimpleVehiclePhysicsConfig, VehiclePhysicsTemplate.SimpleVehiclePhysicsFragmentTemplate.VehicleSim, ExtractedVehicleConfig, ExtractedVehicleSim, ConfigDifferences, SimDifferences);
+
+	if (!ConfigDifferences.IsEmpty())
+	{
+		Context.AddError(FText::FromString(FString::Printf(TEXT("%s is stale, %s no longer matches %s. Run ExtractPhysicsVehicleConfig."), *GetName(), *FString::Join(ConfigDifferences, TEXT(", ")), *GetNameSafe(PhysicsVehicleTemplateActor.Get()))));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	if (!SimDifferences.IsEmpty())
+	{
+		Context.AddWarning(FText::FromString(FString::Printf(TEXT("%s initial sim state differs from runtime extraction from %s: %s"), *GetName(), *GetNameSafe(PhysicsVehicleTemplateActor.Get()), *FString::Join(SimDifferences, TEXT(", ")))));
+	}
+
+	return Result;
+}
+#endif
+
+void UMassTrafficVehiclePhysicsDataAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading() || Ar.IsSaving())
+	{
+		const bool bLoaded = UE::MassTraffic::SerializeChaosVehicleConfigs(Ar, SimpleVehiclePhysicsConfig);
+		if (Ar.IsLoading())
+		{
+			bChaosConfigsValid = bLoaded;
+			if (!bChaosConfigsValid && ExtractedPhysicsVehicleTemplateActor)
+			{
+				UE_LOG(LogMassTraffic, Warning, TEXT("Couldn't load extracted physics config in %s. Vehicles will fall back to runtime extraction until ExtractPhysicsVehicleConfig is run again."), *GetName());
+			}
+		}
+	}
+}
+
 void FMassTrafficSimpleTrailerConstraintSolver::Init(
 	const float Dt,
 	const Chaos::FPBDJointSolverSettings& SolverSettings,
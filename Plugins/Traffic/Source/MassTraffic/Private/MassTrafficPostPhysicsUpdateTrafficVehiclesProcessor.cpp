@@ -30,6 +30,7 @@ void UMassTrafficPostPhysicsUpdateTrafficVehiclesProcessor::ConfigureQueries(con
 {
 	PIDControlTrafficVehicleQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::All);
 	PIDControlTrafficVehicleQuery.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::All);
+	PIDControlTrafficVehicleQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	PIDControlTrafficVehicleQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
 	PIDControlTrafficVehicleQuery.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	PIDControlTrafficVehicleQuery.AddRequirement<FMassActorFragment>(EMassFragmentAccess::ReadWrite);
@@ -69,9 +70,16 @@ void UMassTrafficPostPhysicsUpdateTrafficVehiclesProcessor::Execute(FMassEntityM
 		const TArrayView<FMassTrafficAngularVelocityFragment> AngularVelocityFragments = Context.GetMutableFragmentView<FMassTrafficAngularVelocityFragment>();
 		const TArrayView<FMassRepresentationFragment> RepresentationFragments = Context.GetMutableFragmentView<FMassRepresentationFragment>();
 		const TArrayView<FMassVelocityFragment> VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
 
 		for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 		{
+			// Skip vehicles keeping inactive PID control fragments below Medium LOD. (See all ARCHETYPESTABLELOD.)
+			if (bArchetypeStableSimulationLOD && !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+			{
+				continue;
+			}
+
 			FMassTrafficVehicleControlFragment& VehicleControlFragment = VehicleControlFragments[EntityIt];
 			FMassTrafficVehicleLightsFragment& VehicleLightsFragment = VehicleLightsFragments[EntityIt];
 			FMassZoneGraphLaneLocationFragment& LaneLocationFragment = LaneLocationFragments[EntityIt];
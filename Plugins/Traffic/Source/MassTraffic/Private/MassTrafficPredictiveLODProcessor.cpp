@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassTrafficPredictiveLODProcessor.h"
+#include "MassTraffic.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "MassLODFragments.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Look Ahead Viewers"), STAT_Traffic_LookAheadViewers, STATGROUP_Traffic);
+
+UMassTrafficPredictiveLODProcessor::UMassTrafficPredictiveLODProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::AllNetModes;
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::VehicleLODCollector);
+	ExecutionOrder.ExecuteBefore.Add(UE::MassTraffic::ProcessorGroupNames::VehicleSimulationLOD);
+	ExecutionOrder.ExecuteBefore.Add(UE::MassTraffic::ProcessorGroupNames::VehicleVisualizationLOD);
+}
+
+void UMassTrafficPredictiveLODProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::All);
+	EntityQuery.AddTagRequirement<FMassTrafficPlayerVehicleTag>(EMassFragmentPresence::None);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassViewerInfoFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassTrafficPredictiveLODFragment>(EMassFragmentAccess::ReadWrite);
+
+	ProcessorRequirements.AddSubsystemRequirement<UMassLODSubsystem>(EMassFragmentAccess::ReadOnly);
+}
+
+void UMassTrafficPredictiveLODProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	// Track viewer velocities from frame to frame, to find where each moving viewer is heading
+	const TArray<FViewerInfo>& Viewers = Context.GetSubsystemChecked<UMassLODSubsystem>().GetViewers();
+	const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+	ViewerLookAheads.SetNum(Viewers.Num());
+
+	struct FLookAhead
+	{
+		FVector Location;
+		FVector Offset;
+		const FConvexVolume* Frustum;
+	};
+	TArray<FLookAhead, TInlineAllocator<8>> LookAheads;
+	for (int32 ViewerIndex = 0; ViewerIndex < Viewers.Num(); ++ViewerIndex)
+	{
+		const FViewerInfo& Viewer = Viewers[ViewerIndex];
+		FViewerLookAhead& ViewerLookAhead = ViewerLookAheads[ViewerIndex];
+		if (!Viewer.Handle.IsValid() || !(ViewerLookAhead.Handle == Viewer.Handle))
+		{
+			// New viewer, or a new viewer reusing a removed viewer's slot. Start tracking from here.
+			ViewerLookAhead.Handle = Viewer.Handle;
+			ViewerLookAhead.PreviousLocation = Viewer.Location;
+			ViewerLookAhead.bIsLookingAhead = false;
+			continue;
+		}
+
+		const FVector Velocity = DeltaTime > 0.0f ? (Viewer.Location - ViewerLookAhead.PreviousLocation) / DeltaTime : FVector::ZeroVector;
+		const float Speed = Velocity.Size();
+		ViewerLookAhead.PreviousLocation = Viewer.Location;
+		ViewerLookAhead.bIsLookingAhead = LookAheadTime > 0.0f && Speed >= MinLookAheadViewerSpeed && Speed <= MaxLookAheadViewerSpeed;
+		if (ViewerLookAhead.bIsLookingAhead)
+		{
+			const float LookAheadDistance = FMath::Min(Speed * LookAheadTime, MaxLookAheadDistance);
+			ViewerLookAhead.LookAheadLocation = Viewer.Location + Velocity / Speed * LookAheadDistance;
+			LookAheads.Add({ ViewerLookAhead.LookAheadLocation, ViewerLookAhead.LookAheadLocation - Viewer.Location, Viewer.Frustum.Planes.IsEmpty() ? nullptr : &Viewer.Frustum });
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_Traffic_LookAheadViewers, LookAheads.Num());
+
+	// Even with no viewers looking ahead, last frame's look ahead still needs undoing
+	if (LookAheads.IsEmpty() && !bHadLookAheads)
+	{
+		return;
+	}
+	bHadLookAheads = !LookAheads.IsEmpty();
+
+	// Vehicles are only ever pulled closer, so vehicles behind moving viewers keep their current distance and are
+	// demoted as usual
+	EntityQuery.ForEachEntityChunk(Context, [&LookAheads](FMassExecutionContext& QueryContext)
+	{
+		const TConstArrayView<FTransformFragment> TransformFragments = QueryContext.GetFragmentView<FTransformFragment>();
+		const TArrayView<FMassViewerInfoFragment> ViewerInfoFragments = QueryContext.GetMutableFragmentView<FMassViewerInfoFragment>();
+		const TArrayView<FMassTrafficPredictiveLODFragment> PredictiveLODFragments = QueryContext.GetMutableFragmentView<FMassTrafficPredictiveLODFragment>();
+
+		for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
+		{
+			FMassViewerInfoFragment& ViewerInfoFragment = ViewerInfoFragments[EntityIt];
+			FMassTrafficPredictiveLODFragment& PredictiveLODFragment = PredictiveLODFragments[EntityIt];
+
+			// The LOD collector only refreshes some chunks each frame. If it hasn't refreshed this vehicle since last
+			// frame's look ahead, start from its last calculated distances again, so vehicles aren't held promoted once
+			// viewers move on.
+			if (PredictiveLODFragment.bHasLookAhead
+				&& ViewerInfoFragment.ClosestViewerDistanceSq == PredictiveLODFragment.LookAheadClosestViewerDistanceSq
+				&& ViewerInfoFragment.ClosestDistanceToFrustum == PredictiveLODFragment.LookAheadClosestDistanceToFrustum)
+			{
+				ViewerInfoFragment.ClosestViewerDistanceSq = PredictiveLODFragment.CollectedClosestViewerDistanceSq;
+				ViewerInfoFragment.ClosestDistanceToFrustum = PredictiveLODFragment.CollectedClosestDistanceToFrustum;
+			}
+			else
+			{
+				PredictiveLODFragment.CollectedClosestViewerDistanceSq = ViewerInfoFragment.ClosestViewerDistanceSq;
+				PredictiveLODFragment.CollectedClosestDistanceToFrustum = ViewerInfoFragment.ClosestDistanceToFrustum;
+			}
+
+			PredictiveLODFragment.bHasLookAhead = !LookAheads.IsEmpty();
+			if (!PredictiveLODFragment.bHasLookAhead)
+			{
+				continue;
+			}
+
+			// Measure from each look ahead location, and from each viewer's frustum moved along with it
+			const FVector Location = TransformFragments[EntityIt].GetTransform().GetLocation();
+			for (const FLookAhead& LookAhead : LookAheads)
+			{
+				ViewerInfoFragment.ClosestViewerDistanceSq = FMath::Min(ViewerInfoFragment.ClosestViewerDistanceSq, static_cast<float>(FVector::DistSquared(Location, LookAhead.Location)));
+				if (LookAhead.Frustum)
+				{
+					ViewerInfoFragment.ClosestDistanceToFrustum = FMath::Min(ViewerInfoFragment.ClosestDistanceToFrustum, static_cast<float>(LookAhead.Frustum->DistanceTo(Location - LookAhead.Offset)));
+				}
+			}
+			PredictiveLODFragment.LookAheadClosestViewerDistanceSq = ViewerInfoFragment.ClosestViewerDistanceSq;
+			PredictiveLODFragment.LookAheadClosestDistanceToFrustum = ViewerInfoFragment.ClosestDistanceToFrustum;
+		}
+	});
+}
@@ -2,6 +2,80 @@
 
 #include "MassTrafficProcessorBase.h"
 #include "MassCommonUtils.h"
+#include "MassTraffic.h"
+
+// Stats
+DECLARE_DWORD_COUNTER_STAT(TEXT("Time Sliced Items Processed"), STAT_Traffic_TimeSlicedItemsProcessed, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Time Sliced Items Backlog"), STAT_Traffic_TimeSlicedItemsBacklog, STATGROUP_Traffic);
+
+FMassTrafficTimeSlice::FMassTrafficTimeSlice(FMassTrafficTimeSliceCursor& InCursor, const float InBudgetMicroseconds, const int32 InMaxItems, const int32 InNumItems)
+	: Cursor(InCursor)
+	, MaxItems(FMath::Max(InMaxItems, 1))
+	, NumItems(InNumItems)
+{
+	EndCycles = InBudgetMicroseconds > 0.0f
+		? FPlatformTime::Cycles64() + static_cast<uint64>(InBudgetMicroseconds * 1e-6 / FPlatformTime::GetSecondsPerCycle64())
+		: TNumericLimits<uint64>::Max();
+}
+
+FMassTrafficTimeSlice::~FMassTrafficTimeSlice()
+{
+	Finish();
+}
+
+bool FMassTrafficTimeSlice::ShouldProcessItem(const int32 ItemIndex)
+{
+	NumItemsOffered = FMath::Max(NumItemsOffered, ItemIndex + 1);
+
+	// Already processed earlier in this pass?
+	if (ItemIndex < Cursor.NextItemIndex)
+	{
+		return false;
+	}
+
+	if (bBudgetSpent)
+	{
+		return false;
+	}
+
+	// Always process at least one item per slice so passes are guaranteed to progress
+	if (NumItemsProcessed > 0 && (NumItemsProcessed >= MaxItems || FPlatformTime::Cycles64() >= EndCycles))
+	{
+		bBudgetSpent = true;
+		return false;
+	}
+
+	++NumItemsProcessed;
+	LastProcessedItemIndex = ItemIndex;
+	return true;
+}
+
+bool FMassTrafficTimeSlice::Finish()
+{
+	if (bFinished)
+	{
+		return bCompletedPass;
+	}
+	bFinished = true;
+
+	const int32 NumItemsInPass = NumItems != INDEX_NONE ? NumItems : NumItemsOffered;
+	if (bBudgetSpent)
+	{
+		// Resume after the last processed item next frame
+		Cursor.NextItemIndex = LastProcessedItemIndex + 1;
+		INC_DWORD_STAT_BY(STAT_Traffic_TimeSlicedItemsBacklog, FMath::Max(NumItemsInPass - Cursor.NextItemIndex, 0));
+	}
+	else
+	{
+		// Every remaining item was processed (or the item count shrunk below the cursor) so start a new pass
+		Cursor.NextItemIndex = 0;
+		++Cursor.NumCompletedPasses;
+		bCompletedPass = true;
+	}
+	INC_DWORD_STAT_BY(STAT_Traffic_TimeSlicedItemsProcessed, NumItemsProcessed);
+
+	return bCompletedPass;
+}
 
 
 void UMassTrafficProcessorBase::InitializeInternal(UObject& InOwner, const TSharedRef<FMassEntityManager>& EntityManager)
@@ -10,6 +84,7 @@ void UMassTrafficProcessorBase::InitializeInternal(UObject& InOwner, const TShar
 
 	// Get settings
 	MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+	bArchetypeStableSimulationLOD = MassTrafficSettings->bArchetypeStableSimulationLOD;
 
 	LogOwner = UWorld::GetSubsystem<UMassTrafficSubsystem>(InOwner.GetWorld());
 
@@ -24,3 +99,47 @@ void UMassTrafficProcessorBase::InitializeInternal(UObject& InOwner, const TShar
 		RandomStream.GenerateNewSeed();
 	}
 }
+
+float UMassTrafficProcessorBase::GetTimeSliceBudgetMicroseconds() const
+{
+	return GMassTrafficTimeSlicing > 0 ? TimeSliceBudgetMicroseconds : 0.0f;
+}
+
+FMassTrafficTimeSlice UMassTrafficProcessorBase::MakeTimeSlice(FMassTrafficTimeSliceCursor& Cursor, const int32 NumItems, const int32 MaxItems) const
+{
+	return FMassTrafficTimeSlice(Cursor, GetTimeSliceBudgetMicroseconds(), MaxItems, NumItems);
+}
+
+int32 UMassTrafficProcessorBase::GetMaxTimeSlicedEntityBuckets(const FMassTrafficTimeSliceCursor& Cursor) const
+{
+	const float BudgetMicroseconds = GetTimeSliceBudgetMicroseconds();
+	if (BudgetMicroseconds <= 0.0f)
+	{
+		return FMassTrafficEntityBucketRange::NumBuckets;
+	}
+
+	// Start a budgeted pass one bucket at a time until the cost of a bucket has been measured
+	if (Cursor.MicrosecondsPerItem <= 0.0f)
+	{
+		return 1;
+	}
+
+	// The measured cost per bucket includes the fixed cost of iterating all chunks, shared between however many
+	// buckets were taken. So it over estimates while few buckets are taken and slices grow towards the budget over a
+	// few frames.
+	return FMath::Clamp(FMath::FloorToInt32(BudgetMicroseconds / Cursor.MicrosecondsPerItem), 1, FMassTrafficEntityBucketRange::NumBuckets);
+}
+
+void UMassTrafficProcessorBase::UpdateTimeSliceItemCost(FMassTrafficTimeSliceCursor& Cursor, const uint64 StartCycles, const int32 NumItems)
+{
+	if (NumItems <= 0)
+	{
+		return;
+	}
+
+	const float Microseconds = static_cast<float>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1e6);
+	const float MicrosecondsPerItem = Microseconds / NumItems;
+	Cursor.MicrosecondsPerItem = Cursor.MicrosecondsPerItem > 0.0f
+		? FMath::Lerp(Cursor.MicrosecondsPerItem, MicrosecondsPerItem, 0.25f)
+		: MicrosecondsPerItem;
+}
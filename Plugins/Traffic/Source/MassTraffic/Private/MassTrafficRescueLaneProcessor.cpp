@@ -6,6 +6,7 @@
 #include "MassExecutionContext.h"
 #include "MassZoneGraphNavigationFragments.h"
 #include "MassTrafficVehicleVolumeTrait.h"
+#include "Misc/MemStack.h"
 #include "MassExternalSubsystemTraits.h" // KEEP THIS UNDER ALL CIRCUMSTANCES OR ELSE COMPILE WILL FAIL!!!!
 
 
@@ -39,8 +40,11 @@ void UMassTrafficRescueLaneProcessor::Execute(FMassEntityManager& EntityManager,
 {
 	const UMassTrafficSubsystem& MassTrafficSubsystem = Context.GetSubsystemChecked<UMassTrafficSubsystem>();
 	
-	// first, get all the active EM vehicles
-	TArray<FMassEntityHandle> EMVehicles;
+	// first, get all the active EM vehicles, into scratch memory from the thread's linear memory stack
+	// (See all SCRATCHMEMORY.)
+	LLM_SCOPE_BYTAG(MassTraffic_Scratch);
+	FMemMark MemMark(FMemStack::Get());
+	TArray<FMassEntityHandle, TMemStackAllocator<>> EMVehicles;
 	EMVehicleQuery.ForEachEntityChunk( Context, [&](const FMassExecutionContext& QueryContext)
 	{
 		const int32 NumEntities = QueryContext.GetNumEntities();
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassTrafficSpawnPoints.h"
+
+#include "Algo/AllOf.h"
+#include "EngineUtils.h"
+#include "MassTraffic.h"
+#include "MassTrafficParkingSpotActor.h"
+#include "MassTrafficSettings.h"
+#include "MassTrafficUtils.h"
+#include "ZoneGraphData.h"
+#include "ZoneGraphSubsystem.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+const FMassTrafficBakedZoneGraphSpawnPoints* UMassTrafficSpawnPointsDataAsset::FindZoneGraphSpawnPoints(const FZoneGraphStorage& ZoneGraphStorage) const
+{
+	if (ZoneGraphSpawnPoints.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const uint32 BakeHash = GetVehicleSpawnPointsBakeHash(ZoneGraphStorage);
+	return ZoneGraphSpawnPoints.FindByPredicate([BakeHash](const FMassTrafficBakedZoneGraphSpawnPoints& SpawnPoints)
+	{
+		return SpawnPoints.BakeHash == BakeHash;
+	});
+}
+
+uint32 UMassTrafficSpawnPointsDataAsset::GetVehicleSpawnPointsBakeHash(const FZoneGraphStorage& ZoneGraphStorage) const
+{
+	const UMassTrafficSettings* MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+
+	uint32 Hash = UE::MassTraffic::GetZoneGraphStorageHash(ZoneGraphStorage);
+	Hash = HashCombineFast(Hash, UE::MassTraffic::GetTrafficLaneSettingsHash(MassTrafficSettings->TrafficLaneFilter, MassTrafficSettings->LaneDensities));
+	Hash = HashCombineFast(Hash, GetTypeHash(MinGapBetweenSpaces));
+	Hash = HashCombineFast(Hash, GetTypeHash(MaxGapBetweenSpaces));
+	Hash = HashCombineFast(Hash, GetTypeHash(RandomSeed));
+	return Hash;
+}
+
+const TArray<FMassTrafficBakedParkingSpaces>* UMassTrafficSpawnPointsDataAsset::FindParkingSpaces(const UWorld& World) const
+{
+	if (ParkingSpaces.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// PIE worlds are duplicated into a prefixed package
+	const FName WorldPackageName(UWorld::RemovePIEPrefix(World.GetPackage()->GetName()));
+	if (WorldPackageName != ParkingSpacesWorldPackageName)
+	{
+		UE_LOG(LogMassTraffic, Warning, TEXT("%s - Parking spaces in %s were baked from %s, not %s. Gathering parking spot actors instead."), ANSI_TO_TCHAR(__FUNCTION__), *GetName(), *ParkingSpacesWorldPackageName.ToString(), *WorldPackageName.ToString());
+		return nullptr;
+	}
+
+#if WITH_EDITOR
+	// All parking spot actors are loaded in non partitioned maps, so we can catch them being edited since the bake
+	if (GIsEditor && !World.IsPartitionedWorld())
+	{
+		TArray<FMassTrafficBakedParkingSpaces> CurrentParkingSpaces;
+		GatherParkingSpaces(World, CurrentParkingSpaces);
+
+		const bool bIsUpToDate = CurrentParkingSpaces.Num() == ParkingSpaces.Num() && Algo::AllOf(CurrentParkingSpaces, [this](const FMassTrafficBakedParkingSpaces& Current)
+		{
+			const FMassTrafficBakedParkingSpaces* Baked = ParkingSpaces.FindByPredicate([&Current](const FMassTrafficBakedParkingSpaces& Item)
+			{
+				return Item.ParkingSpaceType == Current.ParkingSpaceType;
+			});
+			if (!Baked || Baked->Transforms.Num() != Current.Transforms.Num())
+			{
+				return false;
+			}
+			for (int32 TransformIndex = 0; TransformIndex < Current.Transforms.Num(); ++TransformIndex)
+			{
+				if (!Baked->Transforms[TransformIndex].Equals(Current.Transforms[TransformIndex]))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+		if (!bIsUpToDate)
+		{
+			UE_LOG(LogMassTraffic, Warning, TEXT("%s - Parking spaces in %s are out of date with %s. Gathering parking spot actors instead."), ANSI_TO_TCHAR(__FUNCTION__), *GetName(), *WorldPackageName.ToString());
+			return nullptr;
+		}
+	}
+#endif
+
+	return &ParkingSpaces;
+}
+
+void UMassTrafficSpawnPointsDataAsset::GatherParkingSpaces(const UWorld& World, TArray<FMassTrafficBakedParkingSpaces>& OutParkingSpaces)
+{
+	for (TActorIterator<AMassTrafficParkingSpotActor> It(&World); It; ++It)
+	{
+		const FName ParkingSpaceType = It->GetParkingSpaceType();
+		FMassTrafficBakedParkingSpaces* BakedParkingSpaces = OutParkingSpaces.FindByPredicate([ParkingSpaceType](const FMassTrafficBakedParkingSpaces& Item)
+		{
+			return Item.ParkingSpaceType == ParkingSpaceType;
+		});
+		if (!BakedParkingSpaces)
+		{
+			BakedParkingSpaces = &OutParkingSpaces.AddDefaulted_GetRef();
+			BakedParkingSpaces->ParkingSpaceType = ParkingSpaceType;
+		}
+		BakedParkingSpaces->Transforms.Add(It->GetTransform());
+	}
+}
+
+#if WITH_EDITOR
+
+void UMassTrafficSpawnPointsDataAsset::PopulateVehicleSpawnPointsFromMap()
+{
+	ZoneGraphSpawnPoints.Reset();
+
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	const UZoneGraphSubsystem* ZoneGraphSubsystem = UWorld::GetSubsystem<UZoneGraphSubsystem>(World);
+	if (!ensure(ZoneGraphSubsystem) || VehicleTypeSpacings.IsEmpty())
+	{
+		return;
+	}
+	if (VehicleTypeSpacings.Num() > MAX_uint8)
+	{
+		UE_LOG(LogMassTraffic, Error, TEXT("%s - Too many VehicleTypeSpacings (%d) to bake. Max is %d."), ANSI_TO_TCHAR(__FUNCTION__), VehicleTypeSpacings.Num(), MAX_uint8);
+		return;
+	}
+
+	const UMassTrafficSettings* MassTrafficSettings = GetDefault<UMassTrafficSettings>();
+	const FRandomStream RandomStream(RandomSeed);
+
+	for (const FRegisteredZoneGraphData& RegisteredZoneGraphData : ZoneGraphSubsystem->GetRegisteredZoneGraphData())
+	{
+		if (!RegisteredZoneGraphData.bInUse || !RegisteredZoneGraphData.ZoneGraphData)
+		{
+			continue;
+		}
+		const FZoneGraphStorage& ZoneGraphStorage = RegisteredZoneGraphData.ZoneGraphData->GetStorage();
+
+		// Find spawn points for each spacing independently, as if it were the only one, so the runtime can mix them
+		// in any proportion
+		TMap<int32, TArray<FMassTrafficBakedLaneSpawnPoint>> SpawnPointsPerLane;
+		for (int32 SpacingIndex = 0; SpacingIndex < VehicleTypeSpacings.Num(); ++SpacingIndex)
+		{
+			TArray<FMassTrafficVehicleSpacing> Spacings = { VehicleTypeSpacings[SpacingIndex] };
+			Spacings[0].Proportion = 1.0f;
+
+			TArray<TArray<FZoneGraphLaneLocation>> SpawnPointsPerSpacing;
+			UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
+				ZoneGraphStorage,
+				MassTrafficSettings->TrafficLaneFilter,
+				MassTrafficSettings->LaneDensities,
+				RandomStream,
+				Spacings,
+				MinGapBetweenSpaces,
+				MaxGapBetweenSpaces,
+				/*Out*/SpawnPointsPerSpacing,
+				/*bShufflePoints*/false);
+
+			for (const FZoneGraphLaneLocation& LaneLocation : SpawnPointsPerSpacing[0])
+			{
+				FMassTrafficBakedLaneSpawnPoint& SpawnPoint = SpawnPointsPerLane.FindOrAdd(LaneLocation.LaneHandle.Index).AddDefaulted_GetRef();
+				SpawnPoint.LaneLocation = LaneLocation;
+				SpawnPoint.SpacingIndex = static_cast<uint8>(SpacingIndex);
+			}
+		}
+
+		FMassTrafficBakedZoneGraphSpawnPoints& BakedSpawnPoints = ZoneGraphSpawnPoints.AddDefaulted_GetRef();
+		BakedSpawnPoints.BakeHash = GetVehicleSpawnPointsBakeHash(ZoneGraphStorage);
+		BakedSpawnPoints.Lanes.Reserve(SpawnPointsPerLane.Num());
+		for (TPair<int32, TArray<FMassTrafficBakedLaneSpawnPoint>>& LaneSpawnPoints : SpawnPointsPerLane)
+		{
+			FMassTrafficBakedLaneSpawnPoints& BakedLane = BakedSpawnPoints.Lanes.AddDefaulted_GetRef();
+			BakedLane.LaneIndex = LaneSpawnPoints.Key;
+			BakedLane.SpawnPoints = MoveTemp(LaneSpawnPoints.Value);
+			BakedLane.SpawnPoints.Sort([](const FMassTrafficBakedLaneSpawnPoint& A, const FMassTrafficBakedLaneSpawnPoint& B)
+			{
+				return A.LaneLocation.DistanceAlongLane < B.LaneLocation.DistanceAlongLane;
+			});
+		}
+
+		// Keep lanes in a stable order so runtime sampling is deterministic
+		BakedSpawnPoints.Lanes.Sort([](const FMassTrafficBakedLaneSpawnPoints& A, const FMassTrafficBakedLaneSpawnPoints& B)
+		{
+			return A.LaneIndex < B.LaneIndex;
+		});
+	}
+
+	Modify();
+}
+
+void UMassTrafficSpawnPointsDataAsset::PopulateParkingSpacesFromMap()
+{
+	ParkingSpaces.Reset();
+	ParkingSpacesWorldPackageName = NAME_None;
+
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!ensure(World))
+	{
+		return;
+	}
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogMassTraffic, Warning, TEXT("%s - Only parking spot actors in loaded World Partition cells will be baked."), ANSI_TO_TCHAR(__FUNCTION__));
+	}
+
+	GatherParkingSpaces(*World, ParkingSpaces);
+	ParkingSpacesWorldPackageName = World->GetPackage()->GetFName();
+
+	Modify();
+}
+
+#endif
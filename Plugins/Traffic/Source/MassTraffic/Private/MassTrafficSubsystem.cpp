@@ -7,22 +7,37 @@
 #include "MassTrafficFragments.h"
 #include "MassTrafficTypes.h"
 #include "MassTrafficRecycleVehiclesOverlappingPlayersProcessor.h"
+#include "MassTrafficInitTrafficVehiclesProcessor.h"
+#include "MassTrafficOcclusion.h"
+#include "MassTrafficPathFollower.h"
+#include "MassDebugger.h"
 #include "MassExecutionContext.h"
 #include "MassEntityManager.h"
 #include "MassEntitySubsystem.h"
+#include "MassEntityConfigAsset.h"
 #include "MassExecutor.h"
+#include "MassLODFragments.h"
 #include "MassProcessingContext.h"
 #include "MassReplicationSubsystem.h"
 #include "MassSimulationSubsystem.h"
+#include "MassSpawnerSubsystem.h"
 #include "MassTrafficUtils.h"
 #include "Math/UnitConversion.h"
 #include "ZoneGraphDelegates.h"
 #include "ZoneGraphQuery.h"
 #include "ZoneGraphSubsystem.h"
+#include "Algo/Sort.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
 #include "VisualLogger/VisualLogger.h"
 #include "MassProcessingContext.h"
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Streaming Spawned Vehicles"), STAT_Traffic_StreamingSpawnedVehicles, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Streaming Spawn Skipped Vehicles"), STAT_Traffic_StreamingSpawnSkippedVehicles, STATGROUP_Traffic);
+
 UMassTrafficSubsystem::UMassTrafficSubsystem()
 {
 	RemoveVehiclesOverlappingPlayersProcessor = CreateDefaultSubobject<UMassTrafficRecycleVehiclesOverlappingPlayersProcessor>(TEXT("RemoveVehiclesOverlappingPlayersProcessor"));
@@ -45,6 +60,17 @@ void UMassTrafficSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Cache settings
 	MassTrafficSettings = GetDefault<UMassTrafficSettings>();
 
+	DensityGrid.Reset(MassTrafficSettings->DensityGridCellSize);
+
+	// Load baked occlusion before registering zone graphs, which look up their occlusion. (See all OCCLUSIONPVS.)
+	for (const TSoftObjectPtr<UMassTrafficOcclusionDataAsset>& OcclusionData : MassTrafficSettings->OcclusionData)
+	{
+		if (const UMassTrafficOcclusionDataAsset* OcclusionDataAsset = OcclusionData.LoadSynchronous())
+		{
+			OcclusionDataAssets.Add(OcclusionDataAsset);
+		}
+	}
+
 	// Register existing data.
 	for (const FRegisteredZoneGraphData& Registered : ZoneGraphSubsystem->GetRegisteredZoneGraphData())
 	{
@@ -76,6 +102,7 @@ void UMassTrafficSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	TrafficVehicleEntityQuery.Initialize(EntityManagerRef);
 	TrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
 	TrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficRecyclableVehicleTag>(EMassFragmentPresence::Any);
+	TrafficVehicleEntityQuery.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::Any);
 	TrafficVehicleEntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::None); // Queries have to have at least one component to be valid
 
 	// Cache the parked vehicle entity query
@@ -109,6 +136,14 @@ void UMassTrafficSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 
 	// Execute any field operations subclassing from UMassTrafficBeginPlayFieldOperationBase 
 	PerformFieldOperation(UMassTrafficBeginPlayFieldOperationBase::StaticClass());
+
+	// Spawn queued streaming spawns once Mass processing is done each frame, as entities can't be created synchronously
+	// during processing. (See all STREAMINGSPAWN.)
+	if (UMassSimulationSubsystem* SimulationSubsystem = InWorld.GetSubsystem<UMassSimulationSubsystem>())
+	{
+		OnStreamingSpawnPhaseFinishedHandle = SimulationSubsystem->GetOnProcessingPhaseFinished(EMassProcessingPhase::FrameEnd).AddUObject(this, &UMassTrafficSubsystem::ProcessStreamingSpawns);
+		OnDensityGridPhaseFinishedHandle = SimulationSubsystem->GetOnProcessingPhaseFinished(EMassProcessingPhase::FrameEnd).AddUObject(this, &UMassTrafficSubsystem::UpdateDensityGrid);
+	}
 }
 
 void UMassTrafficSubsystem::PostInitialize()
@@ -134,6 +169,14 @@ void UMassTrafficSubsystem::Deinitialize()
 	UE::ZoneGraphDelegates::OnPostZoneGraphDataAdded.Remove(OnPostZoneGraphDataAddedHandle);
 	UE::ZoneGraphDelegates::OnPreZoneGraphDataRemoved.Remove(OnPreZoneGraphDataRemovedHandle);
 
+	if (UMassSimulationSubsystem* SimulationSubsystem = UWorld::GetSubsystem<UMassSimulationSubsystem>(GetWorld()))
+	{
+		SimulationSubsystem->GetOnProcessingPhaseFinished(EMassProcessingPhase::FrameEnd).Remove(OnStreamingSpawnPhaseFinishedHandle);
+		SimulationSubsystem->GetOnProcessingPhaseFinished(EMassProcessingPhase::FrameEnd).Remove(OnDensityGridPhaseFinishedHandle);
+	}
+	CancelStreamingSpawns();
+	StreamingSpawnedVehicles.Reset();
+
 	EntityManager.Reset();
 
 	Super::Deinitialize();
@@ -172,6 +215,9 @@ void UMassTrafficSubsystem::PreZoneGraphDataRemoved(const AZoneGraphData* ZoneGr
 		return;
 	}
 
+	// Queued spawn points on the removed lanes must go, as their handles could be reused by data added later
+	CancelStreamingSpawns(Storage.DataHandle);
+
 	FMassTrafficZoneGraphData& LaneData = RegisteredTrafficZoneGraphData[Index];
 	LaneData.Reset();
 	
@@ -273,8 +319,10 @@ bool IsZigLagLane(const FZoneGraphStorage& ZoneGraphStorage, const int32 LaneInd
 
 void UMassTrafficSubsystem::BuildLaneData(FMassTrafficZoneGraphData& TrafficZoneGraphData, const FZoneGraphStorage& ZoneGraphStorage)
 {
+	LLM_SCOPE_BYTAG(MassTraffic_LaneData);
+
+	TrafficZoneGraphData.Reset();
 	TrafficZoneGraphData.DataHandle = ZoneGraphStorage.DataHandle;
-	TrafficZoneGraphData.TrafficLaneDataArray.Reset();
 
 	TMap<int32, int32> LeftLaneOverrides; // Key.LeftLanes = Value
 	TMap<int32, int32> RightLaneOverrides; // Key.RightLanes = Value
@@ -549,6 +597,27 @@ void UMassTrafficSubsystem::BuildLaneData(FMassTrafficZoneGraphData& TrafficZone
 			TrafficLaneData.ConstData.AverageNextLanesSpeedLimit = 0.0f;
 		}
 	}
+
+	// Start tracking lane densities now lane addresses are stable. (See all DENSITYBUCKETS.)
+	for (FZoneGraphTrafficLaneData& TrafficLaneData : TrafficZoneGraphData.TrafficLaneDataArray)
+	{
+		TrafficLaneData.DensityBuckets = &TrafficZoneGraphData.DensityBuckets;
+		TrafficZoneGraphData.DensityBuckets.UpdateLane(TrafficLaneData);
+
+		// (See all DENSITYGRID.)
+		TrafficLaneData.DensityGrid = &DensityGrid;
+		TrafficLaneData.DensityGridCell = DensityGrid.FindOrAddCell(TrafficLaneData.CenterLocation);
+	}
+
+	// Use the first occlusion baked for this exact zone graph. (See all OCCLUSIONPVS.)
+	for (const UMassTrafficOcclusionDataAsset* OcclusionDataAsset : OcclusionDataAssets)
+	{
+		TrafficZoneGraphData.Occlusion = OcclusionDataAsset->FindZoneGraphOcclusion(ZoneGraphStorage);
+		if (TrafficZoneGraphData.Occlusion)
+		{
+			break;
+		}
+	}
 }
 
 void UMassTrafficSubsystem::RegisterField(UMassTrafficFieldComponent* Field)
@@ -691,6 +760,8 @@ bool UMassTrafficSubsystem::HasParkedVehicleAgents()
 
 void UMassTrafficSubsystem::ClearAllTrafficLanes()
 {
+	CancelStreamingSpawns();
+
 	for (FMassTrafficZoneGraphData& TrafficZoneGraphData : RegisteredTrafficZoneGraphData)
 	{
 		for (FZoneGraphTrafficLaneData& TrafficLaneData : TrafficZoneGraphData.TrafficLaneDataArray)
@@ -700,6 +771,37 @@ void UMassTrafficSubsystem::ClearAllTrafficLanes()
 	}
 }
 
+FMassTrafficDensity UMassTrafficSubsystem::GetTrafficDensityAt(const FVector Location) const
+{
+	FMassTrafficDensity Density;
+	if (const FMassTrafficDensityGrid::FCell* Cell = DensityGrid.FindCell(Location))
+	{
+		if (Cell->NumVehicles > 0)
+		{
+			Density.NumVehicles = Cell->NumVehicles;
+			Density.AverageSpeed = Cell->AverageSpeed;
+			Density.NumStoppedVehicles = FMath::RoundToInt32(Cell->StoppedFraction * Cell->NumVehicles);
+		}
+	}
+	return Density;
+}
+
+void UMassTrafficSubsystem::SampleDensityGridVehicle(const FZoneGraphLaneHandle LaneHandle, const float Speed, const float DeltaTime)
+{
+	const FZoneGraphTrafficLaneData* TrafficLaneData = GetTrafficLaneData(LaneHandle);
+	if (TrafficLaneData && TrafficLaneData->DensityGrid)
+	{
+		DensityGrid.SampleVehicle(TrafficLaneData->DensityGridCell, Speed, DeltaTime, MassTrafficSettings->DensityGridStoppedSpeed);
+	}
+}
+
+void UMassTrafficSubsystem::UpdateDensityGrid(const float DeltaSeconds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("UpdateDensityGrid"));
+
+	DensityGrid.UpdateAverages(MassTrafficSettings->DensityGridSmoothingTime);
+}
+
 bool UMassTrafficSubsystem::FindNearestLane(const FVector Location, const float MaxRange, FZoneGraphTagFilterEx TagFilter, FZoneGraphLaneLocationEx& LocationOnRoad, float& SqDistance) const
 {
 	if (ZoneGraphSubsystem)
@@ -766,44 +868,272 @@ void UMassTrafficSubsystem::RemoveVehiclesOverlappingPlayers()
 	UE::Mass::Executor::RunProcessorsView(RemoveVehiclesOverlappingPlayersProcessors, ProcessingContext);
 }
 
-const FMassTrafficSimpleVehiclePhysicsTemplate* UMassTrafficSubsystem::GetOrExtractVehiclePhysicsTemplate(TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor)
+void UMassTrafficSubsystem::QueueStreamingSpawn(FMassTrafficStreamingSpawnRequest&& Request)
 {
-	// Check for existing first
-	for (const FMassTrafficSimpleVehiclePhysicsTemplate& VehiclePhysicsTemplate : VehiclePhysicsTemplates)
+	if (Request.SpawnPoints.IsEmpty())
+	{
+		return;
+	}
+
+	StreamingSpawnRequests.Add(MoveTemp(Request));
+}
+
+void UMassTrafficSubsystem::CancelStreamingSpawns(const FZoneGraphDataHandle DataHandle)
+{
+	for (FMassTrafficStreamingSpawnRequest& Request : StreamingSpawnRequests)
+	{
+		// Drop the spawned points first, so NextSpawnPointIndex stays valid as the rest are filtered in order
+		Request.SpawnPoints.RemoveAt(0, Request.NextSpawnPointIndex);
+		Request.NextSpawnPointIndex = 0;
+		Request.SpawnPoints.RemoveAll([DataHandle](const FMassTrafficStreamingSpawnPoint& SpawnPoint)
+		{
+			return SpawnPoint.LaneLocation.LaneHandle.DataHandle == DataHandle;
+		});
+		for (TMap<FZoneGraphLaneHandle, int32>::TIterator It = Request.NumSpawnedVehiclesApproachingLane.CreateIterator(); It; ++It)
+		{
+			if (It.Key().DataHandle == DataHandle)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	StreamingSpawnRequests.RemoveAll([](const FMassTrafficStreamingSpawnRequest& Request)
+	{
+		return Request.SpawnPoints.IsEmpty();
+	});
+}
+
+void UMassTrafficSubsystem::DespawnStreamingSpawnedVehicles(const UObject& Owner)
+{
+	const TObjectKey<UObject> OwnerKey(&Owner);
+	StreamingSpawnRequests.RemoveAll([&OwnerKey](const FMassTrafficStreamingSpawnRequest& Request)
+	{
+		return Request.Owner == OwnerKey;
+	});
+
+	TArray<FMassEntityHandle> SpawnedVehicles;
+	if (StreamingSpawnedVehicles.RemoveAndCopyValue(OwnerKey, SpawnedVehicles))
+	{
+		DestroyStreamingSpawnedVehicles(SpawnedVehicles);
+	}
+}
+
+void UMassTrafficSubsystem::DestroyStreamingSpawnedVehicles(TArray<FMassEntityHandle>& SpawnedVehicles)
+{
+	UMassSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
+	if (!SpawnerSubsystem || !EntityManager)
+	{
+		return;
+	}
+
+	// Vehicles may have been destroyed by other means since
+	SpawnedVehicles.RemoveAllSwap([this](const FMassEntityHandle Entity)
+	{
+		return !EntityManager->IsEntityValid(Entity);
+	});
+	SpawnerSubsystem->DestroyEntities(SpawnedVehicles);
+}
+
+void UMassTrafficSubsystem::ProcessStreamingSpawns(const float DeltaSeconds)
+{
+	// Drop requests, and despawn vehicles streamed in, for spawners that have since been destroyed, as the spawners
+	// can't despawn them themselves
+	StreamingSpawnRequests.RemoveAll([](const FMassTrafficStreamingSpawnRequest& Request)
+	{
+		return !Request.Owner.ResolveObjectPtr();
+	});
+	for (TMap<TObjectKey<UObject>, TArray<FMassEntityHandle>>::TIterator It = StreamingSpawnedVehicles.CreateIterator(); It; ++It)
 	{
-		if (VehiclePhysicsTemplate.PhysicsVehicleTemplateActor == PhysicsVehicleTemplateActor)
+		if (!It.Key().ResolveObjectPtr())
 		{
-			return &VehiclePhysicsTemplate;
+			DestroyStreamingSpawnedVehicles(It.Value());
+			It.RemoveCurrent();
 		}
 	}
 
+	if (StreamingSpawnRequests.IsEmpty())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("MassTrafficStreamingSpawn"))
+
+	UMassSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
+	if (!SpawnerSubsystem || !EntityManager)
+	{
+		return;
+	}
+
+	// Every request spawns its next batch each frame, so later requests aren't held up behind earlier ones
+	for (FMassTrafficStreamingSpawnRequest& Request : StreamingSpawnRequests)
+	{
+		ProcessStreamingSpawnRequest(Request, *SpawnerSubsystem);
+	}
+
+	StreamingSpawnRequests.RemoveAll([](const FMassTrafficStreamingSpawnRequest& Request)
+	{
+		return Request.NextSpawnPointIndex >= Request.SpawnPoints.Num();
+	});
+}
+
+void UMassTrafficSubsystem::ProcessStreamingSpawnRequest(FMassTrafficStreamingSpawnRequest& Request, UMassSpawnerSubsystem& SpawnerSubsystem)
+{
+	UWorld* World = GetWorld();
+
+	// Gather this frame's batch, a whole lane at a time. Spawn points are sorted by viewer ring, then by lane, so this
+	// populates lanes in rings expanding out from the viewers. Lanes that have since gained vehicles, or are being
+	// approached by vehicles other than the ones this request spawned on the lanes behind them, are skipped, as the new
+	// vehicles are only linked to each other and the lanes ahead of them.
+	TArray<TArray<FZoneGraphLaneLocation>> LaneLocationsPerEntityType;
+	LaneLocationsPerEntityType.SetNum(Request.EntityConfigs.Num());
+	int32 NumBatchVehicles = 0;
+	int32 NumSkippedVehicles = 0;
+	while (Request.NextSpawnPointIndex < Request.SpawnPoints.Num() && NumBatchVehicles < Request.MaxVehiclesPerFrame)
+	{
+		const FZoneGraphLaneHandle LaneHandle = Request.SpawnPoints[Request.NextSpawnPointIndex].LaneLocation.LaneHandle;
+		int32 LaneSpawnPointsEnd = Request.NextSpawnPointIndex + 1;
+		while (LaneSpawnPointsEnd < Request.SpawnPoints.Num() && Request.SpawnPoints[LaneSpawnPointsEnd].LaneLocation.LaneHandle == LaneHandle)
+		{
+			++LaneSpawnPointsEnd;
+		}
+
+		const FZoneGraphTrafficLaneData* TrafficLaneData = HasTrafficDataForZoneGraph(LaneHandle.DataHandle) ? GetTrafficLaneData(LaneHandle) : nullptr;
+		const int32 NumOtherVehiclesApproachingLane = TrafficLaneData ? TrafficLaneData->NumVehiclesApproachingLane - Request.NumSpawnedVehiclesApproachingLane.FindRef(LaneHandle) : 0;
+		if (TrafficLaneData && !TrafficLaneData->TailVehicle.IsSet() && NumOtherVehiclesApproachingLane <= 0)
+		{
+			const int32 NumLaneVehicles = LaneSpawnPointsEnd - Request.NextSpawnPointIndex;
+			for (int32 SpawnPointIndex = Request.NextSpawnPointIndex; SpawnPointIndex < LaneSpawnPointsEnd; ++SpawnPointIndex)
+			{
+				const FMassTrafficStreamingSpawnPoint& SpawnPoint = Request.SpawnPoints[SpawnPointIndex];
+				LaneLocationsPerEntityType[SpawnPoint.EntityTypeIndex].Add(SpawnPoint.LaneLocation);
+			}
+			NumBatchVehicles += NumLaneVehicles;
+
+			// Vehicles on lanes with a single next lane approach it as soon as they're spawned.
+			// @see UMassTrafficInitTrafficVehiclesProcessor
+			if (TrafficLaneData->NextLanes.Num() == 1)
+			{
+				Request.NumSpawnedVehiclesApproachingLane.FindOrAdd(TrafficLaneData->NextLanes[0]->LaneHandle) += NumLaneVehicles;
+			}
+		}
+		else
+		{
+			NumSkippedVehicles += LaneSpawnPointsEnd - Request.NextSpawnPointIndex;
+		}
+
+		Request.NextSpawnPointIndex = LaneSpawnPointsEnd;
+	}
+
+	// Spawn each entity type, running the spawn data processor on each as we go 
+	TArray<FMassArchetypeEntityCollection> SpawnedEntityCollections;
+	for (int32 EntityTypeIndex = 0; EntityTypeIndex < LaneLocationsPerEntityType.Num(); ++EntityTypeIndex)
+	{
+		TArray<FZoneGraphLaneLocation>& LaneLocations = LaneLocationsPerEntityType[EntityTypeIndex];
+		const UMassEntityConfigAsset* EntityConfig = Request.EntityConfigs[EntityTypeIndex].Get();
+		if (LaneLocations.IsEmpty() || !EntityConfig)
+		{
+			NumSkippedVehicles += LaneLocations.Num();
+			continue;
+		}
+
+		const FMassEntityTemplate& EntityTemplate = EntityConfig->GetOrCreateEntityTemplate(*World);
+		if (!EntityTemplate.IsValid())
+		{
+			NumSkippedVehicles += LaneLocations.Num();
+			continue;
+		}
+
+		FInstancedStruct SpawnData;
+		SpawnData.InitializeAs<FMassTrafficVehiclesSpawnData>();
+		SpawnData.GetMutable<FMassTrafficVehiclesSpawnData>().LaneLocations = MoveTemp(LaneLocations);
+
+		TArray<FMassEntityHandle> SpawnedEntities;
+		SpawnerSubsystem.SpawnEntities(EntityTemplate.GetTemplateID(), SpawnData.Get<FMassTrafficVehiclesSpawnData>().LaneLocations.Num(), SpawnData, Request.SpawnDataProcessor, SpawnedEntities);
+		if (!SpawnedEntities.IsEmpty())
+		{
+			StreamingSpawnedVehicles.FindOrAdd(Request.Owner).Append(SpawnedEntities);
+			SpawnedEntityCollections.Emplace(EntityManager->GetArchetypeForEntity(SpawnedEntities[0]), SpawnedEntities, FMassArchetypeEntityCollection::NoDuplicates);
+		}
+	}
+
+	// Run post spawn processors on all this batch's new vehicles together, so vehicles of different types sharing a
+	// lane are linked to each other
+	if (!SpawnedEntityCollections.IsEmpty())
+	{
+		TArray<UMassProcessor*> PostSpawnProcessors;
+		for (const TSubclassOf<UMassProcessor>& PostSpawnProcessorClass : Request.PostSpawnProcessors)
+		{
+			TObjectPtr<UMassProcessor>* PostSpawnProcessor = StreamingSpawnPostSpawnProcessors.FindByPredicate([&PostSpawnProcessorClass](const UMassProcessor* Processor)
+			{
+				return Processor->GetClass() == PostSpawnProcessorClass.Get();
+			});
+			if (!PostSpawnProcessor)
+			{
+				UMassProcessor* NewPostSpawnProcessor = NewObject<UMassProcessor>(this, PostSpawnProcessorClass);
+				NewPostSpawnProcessor->CallInitialize(this, EntityManager.ToSharedRef());
+				PostSpawnProcessor = &StreamingSpawnPostSpawnProcessors.Add_GetRef(NewPostSpawnProcessor);
+			}
+			PostSpawnProcessors.Add(PostSpawnProcessor->Get());
+		}
+
+		FMassProcessingContext ProcessingContext(EntityManager);
+		UE::Mass::Executor::RunProcessorsView(PostSpawnProcessors, ProcessingContext, SpawnedEntityCollections);
+	}
+
+	INC_DWORD_STAT_BY(STAT_Traffic_StreamingSpawnedVehicles, NumBatchVehicles);
+	INC_DWORD_STAT_BY(STAT_Traffic_StreamingSpawnSkippedVehicles, NumSkippedVehicles);
+}
+
+const FMassTrafficSimpleVehiclePhysicsTemplate* UMassTrafficSubsystem::GetOrExtractVehiclePhysicsTemplate(TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor, const UMassTrafficVehiclePhysicsDataAsset* PhysicsVehicleData)
+{
+	// Check for existing first
+	const TPair<const UClass*, const UMassTrafficVehiclePhysicsDataAsset*> VehiclePhysicsTemplateKey(PhysicsVehicleTemplateActor.Get(), PhysicsVehicleData);
+	if (const FMassTrafficSimpleVehiclePhysicsTemplate* const* ExistingVehiclePhysicsTemplate = VehiclePhysicsTemplatesByKey.Find(VehiclePhysicsTemplateKey))
+	{
+		return *ExistingVehiclePhysicsTemplate;
+	}
+
 	// Create a new template
 	FMassTrafficSimpleVehiclePhysicsTemplate* NewVehiclePhysicsTemplate = new FMassTrafficSimpleVehiclePhysicsTemplate();
 	NewVehiclePhysicsTemplate->PhysicsVehicleTemplateActor = PhysicsVehicleTemplateActor;
 	VehiclePhysicsTemplates.Add(NewVehiclePhysicsTemplate);
+	VehiclePhysicsTemplatesByKey.Add(VehiclePhysicsTemplateKey, NewVehiclePhysicsTemplate);
 
-	// Spawn a temp copy of the physics actor to mine properties off.
-	// Note: we do this instead of using the CDO for the actor, to get at the finalised FBodyInstance
-	// details.
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.bNoFail = true;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AWheeledVehiclePawn* TempPhysicsActor = GetWorld()->SpawnActor<AWheeledVehiclePawn>(PhysicsVehicleTemplateActor.Get(), SpawnParameters);
-	if (TempPhysicsActor)
-	{
-		// Mine physics BP for physics config
-		UE::MassTraffic::ExtractPhysicsVehicleConfig(
-			TempPhysicsActor,
+	// Use the pre-extracted physics config if we have one
+	if (PhysicsVehicleData && PhysicsVehicleData->HasExtractedPhysicsVehicleConfig(PhysicsVehicleTemplateActor))
+	{
+		PhysicsVehicleData->InitPhysicsVehicleTemplate(*NewVehiclePhysicsTemplate);
+	}
+	else
+	{
+		if (PhysicsVehicleData)
+		{
+			UE_LOG(LogMassTraffic, Warning, TEXT("%s has no physics config extracted from %s. Falling back to runtime extraction. Run ExtractPhysicsVehicleConfig on %s to fix."), *PhysicsVehicleData->GetName(), *GetNameSafe(PhysicsVehicleTemplateActor.Get()), *PhysicsVehicleData->GetName());
+		}
+		
+		UE::MassTraffic::SpawnAndExtractPhysicsVehicleConfig(
+			*GetWorld(),
+			PhysicsVehicleTemplateActor,
 			NewVehiclePhysicsTemplate->SimpleVehiclePhysicsConfig,
 			NewVehiclePhysicsTemplate->SimpleVehiclePhysicsFragmentTemplate.VehicleSim
 		);
-				
-		TempPhysicsActor->Destroy();
 	}
-	else
+
+	// Report what each vehicle of this type saves by reading its stateless sims from the shared config, rather than
+	// carrying its own copies. (See FMassTrafficSimpleVehiclePhysicsSim::SetupPtr.)
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehiclePhysicsConfig = NewVehiclePhysicsTemplate->SimpleVehiclePhysicsConfig;
+	SIZE_T SharedSimBytes = sizeof(Chaos::FSimpleDifferentialSim) + sizeof(Chaos::FSimpleSteeringSim) + sizeof(Chaos::FSimpleAerodynamicsSim) + sizeof(TArray<Chaos::FAxleSim, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsConfig::MaxAxles>>);
+	for (const Chaos::FAxleConfig& AxleConfig : VehiclePhysicsConfig.AxleConfigs)
 	{
-		UE_LOG(LogMassTraffic, Error, TEXT("Couldn't spawn PhysicsActorClass (%s) to mine simple vehicle physics params from"), *PhysicsVehicleTemplateActor->GetName());
+		SharedSimBytes += AxleConfig.WheelIndex.GetAllocatedSize();
 	}
+	const FMassTrafficSimpleVehiclePhysicsSim& VehicleSimTemplate = NewVehiclePhysicsTemplate->SimpleVehiclePhysicsFragmentTemplate.VehicleSim;
+	const SIZE_T PerVehicleBytes = sizeof(FMassTrafficVehiclePhysicsFragment)
+		+ (VehicleSimTemplate.WheelSims.Num() > FMassTrafficSimpleVehiclePhysicsSim::InlineWheels ? VehicleSimTemplate.WheelSims.GetAllocatedSize() + VehicleSimTemplate.SuspensionSims.GetAllocatedSize() + VehicleSimTemplate.WheelLocalLocations.GetAllocatedSize() : 0);
+	UE_LOG(LogMassTraffic, Log, TEXT("%s simple physics: %llu bytes per vehicle, %llu bytes (%.0f%%) saved per vehicle by sharing stateless sims through its %llu byte config"),
+		*GetNameSafe(PhysicsVehicleTemplateActor.Get()), static_cast<uint64>(PerVehicleBytes), static_cast<uint64>(SharedSimBytes),
+		100.0 * SharedSimBytes / (PerVehicleBytes + SharedSimBytes), static_cast<uint64>(sizeof(FMassTrafficSimpleVehiclePhysicsConfig)));
 
 	return NewVehiclePhysicsTemplate;
 }
@@ -838,6 +1168,213 @@ void UMassTrafficSubsystem::RebuildLaneData()
 }
 #endif // WITH_EDITOR
 
+void UMassTrafficSubsystem::DumpMemory(FOutputDevice& Ar, const bool bWriteCSV, const int32 NumTopLanes) const
+{
+	struct FMemoryReportRow
+	{
+		FString Category;
+		FString Name;
+		int32 Count = 0;
+		SIZE_T Bytes = 0;
+	};
+	TArray<FMemoryReportRow> Rows;
+	auto AddRow = [&Rows](const TCHAR* Category, const FString& Name, const int32 Count, const SIZE_T Bytes)
+	{
+		Rows.Add({Category, Name, Count, Bytes});
+	};
+
+	// Lane tables. TrafficLaneDataLookup is sized to the full zone graph lane count, not just traffic lanes. Inline
+	// link arrays only report heap memory once they overflow their inline storage.
+	struct FLaneMemory
+	{
+		const FZoneGraphTrafficLaneData* TrafficLaneData = nullptr;
+		SIZE_T Bytes = 0;
+	};
+	TArray<FLaneMemory> LaneMemories;
+	for (const FMassTrafficZoneGraphData& TrafficZoneGraphData : RegisteredTrafficZoneGraphData)
+	{
+		if (!TrafficZoneGraphData.DataHandle.IsValid())
+		{
+			continue;
+		}
+
+		SIZE_T LaneLinkOverflowBytes = 0;
+		SIZE_T MesoscopicQueueBytes = 0;
+		for (const FZoneGraphTrafficLaneData& TrafficLaneData : TrafficZoneGraphData.TrafficLaneDataArray)
+		{
+			const SIZE_T LaneLinkBytes = TrafficLaneData.NextLanes.GetAllocatedSize()
+				+ TrafficLaneData.MergingLanes.GetAllocatedSize()
+				+ TrafficLaneData.SplittingLanes.GetAllocatedSize();
+			const SIZE_T LaneMesoscopicBytes = TrafficLaneData.MesoscopicVehicles.GetAllocatedSize() + TrafficLaneData.MesoscopicInflow.GetAllocatedSize();
+			LaneLinkOverflowBytes += LaneLinkBytes;
+			MesoscopicQueueBytes += LaneMesoscopicBytes;
+
+			if (NumTopLanes > 0)
+			{
+				LaneMemories.Add({ &TrafficLaneData, sizeof(FZoneGraphTrafficLaneData) + LaneLinkBytes + LaneMesoscopicBytes });
+			}
+		}
+
+		const FString ZoneGraphName = FString::Printf(TEXT("ZoneGraph%d"), TrafficZoneGraphData.DataHandle.Index);
+		AddRow(TEXT("LaneData"), ZoneGraphName + TEXT(".TrafficLaneDataArray"), TrafficZoneGraphData.TrafficLaneDataArray.Num(), TrafficZoneGraphData.TrafficLaneDataArray.GetAllocatedSize());
+		AddRow(TEXT("LaneData"), ZoneGraphName + TEXT(".TrafficLaneDataLookup"), TrafficZoneGraphData.TrafficLaneDataLookup.Num(), TrafficZoneGraphData.TrafficLaneDataLookup.GetAllocatedSize());
+		AddRow(TEXT("LaneData"), ZoneGraphName + TEXT(".LaneLinkOverflow"), TrafficZoneGraphData.TrafficLaneDataArray.Num(), LaneLinkOverflowBytes);
+		AddRow(TEXT("LaneData"), ZoneGraphName + TEXT(".MesoscopicQueues"), TrafficZoneGraphData.TrafficLaneDataArray.Num(), MesoscopicQueueBytes);
+		AddRow(TEXT("LaneData"), ZoneGraphName + TEXT(".DensityBuckets"), TrafficZoneGraphData.TrafficLaneDataArray.Num(), TrafficZoneGraphData.DensityBuckets.GetAllocatedSize());
+	}
+	AddRow(TEXT("LaneData"), TEXT("DensityGrid"), DensityGrid.Cells.Num(), DensityGrid.GetAllocatedSize());
+
+	// The NumTopLanes lanes using the most memory, counting their lane data and its heap allocations. These are already
+	// included in the lane table totals above. Count is the lane's number of link and mesoscopic queue entries.
+	Algo::Sort(LaneMemories, [](const FLaneMemory& A, const FLaneMemory& B) { return A.Bytes > B.Bytes; });
+	for (int32 LaneMemoryIndex = 0; LaneMemoryIndex < FMath::Min(NumTopLanes, LaneMemories.Num()); ++LaneMemoryIndex)
+	{
+		const FZoneGraphTrafficLaneData& TrafficLaneData = *LaneMemories[LaneMemoryIndex].TrafficLaneData;
+		const int32 NumLaneEntries = TrafficLaneData.NextLanes.Num() + TrafficLaneData.MergingLanes.Num() + TrafficLaneData.SplittingLanes.Num()
+			+ TrafficLaneData.MesoscopicVehicles.Num() + TrafficLaneData.MesoscopicInflow.Num();
+		AddRow(TEXT("Lane"), FString::Printf(TEXT("ZoneGraph%d.Lane%d"), TrafficLaneData.LaneHandle.DataHandle.Index, TrafficLaneData.LaneHandle.Index), NumLaneEntries, LaneMemories[LaneMemoryIndex].Bytes);
+	}
+
+	// Intersection tables & period arrays
+	int32 NumIntersectionFragments = 0;
+	SIZE_T IntersectionPeriodBytes = 0;
+	if (EntityManager)
+	{
+		for (const TPair<int32, FMassEntityHandle>& RegisteredTrafficIntersection : RegisteredTrafficIntersections)
+		{
+			if (!EntityManager->IsEntityValid(RegisteredTrafficIntersection.Value))
+			{
+				continue;
+			}
+			
+			if (const FMassTrafficIntersectionFragment* IntersectionFragment = EntityManager->GetFragmentDataPtr<FMassTrafficIntersectionFragment>(RegisteredTrafficIntersection.Value))
+			{
+				++NumIntersectionFragments;
+				IntersectionPeriodBytes += IntersectionFragment->GetAllocatedSize();
+			}
+		}
+	}
+	AddRow(TEXT("Intersections"), TEXT("RegisteredTrafficIntersections"), RegisteredTrafficIntersections.Num(), RegisteredTrafficIntersections.GetAllocatedSize());
+	AddRow(TEXT("Intersections"), TEXT("PeriodOverflow"), NumIntersectionFragments, IntersectionPeriodBytes);
+
+	// Vehicle physics templates
+	SIZE_T PhysicsTemplateBytes = VehiclePhysicsTemplates.GetAllocatedSize() + VehiclePhysicsTemplatesByKey.GetAllocatedSize();
+	PhysicsTemplateBytes += VehiclePhysicsTemplates.Num() * sizeof(FMassTrafficSimpleVehiclePhysicsTemplate);
+	AddRow(TEXT("Physics"), TEXT("VehiclePhysicsTemplates"), VehiclePhysicsTemplates.Num(), PhysicsTemplateBytes);
+
+	// Path finders
+	int32 NumPathFinders = 0;
+	SIZE_T PathFinderBytes = 0;
+	for (const UMassTrafficPathFollower* PathFollower : TObjectRange<UMassTrafficPathFollower>())
+	{
+		if (PathFollower->GetWorld() == GetWorld())
+		{
+			++NumPathFinders;
+			PathFinderBytes += PathFollower->GetPathFinder().GetAllocatedSize();
+		}
+	}
+	AddRow(TEXT("PathFinder"), TEXT("LaneNodes"), NumPathFinders, PathFinderBytes);
+
+	// Traffic archetypes, with their chunk memory attributed to fragment types and simulation LOD buckets by entity
+	// count. Archetypes without an LOD tag (e.g: with archetype stable simulation LOD) are reported under 'Any'.
+#if WITH_MASSENTITY_DEBUG
+	if (EntityManager)
+	{
+		FMassTagBitSet TrafficTags;
+		TrafficTags.Add<FMassTrafficVehicleTag>();
+		TrafficTags.Add<FMassTrafficVehicleTrailerTag>();
+		TrafficTags.Add<FMassTrafficParkedVehicleTag>();
+		TrafficTags.Add<FMassTrafficRecyclableVehicleTag>();
+		TrafficTags.Add<FMassTrafficMesoscopicVehicleTag>();
+		TrafficTags.Add<FMassTrafficIntersectionTag>();
+
+		TMap<const UScriptStruct*, TPair<int32, SIZE_T>> FragmentTotals;
+		TMap<FString, TPair<int32, SIZE_T>> LODBucketTotals;
+		int32 ArchetypeIndex = 0;
+		for (const FMassArchetypeHandle& ArchetypeHandle : FMassDebugger::GetAllArchetypes(*EntityManager))
+		{
+			const FMassArchetypeCompositionDescriptor& Composition = FMassDebugger::GetArchetypeComposition(ArchetypeHandle);
+			if (!Composition.Tags.HasAny(TrafficTags))
+			{
+				continue;
+			}
+
+			UE::Mass::Debug::FArchetypeStats ArchetypeStats;
+			FMassDebugger::GetArchetypeEntityStats(ArchetypeHandle, ArchetypeStats);
+			if (ArchetypeStats.ChunksCount == 0)
+			{
+				continue;
+			}
+
+			const TCHAR* LODBucket = Composition.Tags.Contains<FMassHighLODTag>() ? TEXT("High")
+				: Composition.Tags.Contains<FMassMediumLODTag>() ? TEXT("Medium")
+				: Composition.Tags.Contains<FMassLowLODTag>() ? TEXT("Low")
+				: Composition.Tags.Contains<FMassOffLODTag>() ? TEXT("Off")
+				: TEXT("Any");
+
+			AddRow(TEXT("Archetype"), FString::Printf(TEXT("Archetype%d.%s (%d chunks, %d bytes/entity)"), ArchetypeIndex++, LODBucket, ArchetypeStats.ChunksCount, ArchetypeStats.BytesPerEntity), ArchetypeStats.EntitiesCount, ArchetypeStats.AllocatedSize);
+
+			TPair<int32, SIZE_T>& LODBucketTotal = LODBucketTotals.FindOrAdd(LODBucket);
+			LODBucketTotal.Key += ArchetypeStats.EntitiesCount;
+			LODBucketTotal.Value += ArchetypeStats.AllocatedSize;
+
+			TArray<const UScriptStruct*> FragmentTypes;
+			Composition.Fragments.ExportTypes(FragmentTypes);
+			for (const UScriptStruct* FragmentType : FragmentTypes)
+			{
+				TPair<int32, SIZE_T>& FragmentTotal = FragmentTotals.FindOrAdd(FragmentType);
+				FragmentTotal.Key += ArchetypeStats.EntitiesCount;
+				FragmentTotal.Value += static_cast<SIZE_T>(FragmentType->GetStructureSize()) * ArchetypeStats.EntitiesCount;
+			}
+		}
+
+		FragmentTotals.ValueSort([](const TPair<int32, SIZE_T>& A, const TPair<int32, SIZE_T>& B) { return A.Value > B.Value; });
+		for (const TPair<const UScriptStruct*, TPair<int32, SIZE_T>>& FragmentTotal : FragmentTotals)
+		{
+			AddRow(TEXT("Fragment"), FragmentTotal.Key->GetName(), FragmentTotal.Value.Key, FragmentTotal.Value.Value);
+		}
+		for (const TPair<FString, TPair<int32, SIZE_T>>& LODBucketTotal : LODBucketTotals)
+		{
+			AddRow(TEXT("LOD"), LODBucketTotal.Key, LODBucketTotal.Value.Key, LODBucketTotal.Value.Value);
+		}
+	}
+#else
+	Ar.Logf(TEXT("Archetype, fragment & LOD breakdown requires WITH_MASSENTITY_DEBUG"));
+#endif
+
+	// Output
+	SIZE_T TableBytes = 0;
+	Ar.Logf(TEXT("%-14s %-64s %10s %12s"), TEXT("Category"), TEXT("Name"), TEXT("Count"), TEXT("KiB"));
+	for (const FMemoryReportRow& Row : Rows)
+	{
+		Ar.Logf(TEXT("%-14s %-64s %10d %12.1f"), *Row.Category, *Row.Name, Row.Count, Row.Bytes / 1024.0);
+		if (Row.Category != TEXT("Archetype") && Row.Category != TEXT("Fragment") && Row.Category != TEXT("LOD") && Row.Category != TEXT("Lane"))
+		{
+			TableBytes += Row.Bytes;
+		}
+	}
+	Ar.Logf(TEXT("Total traffic tables (excluding entity chunks): %.1f KiB"), TableBytes / 1024.0);
+
+	if (bWriteCSV)
+	{
+		FString CSV = TEXT("Category,Name,Count,Bytes\n");
+		for (const FMemoryReportRow& Row : Rows)
+		{
+			CSV += FString::Printf(TEXT("%s,\"%s\",%d,%llu\n"), *Row.Category, *Row.Name, Row.Count, static_cast<uint64>(Row.Bytes));
+		}
+
+		const FString CSVPath = FPaths::ProfilingDir() / TEXT("MassTraffic") / FString::Printf(TEXT("MemoryReport-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(CSV, *CSVPath))
+		{
+			Ar.Logf(TEXT("Wrote %s"), *CSVPath);
+		}
+		else
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Failed to write %s"), *CSVPath);
+		}
+	}
+}
+
 void MassTrafficDumpLaneStats(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
 {
 	// Get subsystems
@@ -930,6 +1467,20 @@ void MassTrafficDumpLaneStats(const TArray<FString>& Args, UWorld* InWorld, FOut
 	}
 }
 
+void MassTrafficDumpMemory(const TArray<FString>& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	if (const UMassTrafficSubsystem* MassTrafficSubsystem = UWorld::GetSubsystem<UMassTrafficSubsystem>(InWorld))
+	{
+		const bool bWriteCSV = Args.Contains(TEXT("CSV"));
+		int32 NumTopLanes = 10;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("TopLanes="), NumTopLanes);
+		}
+		MassTrafficSubsystem->DumpMemory(Ar, bWriteCSV, NumTopLanes);
+	}
+}
+
 void MassTrafficLaneBugItHelper(const TArray< FString >& Args, UWorld* InWorld, FOutputDevice& Ar, bool bGo)
 {
 	// Get subsystems
@@ -1026,12 +1577,86 @@ void MassTrafficLaneBugItGo(const TArray< FString >& Args, UWorld* InWorld, FOut
 	MassTrafficLaneBugItHelper(Args, InWorld, Ar, /*bGo*/true);
 }
 
+void MassTrafficBenchmarkObstacleExclusion(const TArray< FString >& Args, UWorld* InWorld, FOutputDevice& Ar)
+{
+	// Args: [NumLocations] [NumObstacles] [ExclusionRadius] [Extent]
+	const int32 NumLocations = Args.IsValidIndex(0) && Args[0].IsNumeric() ? FCString::Atoi(*Args[0]) : 100000;
+	const int32 NumObstacles = Args.IsValidIndex(1) && Args[1].IsNumeric() ? FCString::Atoi(*Args[1]) : 1000;
+	const float ExclusionRadius = Args.IsValidIndex(2) && Args[2].IsNumeric() ? FCString::Atof(*Args[2]) : 2000.0f;
+	const float Extent = Args.IsValidIndex(3) && Args[3].IsNumeric() ? FCString::Atof(*Args[3]) : 500000.0f;
+
+	// Fixed seed so runs are comparable
+	FRandomStream RandomStream(1234);
+	auto RandomLocation = [&RandomStream, Extent]()
+	{
+		return FVector(RandomStream.FRandRange(-Extent, Extent), RandomStream.FRandRange(-Extent, Extent), RandomStream.FRandRange(-1000.0f, 1000.0f));
+	};
+
+	TArray<FVector> Locations;
+	Locations.Reserve(NumLocations);
+	for (int32 Index = 0; Index < NumLocations; ++Index)
+	{
+		Locations.Add(RandomLocation());
+	}
+
+	TArray<FVector> ObstacleLocations;
+	ObstacleLocations.Reserve(NumObstacles);
+	for (int32 Index = 0; Index < NumObstacles; ++Index)
+	{
+		ObstacleLocations.Add(RandomLocation());
+	}
+
+	// Brute force, as the spawn data generators used to
+	const double BruteForceStartTime = FPlatformTime::Seconds();
+	const float ExclusionRadiusSquared = FMath::Square(ExclusionRadius);
+	TBitArray<> BruteForceExcluded(false, NumLocations);
+	for (int32 Index = 0; Index < NumLocations; ++Index)
+	{
+		for (const FVector& ObstacleLocation : ObstacleLocations)
+		{
+			if (FVector::DistSquared(Locations[Index], ObstacleLocation) < ExclusionRadiusSquared)
+			{
+				BruteForceExcluded[Index] = true;
+				break;
+			}
+		}
+	}
+	const double BruteForceSeconds = FPlatformTime::Seconds() - BruteForceStartTime;
+
+	// Spatial hash, including its construction
+	const double GridStartTime = FPlatformTime::Seconds();
+	const UE::MassTraffic::FObstacleExclusionGrid ObstacleExclusionGrid(ObstacleLocations, ExclusionRadius);
+	TBitArray<> GridExcluded(false, NumLocations);
+	for (int32 Index = 0; Index < NumLocations; ++Index)
+	{
+		GridExcluded[Index] = ObstacleExclusionGrid.IsExcluded(Locations[Index]);
+	}
+	const double GridSeconds = FPlatformTime::Seconds() - GridStartTime;
+
+	int32 NumExcluded = 0;
+	int32 NumMismatches = 0;
+	for (int32 Index = 0; Index < NumLocations; ++Index)
+	{
+		NumExcluded += BruteForceExcluded[Index] ? 1 : 0;
+		NumMismatches += BruteForceExcluded[Index] != GridExcluded[Index] ? 1 : 0;
+	}
+
+	Ar.Logf(TEXT("Obstacle exclusion: %d locations x %d obstacles, radius %.1f, extent %.1f. %d excluded, %d mismatches"), NumLocations, NumObstacles, ExclusionRadius, Extent, NumExcluded, NumMismatches);
+	Ar.Logf(TEXT("Brute force: %.3f ms\nSpatial hash: %.3f ms (%.1fx)"), BruteForceSeconds * 1000.0, GridSeconds * 1000.0, GridSeconds > 0.0 ? BruteForceSeconds / GridSeconds : 0.0);
+}
+
 static FAutoConsoleCommand MassTrafficDumpLaneStatsCmd(
 	TEXT("MassTraffic.DumpLaneStats"),
 	TEXT("Dumps current zone graph lane lengths"),
 	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(MassTrafficDumpLaneStats)
 );
 
+static FAutoConsoleCommand MassTrafficDumpMemoryCmd(
+	TEXT("MassTraffic.DumpMemory"),
+	TEXT("Dumps memory used by traffic lane & intersection tables, path finders and traffic archetypes by fragment type and LOD, and the lanes using the most memory. Pass CSV to also write a CSV to the profiling directory, and TopLanes=N to list N lanes (default 10)"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(MassTrafficDumpMemory)
+);
+
 static FAutoConsoleCommand MassTrafficLaneBugItCmd(
 	TEXT("MassTraffic.LaneBugIt"),
 	TEXT("Logs a BugItGo for the given zone graph lane index"),
@@ -1043,3 +1668,9 @@ static FAutoConsoleCommand MassTrafficLaneBugItGoCmd(
 	TEXT("Logs & performs a BugItGo for the given zone graph lane index"),
 	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(MassTrafficLaneBugItGo)
 );
+
+static FAutoConsoleCommand MassTrafficBenchmarkObstacleExclusionCmd(
+	TEXT("MassTraffic.BenchmarkObstacleExclusion"),
+	TEXT("Times spawn location obstacle exclusion, brute force vs spatial hash, on random data. Args: [NumLocations=100000] [NumObstacles=1000] [ExclusionRadius=2000] [Extent=500000]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(MassTrafficBenchmarkObstacleExclusion)
+);
@@ -63,7 +63,7 @@ void UMassTrafficTrailerSimulationTrait::BuildTemplate(FMassEntityTemplateBuildC
 	if (Params.PhysicsVehicleTemplateActor)
 	{
 		// Extract physics setup from PhysicsVehicleTemplateActor into shared fragment
-		const FMassTrafficSimpleVehiclePhysicsTemplate* Template = MassTrafficSubsystem->GetOrExtractVehiclePhysicsTemplate(Params.PhysicsVehicleTemplateActor);
+		const FMassTrafficSimpleVehiclePhysicsTemplate* Template = MassTrafficSubsystem->GetOrExtractVehiclePhysicsTemplate(Params.PhysicsVehicleTemplateActor, Params.PhysicsVehicleData);
 
 		// Register & add shared fragment
 		if (LIKELY(!BuildContext.IsInspectingData()))
@@ -58,6 +58,7 @@ void UMassTrafficTrailerUpdateCustomVisualizationProcessor::ConfigureQueries(con
 
 	EntityQuery.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddRequirement<FMassTrafficConstrainedVehicleFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.SetChunkFilter(&FMassVisualizationChunkFragment::AreAnyEntitiesVisibleInChunk);
 #if ENABLE_VISUAL_LOG
@@ -72,17 +73,19 @@ void UMassTrafficTrailerUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 	// 
 	// Otherwise the total mesh instance count (e.g: 7 traffic + 3 parked) would be mismatched with the
 	// total custom data count (e.g: 7 traffic + 0 parked)
-	EntityQuery.ForEachEntityChunk(ExecutionContext, [this, &EntityManager](FMassExecutionContext& QueryContext)
+	//
+	// Chunks are processed on worker threads, gathering ISM instances to be added to the representation subsystem
+	// afterwards on the game thread, and deferring all actor updates. (See all PARALLELISMGATHER.)
+	UE::MassTraffic::ForEachVisualizationEntityChunk(EntityQuery, ExecutionContext, [this, &EntityManager](FMassExecutionContext& QueryContext)
 	{
-		UMassRepresentationSubsystem* RepresentationSubsystem = QueryContext.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
-		check(RepresentationSubsystem);
-		FMassInstancedStaticMeshInfoArrayView ISMInfo = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+		TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData>::FChunkInstances ChunkInstances = InstanceGatherer.BeginChunk(QueryContext);
 
 		const TConstArrayView<FMassTrafficConstrainedVehicleFragment> ConstrainedVehicleFragments = QueryContext.GetFragmentView<FMassTrafficConstrainedVehicleFragment>();
 		const TConstArrayView<FMassTrafficRandomFractionFragment> RandomFractionFragments = QueryContext.GetFragmentView<FMassTrafficRandomFractionFragment>();
 		const TConstArrayView<FMassRepresentationLODFragment> RepresentationLODFragments = QueryContext.GetFragmentView<FMassRepresentationLODFragment>();
 		const TConstArrayView<FTransformFragment> TransformFragments = QueryContext.GetFragmentView<FTransformFragment>();
 		const TConstArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = QueryContext.GetFragmentView<FMassTrafficVehiclePhysicsFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
 		const TArrayView<FMassRepresentationFragment> RepresentationFragments = QueryContext.GetMutableFragmentView<FMassRepresentationFragment>();
 		const TArrayView<FMassActorFragment> ActorFragments = QueryContext.GetMutableFragmentView<FMassActorFragment>();
 		
@@ -116,46 +119,48 @@ void UMassTrafficTrailerUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 							Actor->SetActorTransform(NewActorTransform);
 						});
 						
-						// Has simple vehicle physics?
-						if (!SimpleVehiclePhysicsFragments.IsEmpty())
+						// Has active simple vehicle physics? Fragments may be kept, inactive, below Medium LOD. (See all ARCHETYPESTABLELOD.)
+						if (!SimpleVehiclePhysicsFragments.IsEmpty() && SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
 						{
-							// Has a UMassTrafficVehicleComponent with wheel mesh references? 
-							UMassTrafficVehicleComponent* MassTrafficVehicleComponent = Actor->FindComponentByClass<UMassTrafficVehicleComponent>();
-							if (MassTrafficVehicleComponent)
+							// Update wheel component transforms from simple vehicle physics sim, if there's a
+							// UMassTrafficVehicleComponent with wheel mesh references. This is looked up in the
+							// deferred command as we may be on a worker thread here.
+							// This should be safe to reference SimpleVehiclePhysicsFragment directly as
+							// we should be done writing to the VehicleSim this frame.
+							QueryContext.Defer().PushCommand<FMassDeferredSetCommand>([Actor, Entity = QueryContext.GetEntity(EntityIt)](FMassEntityManager& CallbackEntitySubsystem)
 							{
-								// Update wheel component transforms from simple vehicle physics sim.
-								// This should be safe to reference SimpleVehiclePhysicsFragment directly as
-								// we should be done writing to the VehicleSim this frame.
-								QueryContext.Defer().PushCommand<FMassDeferredSetCommand>([MassTrafficVehicleComponent, Entity = QueryContext.GetEntity(EntityIt)](FMassEntityManager& CallbackEntitySubsystem)
+								UMassTrafficVehicleComponent* MassTrafficVehicleComponent = Actor->FindComponentByClass<UMassTrafficVehicleComponent>();
+								if (MassTrafficVehicleComponent && CallbackEntitySubsystem.IsEntityValid(Entity))
 								{
-									if (CallbackEntitySubsystem.IsEntityValid(Entity))
+									// If the simulation LOD changed this frame, removal of the
+									// FDataFragment_SimpleVehiclePhysics would have been queued and executed 
+									// before this deferred command, thus actually removing the fragment we
+									// thought we had via the check above. So we safely check again here for
+									// FDataFragment_SimpleVehiclePhysics using an FMassEntityView    
+									const FMassTrafficVehiclePhysicsFragment* SimpleVehiclePhysicsFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>(Entity);
+									const FMassTrafficSimulationLODFragment* SimulationLODFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficSimulationLODFragment>(Entity);
+									if (SimpleVehiclePhysicsFragment && SimulationLODFragment && SimulationLODFragment->IsMediumLODSimulationActive())
 									{
-										// If the simulation LOD changed this frame, removal of the
-										// FDataFragment_SimpleVehiclePhysics would have been queued and executed 
-										// before this deferred command, thus actually removing the fragment we
-										// thought we had via the check above. So we safely check again here for
-										// FDataFragment_SimpleVehiclePhysics using an FMassEntityView    
-										const FMassTrafficVehiclePhysicsFragment* SimpleVehiclePhysicsFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>(Entity);
-										if (SimpleVehiclePhysicsFragment)
+										// Init offsets?
+										if (MassTrafficVehicleComponent->WheelOffsets.IsEmpty())
 										{
-											// Init offsets?
-											if (MassTrafficVehicleComponent->WheelOffsets.IsEmpty())
-											{
-												MassTrafficVehicleComponent->InitWheelAttachmentOffsets(SimpleVehiclePhysicsFragment->VehicleSim);
-											}
-							
-											// Update
-											MassTrafficVehicleComponent->UpdateWheelComponents(SimpleVehiclePhysicsFragment->VehicleSim);
+											MassTrafficVehicleComponent->InitWheelAttachmentOffsets(SimpleVehiclePhysicsFragment->VehicleSim);
 										}
+						
+										// Update
+										MassTrafficVehicleComponent->UpdateWheelComponents(SimpleVehiclePhysicsFragment->VehicleSim);
 									}
-								});
-							}
+								}
+							});
 						}
 
 						// Update primitive component custom data
-						Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/true, [&PackedCustomData](UPrimitiveComponent* PrimitiveComponent)
+						QueryContext.Defer().PushCommand<FMassDeferredSetCommand>([Actor, PackedCustomData](FMassEntityManager&)
 						{
-							PrimitiveComponent->SetCustomPrimitiveDataFloat(/*DataIndex*/1, PackedCustomData.PackedParam1);
+							Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/true, [&PackedCustomData](UPrimitiveComponent* PrimitiveComponent)
+							{
+								PrimitiveComponent->SetCustomPrimitiveDataFloat(/*DataIndex*/1, PackedCustomData.PackedParam1);
+							});
 						});
 					}
 
@@ -163,10 +168,9 @@ void UMassTrafficTrailerUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 				}
 				case EMassRepresentationType::StaticMeshInstance:
 				{
-					// Add batched instance transform & custom data
-					ISMInfo[RepresentationFragment.StaticMeshDescHandle.ToIndex()].AddBatchedTransform(QueryContext.GetEntity(EntityIt)
-						, TransformFragment.GetTransform(), RepresentationFragment.PrevTransform, RepresentationLODFragment.LODSignificance);
-					ISMInfo[RepresentationFragment.StaticMeshDescHandle.ToIndex()].AddBatchedCustomData(PackedCustomData, RepresentationLODFragment.LODSignificance);
+					// Gather batched instance transform & custom data
+					ChunkInstances.Instances.Add({ QueryContext.GetEntity(EntityIt), RepresentationFragment.StaticMeshDescHandle
+						, TransformFragment.GetTransform(), RepresentationFragment.PrevTransform, RepresentationLODFragment.LODSignificance, PackedCustomData });
 
 					break;
 				}
@@ -178,8 +182,12 @@ void UMassTrafficTrailerUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 			
 			RepresentationFragment.PrevTransform = TransformFragment.GetTransform();
 		}
+
+		InstanceGatherer.EndChunk(MoveTemp(ChunkInstances));
 	});
 
+	InstanceGatherer.AddBatchedInstances();
+
 #if ENABLE_VISUAL_LOG
 	
 	// Debug draw current visualization
@@ -3,6 +3,7 @@
 #include "MassTrafficTypes.h"
 #include "MassTrafficFragments.h"
 #include "MassTrafficDebugHelpers.h"
+#include "MassTrafficSettings.h"
 #include "MassTrafficSubsystem.h"
 
 #include "MassCommonFragments.h"
@@ -20,12 +21,17 @@ FZoneGraphTrafficLaneData::FZoneGraphTrafficLaneData():
 	bIsStoppedVehicleInPreviousLaneOverlappingThisLane(false),
 	bIsVehicleReadyToUseLane(false),
 	bIsEmergencyLane(false),
+	bIsMesoscopic(false),
+	bIsInViewerFrustum(false),
 	MaxDensity(1.0f)
 {
 }
 
 void FZoneGraphTrafficLaneData::ClearVehicles()
 {
+	// Drop aggregated vehicles first, so they are cleared from the lane's occupancy too
+	MesoscopicVehicles.Reset();
+	MesoscopicInflow.Reset();
 	ClearVehicleOccupancy();
 		
 	TailVehicle = FMassEntityHandle();
@@ -37,6 +43,10 @@ void FZoneGraphTrafficLaneData::ClearVehicles()
 	NumVehiclesLaneChangingOntoLane = 0;
 	NumVehiclesLaneChangingOffOfLane = 0;
 	NumReservedVehiclesOnLane = 0;
+	MesoscopicOutflow = 0.0f;
+	MesoscopicSpeed = 0.0f;
+	MesoscopicFlow = 0.0f;
+	WakeQueueSleepingVehicles();
 }
 
 void FZoneGraphTrafficLaneData::ForEachVehicleOnLane(const FMassEntityManager& EntityManager, FTrafficVehicleExecuteFunction Function) const
@@ -91,8 +101,25 @@ void FZoneGraphTrafficLaneData::ForEachVehicleOnLane(const FMassEntityManager& E
 
 void FZoneGraphTrafficLaneData::ClearVehicleOccupancy()
 {
-	NumVehiclesOnLane = 0;
+	// Vehicles aggregated on this lane still occupy it. (See all MESOSCOPIC.)
+	const int32 NumMesoscopicVehicles = GetNumMesoscopicVehicles();
+
+	if (DensityGrid)
+	{
+		DensityGrid->AddVehicles(DensityGridCell, NumMesoscopicVehicles - NumVehiclesOnLane);
+	}
+
+	NumVehiclesOnLane = NumMesoscopicVehicles;
 	SpaceAvailable = Length;
+	if (NumMesoscopicVehicles > 0)
+	{
+		SpaceAvailable -= NumMesoscopicVehicles * GetDefault<UMassTrafficSettings>()->MesoscopicVehicleSpacing;
+	}
+
+	if (DensityBuckets)
+	{
+		DensityBuckets->UpdateLane(*this);
+	}
 }
 
 void FZoneGraphTrafficLaneData::RemoveVehicleOccupancy(const float SpaceToAdd)
@@ -108,12 +135,25 @@ void FZoneGraphTrafficLaneData::RemoveVehicleOccupancy(const float SpaceToAdd)
 	--NumVehiclesOnLane;
 	SpaceAvailable += SpaceToAdd;
 
+	if (DensityGrid)
+	{
+		DensityGrid->AddVehicles(DensityGridCell, -1);
+	}
+
+	// Vehicles queued behind may now be able to move up. (See all QUEUESLEEP.)
+	WakeQueueSleepingVehicles();
+
 	// In case we went over the length, clamp it so we aren't making up space on the lane that
 	// doesn't exist.
 	if (SpaceAvailable > Length)
 	{
 		SpaceAvailable = Length;
 	}
+
+	if (DensityBuckets)
+	{
+		DensityBuckets->UpdateLane(*this);
+	}
 }
 
 void FZoneGraphTrafficLaneData::AddVehicleOccupancy(const float SpaceToRemove)
@@ -124,6 +164,137 @@ void FZoneGraphTrafficLaneData::AddVehicleOccupancy(const float SpaceToRemove)
 	// This is OK. It might happen in lanes changes, when a vehicle changes lanes into a lane that doesn't have enough
 	// room. Space available is allowed to be negative. It's just not allowed to go above the lane length.
 	SpaceAvailable -= SpaceToRemove;
+
+	if (DensityGrid)
+	{
+		DensityGrid->AddVehicles(DensityGridCell, 1);
+	}
+
+	if (DensityBuckets)
+	{
+		DensityBuckets->UpdateLane(*this);
+	}
+}
+
+void FMassTrafficLaneDensityBuckets::UpdateLane(FZoneGraphTrafficLaneData& Lane)
+{
+	auto MoveToBucket = [&Lane](TArray<FZoneGraphTrafficLaneData*>* Buckets, uint8& LaneBucket, int32& LaneBucketSlot, const int32 NewBucket, auto GetMovedLaneSlot)
+	{
+		if (LaneBucketSlot != INDEX_NONE)
+		{
+			if (LaneBucket == NewBucket)
+			{
+				return;
+			}
+
+			// Swap remove from the old bucket, fixing up the slot of the lane swapped into our place
+			TArray<FZoneGraphTrafficLaneData*>& OldBucket = Buckets[LaneBucket];
+			check(OldBucket[LaneBucketSlot] == &Lane);
+			OldBucket.RemoveAtSwap(LaneBucketSlot, EAllowShrinking::No);
+			if (OldBucket.IsValidIndex(LaneBucketSlot))
+			{
+				GetMovedLaneSlot(*OldBucket[LaneBucketSlot]) = LaneBucketSlot;
+			}
+		}
+
+		LaneBucket = static_cast<uint8>(NewBucket);
+		LaneBucketSlot = Buckets[NewBucket].Add(&Lane);
+	};
+
+	MoveToBucket(ExcessDensityBuckets, Lane.ExcessDensityBucket, Lane.ExcessDensityBucketSlot,
+		GetExcessDensityBucket(Lane.BasicDensity() - Lane.MaxDensity),
+		[](FZoneGraphTrafficLaneData& MovedLane) -> int32& { return MovedLane.ExcessDensityBucketSlot; });
+	MoveToBucket(FunctionalDensityBuckets, Lane.FunctionalDensityBucket, Lane.FunctionalDensityBucketSlot,
+		GetFunctionalDensityBucket(Lane.FunctionalDensity()),
+		[](FZoneGraphTrafficLaneData& MovedLane) -> int32& { return MovedLane.FunctionalDensityBucketSlot; });
+}
+
+SIZE_T FMassTrafficLaneDensityBuckets::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		AllocatedSize += ExcessDensityBuckets[Bucket].GetAllocatedSize() + FunctionalDensityBuckets[Bucket].GetAllocatedSize();
+	}
+	return AllocatedSize;
+}
+
+void FMassTrafficLaneDensityBuckets::Reset()
+{
+	// Note: Tracked lanes aren't touched, as this is only done along with resetting the lanes themselves
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		ExcessDensityBuckets[Bucket].Reset();
+		FunctionalDensityBuckets[Bucket].Reset();
+		ExcessDensityBucketScanStarts[Bucket] = 0;
+		FunctionalDensityBucketScanStarts[Bucket] = 0;
+	}
+}
+
+int32 FMassTrafficDensityGrid::FindOrAddCell(const FVector& Location)
+{
+	const FIntPoint CellCoord = GetCellCoord(Location);
+	if (const int32* CellIndex = CellLookup.Find(CellCoord))
+	{
+		return *CellIndex;
+	}
+
+	const int32 CellIndex = Cells.AddDefaulted();
+	CellLookup.Add(CellCoord, CellIndex);
+	return CellIndex;
+}
+
+void FMassTrafficDensityGrid::SampleVehicle(const int32 CellIndex, const float Speed, const float DeltaTime, const float StoppedSpeed)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	FCell& Cell = Cells[CellIndex];
+	if (Cell.SampledTime <= 0.0f)
+	{
+		SampledCells.Add(CellIndex);
+	}
+	Cell.SampledTime += DeltaTime;
+	Cell.SampledSpeedTime += Speed * DeltaTime;
+	if (Speed < StoppedSpeed)
+	{
+		Cell.SampledStoppedTime += DeltaTime;
+	}
+}
+
+void FMassTrafficDensityGrid::UpdateAverages(const float SmoothingTime)
+{
+	for (const int32 CellIndex : SampledCells)
+	{
+		FCell& Cell = Cells[CellIndex];
+
+		// Every vehicle in the cell adds about a second of samples per second, however often it's ticked, so blend
+		// by the sampled time per vehicle to smooth over roughly SmoothingTime seconds
+		const float SampledTimePerVehicle = Cell.SampledTime / FMath::Max(Cell.NumVehicles, 1);
+		const float Alpha = SmoothingTime > 0.0f ? FMath::Min(SampledTimePerVehicle / SmoothingTime, 1.0f) : 1.0f;
+		Cell.AverageSpeed = FMath::Lerp(Cell.AverageSpeed, Cell.SampledSpeedTime / Cell.SampledTime, Alpha);
+		Cell.StoppedFraction = FMath::Lerp(Cell.StoppedFraction, Cell.SampledStoppedTime / Cell.SampledTime, Alpha);
+
+		Cell.SampledTime = 0.0f;
+		Cell.SampledSpeedTime = 0.0f;
+		Cell.SampledStoppedTime = 0.0f;
+	}
+	SampledCells.Reset();
+}
+
+void FMassTrafficDensityGrid::Reset(const float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 100.0f);
+	Cells.Reset();
+	CellLookup.Reset();
+	SampledCells.Reset();
+}
+
+SIZE_T FMassTrafficDensityGrid::GetAllocatedSize() const
+{
+	return Cells.GetAllocatedSize() + CellLookup.GetAllocatedSize() + SampledCells.GetAllocatedSize();
 }
 
 float FZoneGraphTrafficLaneData::SpaceAvailableFromStartOfLaneForVehicle(const FMassEntityManager& EntityManager, const bool bCheckLaneChangeGhostVehicles, const bool bCheckSplittingAndMergingGhostTailVehicles) const 
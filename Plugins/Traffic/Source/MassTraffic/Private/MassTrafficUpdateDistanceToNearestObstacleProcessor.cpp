@@ -27,6 +27,7 @@ UMassTrafficUpdateDistanceToNearestObstacleProcessor::UMassTrafficUpdateDistance
 
 void UMassTrafficUpdateDistanceToNearestObstacleProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) 
 {
+	EntityQuery_Conditional.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	EntityQuery_Conditional.AddRequirement<FMassTrafficNextVehicleFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery_Conditional.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
@@ -222,6 +223,13 @@ void UMassTrafficUpdateDistanceToNearestObstacleProcessor::Execute(FMassEntityMa
 			
 				AvoidanceFragment.DistanceToNext = TNumericLimits<float>::Max();
 
+				// A next vehicle absorbed into a mesoscopic lane has left its lane, so stop following its last location.
+				// (See all MESOSCOPIC.)
+				if (NextVehicleFragment.HasNextVehicle() && FMassEntityView(EntityManager, NextVehicleFragment.GetNextVehicle()).HasTag<FMassTrafficMesoscopicVehicleTag>())
+				{
+					NextVehicleFragment.UnsetNextVehicle();
+				}
+
 				if (NextVehicleFragment.HasNextVehicle())
 				{
 					FMassEntityView NextView(EntityManager, NextVehicleFragment.GetNextVehicle());
@@ -19,7 +19,7 @@ UMassTrafficUpdateTrailersProcessor::UMassTrafficUpdateTrailersProcessor()
 void UMassTrafficUpdateTrailersProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	EntityQuery.AddRequirement<FMassTrafficConstrainedVehicleFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
 	EntityQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadWrite);
@@ -35,7 +35,7 @@ void UMassTrafficUpdateTrailersProcessor::Execute(FMassEntityManager& EntityMana
 	{
 		const FMassTrafficVehiclePhysicsSharedParameters& PhysicsParams = Context.GetConstSharedFragment<FMassTrafficVehiclePhysicsSharedParameters>();
 		const TConstArrayView<FMassTrafficConstrainedVehicleFragment> ConstrainedVehicleFragments = Context.GetFragmentView<FMassTrafficConstrainedVehicleFragment>();
-		const TConstArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = Context.GetFragmentView<FMassTrafficVehiclePhysicsFragment>();
+		const TArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = Context.GetMutableFragmentView<FMassTrafficVehiclePhysicsFragment>();
 		const TArrayView<FTransformFragment> TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
 		const TArrayView<FMassVelocityFragment> VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
 		const TArrayView<FMassTrafficAngularVelocityFragment> AngularVelocityFragments = Context.GetMutableFragmentView<FMassTrafficAngularVelocityFragment>();
@@ -79,13 +79,20 @@ void UMassTrafficUpdateTrailersProcessor::Execute(FMassEntityManager& EntityMana
 							Context.Defer().PushCommand<FMassCommandAddFragmentInstances>(Context.GetEntity(EntityIt), PhysicsParams.Template->SimpleVehiclePhysicsFragmentTemplate);
 						}
 					}
+					// Re-activating the simulation fragment kept from a previous stint at Medium or High LOD? Re-initialize
+					// it in place, exactly as if it had just been added. (See all ARCHETYPESTABLELOD.)
+					else if (bArchetypeStableSimulationLOD && PhysicsParams.Template)
+					{
+						SimpleVehiclePhysicsFragments[EntityIt] = PhysicsParams.Template->SimpleVehiclePhysicsFragmentTemplate;
+					}
 				}
 			}
 			// Low or Off
 			else
 			{
-				// Remove simulation fragment 
-				if (!SimpleVehiclePhysicsFragments.IsEmpty())
+				// Remove simulation fragment, unless it's kept, inactive, along with the vehicle's.
+				// (See all ARCHETYPESTABLELOD.)
+				if (!SimpleVehiclePhysicsFragments.IsEmpty() && !bArchetypeStableSimulationLOD)
 				{
 					Context.Defer().RemoveFragment<FMassTrafficVehiclePhysicsFragment>(Context.GetEntity(EntityIt));
 				}
@@ -96,8 +103,8 @@ void UMassTrafficUpdateTrailersProcessor::Execute(FMassEntityManager& EntityMana
 			// Note: This must be gated based on the presence of the simulation fragments, rather than checking
 			// SimulationLODFragment.LOD, which doesn't happen until the frame after we request their addition above.
 			// This matches TrafficVehicleControl's behaviour of choosing movement methods based on simulation
-			// fragment presence.
-			if (SimpleVehiclePhysicsFragments.IsEmpty())
+			// fragment presence. Fragments kept below Medium LOD are inactive. (See all ARCHETYPESTABLELOD.)
+			if (SimpleVehiclePhysicsFragments.IsEmpty() || !SimulationLODFragment.IsMediumLODSimulationActive())
 			{
 				TransformFragment = VehicleMassEntityView.GetFragmentData<FTransformFragment>();
 				VelocityFragment = VehicleMassEntityView.GetFragmentData<FMassVelocityFragment>();
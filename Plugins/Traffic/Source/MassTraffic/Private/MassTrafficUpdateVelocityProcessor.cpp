@@ -21,7 +21,11 @@ UMassTrafficUpdateVelocityProcessor::UMassTrafficUpdateVelocityProcessor()
 
 void UMassTrafficUpdateVelocityProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	EntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::None);
+	// With archetype stable simulation LOD, vehicles keep PID control fragments below Medium LOD so are instead filtered
+	// per entity. (See all ARCHETYPESTABLELOD.)
+	EntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly, GetDefault<UMassTrafficSettings>()->bArchetypeStableSimulationLOD ? EMassFragmentPresence::Optional : EMassFragmentPresence::None);
+	EntityQuery_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery_Conditional.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	EntityQuery_Conditional.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassTrafficVehicleControlFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassRepresentationFragment>(EMassFragmentAccess::ReadOnly);
@@ -43,9 +47,18 @@ void UMassTrafficUpdateVelocityProcessor::Execute(FMassEntityManager& EntityMana
 			const TConstArrayView<FMassSimulationVariableTickFragment> SimulationVariableTickFragments = Context.GetFragmentView<FMassSimulationVariableTickFragment>();
 			const TArrayView<FMassVelocityFragment> VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
 			const TArrayView<FMassTrafficAngularVelocityFragment> AngularVelocityFragments = Context.GetMutableFragmentView<FMassTrafficAngularVelocityFragment>();
+			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
+			const bool bHasPIDVehicleControl = !Context.GetFragmentView<FMassTrafficPIDVehicleControlFragment>().IsEmpty();
 
 			for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
+				// Skip vehicles with active PID control, kept in this archetype by archetype stable simulation LOD.
+				// (See all ARCHETYPESTABLELOD.)
+				if (bHasPIDVehicleControl && SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+				{
+					continue;
+				}
+
 				const FTransformFragment& TransformFragment = TransformFragments[EntityIt];
 				const FMassTrafficVehicleControlFragment& VehicleControlFragment = VehicleControlFragments[EntityIt];
 				const FMassRepresentationFragment& RepresentationFragment = RepresentationFragments[EntityIt];
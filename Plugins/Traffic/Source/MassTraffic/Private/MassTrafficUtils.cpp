@@ -170,6 +170,39 @@ FVector GetLaneBeginDirection(const uint32 LaneIndex, const FZoneGraphStorage& Z
 	return LaneBeginDirection;
 }
 
+uint32 GetZoneGraphStorageHash(const FZoneGraphStorage& ZoneGraphStorage)
+{
+	uint32 Hash = GetTypeHash(ZoneGraphStorage.Lanes.Num());
+	for (const FZoneLaneData& LaneData : ZoneGraphStorage.Lanes)
+	{
+		// Tags decide which lanes are traffic lanes, and their densities
+		Hash = HashCombineFast(Hash, LaneData.Tags.GetValue());
+		Hash = HashCombineFast(Hash, GetTypeHash(LaneData.PointsBegin));
+		Hash = HashCombineFast(Hash, GetTypeHash(LaneData.PointsEnd));
+	}
+	Hash = FCrc::MemCrc32(ZoneGraphStorage.LanePoints.GetData(), ZoneGraphStorage.LanePoints.Num() * ZoneGraphStorage.LanePoints.GetTypeSize(), Hash);
+	return Hash;
+}
+
+static uint32 GetTagFilterHash(const FZoneGraphTagFilter& TagFilter)
+{
+	uint32 Hash = TagFilter.AnyTags.GetValue();
+	Hash = HashCombineFast(Hash, TagFilter.AllTags.GetValue());
+	Hash = HashCombineFast(Hash, TagFilter.NotTags.GetValue());
+	return Hash;
+}
+
+uint32 GetTrafficLaneSettingsHash(const FZoneGraphTagFilter& LaneFilter, TConstArrayView<FMassTrafficLaneDensity> LaneDensities)
+{
+	uint32 Hash = GetTagFilterHash(LaneFilter);
+	for (const FMassTrafficLaneDensity& LaneDensity : LaneDensities)
+	{
+		Hash = HashCombineFast(Hash, GetTagFilterHash(LaneDensity.LaneFilter));
+		Hash = HashCombineFast(Hash, GetTypeHash(LaneDensity.DensityMultiplier));
+	}
+	return Hash;
+}
+
 FVector GetLaneEndDirection(const uint32 LaneIndex, const FZoneGraphStorage& ZoneGraphStorage) 
 {
 	const FZoneLaneData& LaneData = ZoneGraphStorage.Lanes[LaneIndex];
@@ -226,5 +259,54 @@ LaneTurnType GetLaneTurnType(const uint32 LaneIndex, const FZoneGraphStorage& Zo
 }
 
 
+FObstacleExclusionGrid::FObstacleExclusionGrid(TConstArrayView<FVector> ObstacleLocations, const float InExclusionRadius)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("BuildObstacleExclusionGrid"))
+
+	if (InExclusionRadius <= 0.0f || ObstacleLocations.IsEmpty())
+	{
+		return;
+	}
+
+	ExclusionRadiusSquared = FMath::Square(InExclusionRadius);
+	InvCellSize = 1.0f / InExclusionRadius;
+
+	Cells.Reserve(ObstacleLocations.Num());
+	for (const FVector& ObstacleLocation : ObstacleLocations)
+	{
+		Cells.FindOrAdd(GetCell(ObstacleLocation)).Add(ObstacleLocation);
+	}
+}
+
+bool FObstacleExclusionGrid::IsExcluded(const FVector& Location) const
+{
+	if (Cells.IsEmpty())
+	{
+		return false;
+	}
+
+	// Cells are exclusion radius wide, so any obstacle within range must be in this or an adjacent cell
+	const FIntPoint Cell = GetCell(Location);
+	for (int32 Y = Cell.Y - 1; Y <= Cell.Y + 1; ++Y)
+	{
+		for (int32 X = Cell.X - 1; X <= Cell.X + 1; ++X)
+		{
+			if (const TArray<FVector, TInlineAllocator<4>>* CellObstacleLocations = Cells.Find(FIntPoint(X, Y)))
+			{
+				for (const FVector& ObstacleLocation : *CellObstacleLocations)
+				{
+					if (FVector::DistSquared(Location, ObstacleLocation) < ExclusionRadiusSquared)
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+
 
 }
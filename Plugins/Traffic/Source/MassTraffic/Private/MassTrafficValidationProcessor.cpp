@@ -23,10 +23,12 @@ UMassTrafficValidationProcessor::UMassTrafficValidationProcessor()
 	: EntityQuery_Conditional(*this)
 {
 	ProcessingPhase = EMassProcessingPhase::FrameEnd;
+	TimeSliceBudgetMicroseconds = 500.0f;
 }
 
 void UMassTrafficValidationProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
+	EntityQuery_Conditional.AddTagRequirement<FMassTrafficMesoscopicVehicleTag>(EMassFragmentPresence::None); // (See all MESOSCOPIC.)
 	EntityQuery_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassActorFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery_Conditional.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
@@ -233,8 +235,11 @@ void UMassTrafficValidationProcessor::Execute(FMassEntityManager& EntityManager,
 		}
 	}
 
-	// Vehicle validation
-	EntityQuery_Conditional.ForEachEntityChunk(ExecutionContext, [&](FMassExecutionContext& Context)
+	// Vehicle validation, spread across frames a time slice of entity buckets at a time. Vehicles in chunks not ticking
+	// this frame are skipped as before, and validated on a later pass over their bucket.
+	ForTimeSlicedEntityBuckets(VehicleTimeSliceCursor, [&](const FMassTrafficEntityBucketRange& EntityBuckets)
+	{
+		EntityQuery_Conditional.ForEachEntityChunk(ExecutionContext, [&](FMassExecutionContext& Context)
 		{
 			const UZoneGraphSubsystem& ZoneGraphSubsystem = Context.GetSubsystemChecked<UZoneGraphSubsystem>();
 
@@ -254,6 +259,10 @@ void UMassTrafficValidationProcessor::Execute(FMassEntityManager& EntityManager,
 			for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
 				FMassEntityHandle VehicleEntity = Context.GetEntity(EntityIt);
+				if (!EntityBuckets.Contains(VehicleEntity))
+				{
+					continue;
+				}
 			
 				const FMassTrafficSimulationLODFragment& SimulationLODFragment = SimulationLODFragments[EntityIt];
 				const FMassActorFragment& ActorFragment = ActorFragments[EntityIt];
@@ -379,4 +388,5 @@ void UMassTrafficValidationProcessor::Execute(FMassEntityManager& EntityManager,
 				#endif
 			}
 		});
+	});
 }
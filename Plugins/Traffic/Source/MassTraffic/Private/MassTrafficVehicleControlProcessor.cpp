@@ -16,6 +16,9 @@
 #include "ZoneGraphTypes.h"
 #include "MassTrafficUtils.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queue Sleeping Vehicles"), STAT_Traffic_QueueSleepingVehicles, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Analytic Motion Vehicles"), STAT_Traffic_AnalyticMotionVehicles, STATGROUP_Traffic);
+
 namespace
 {
 	// (See all READYLANE.)
@@ -102,6 +105,220 @@ namespace
 		VehicleControlFragment.bCantStopAtLaneExit = false; // (See all CANTSTOPLANEEXIT.)
 		--VehicleControlFragment.NextLane->NumReservedVehiclesOnLane;
 	}
+
+	// Queue sleeping vehicles still need to react to approaching emergency vehicles, by moving aside for the rescue lane,
+	// and to obstacles they're about to collide with. (See all QUEUESLEEP.)
+	bool IsQueueSleepInterrupted(
+		const FMassTrafficVehicleControlFragment& VehicleControlFragment,
+		const FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+		const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+		const UMassTrafficSettings& MassTrafficSettings)
+	{
+		return VehicleControlFragment.EmergencyOffset != 0.0f ||
+			AvoidanceFragment.TimeToCollidingObstacle < UE::MassTraffic::GeObstacleAvoidanceBrakingTime(RandomFractionFragment.RandomFraction, MassTrafficSettings.ObstacleAvoidanceBrakingTimeRange);
+	}
+
+	// Returns true if the vehicle is queue sleeping and should stay asleep, otherwise wakes it. (See all QUEUESLEEP.)
+	bool UpdateQueueSleeping(
+		FMassTrafficVehicleControlFragment& VehicleControlFragment,
+		const FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+		const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+		const UMassTrafficSettings& MassTrafficSettings,
+		const UMassTrafficSubsystem& MassTrafficSubsystem)
+	{
+		if (!VehicleControlFragment.QueueSleepLaneHandle.IsValid())
+		{
+			return false;
+		}
+
+		const FZoneGraphTrafficLaneData* QueueSleepLane = MassTrafficSubsystem.GetTrafficLaneData(VehicleControlFragment.QueueSleepLaneHandle);
+		if (VehicleControlFragment.IsQueueSleeping(QueueSleepLane) &&
+			!IsQueueSleepInterrupted(VehicleControlFragment, AvoidanceFragment, RandomFractionFragment, MassTrafficSettings))
+		{
+			return true;
+		}
+
+		VehicleControlFragment.WakeFromQueueSleep();
+		return false;
+	}
+
+	// Vehicles stopped in a queue behind another stopped vehicle go to sleep, skipping vehicle control entirely, until
+	// their lane wakes them. Lanes wake all their queue sleeping vehicles when a stopped vehicle on the lane pulls away
+	// or any vehicle leaves the lane. Vehicles are also woken individually by emergency vehicles and obstacles.
+	// @see IsQueueSleepInterrupted
+	// (See all QUEUESLEEP.)
+	void UpdateQueueSleep(
+		FMassTrafficVehicleControlFragment& VehicleControlFragment,
+		FZoneGraphTrafficLaneData* CurrentLane,
+		const FMassZoneGraphLaneLocationFragment& LaneLocationFragment,
+		const FMassTrafficNextVehicleFragment& NextVehicleFragment,
+		const float TargetSpeed,
+		const bool bCanQueueSleep,
+		const FMassEntityManager& EntityManager)
+	{
+		// Only stopped vehicles affect the queue
+		if (!CurrentLane || VehicleControlFragment.Speed >= GMassTrafficQueueSleepSpeedThreshold)
+		{
+			return;
+		}
+
+		// Pulling away? Wake the vehicles queued up behind us.
+		if (TargetSpeed >= GMassTrafficQueueSleepSpeedThreshold)
+		{
+			CurrentLane->WakeQueueSleepingVehicles();
+			return;
+		}
+
+		if (!GMassTrafficQueueSleepEnabled || !bCanQueueSleep || !NextVehicleFragment.HasNextVehicle())
+		{
+			return;
+		}
+
+		// Is the next vehicle on this lane and stopped too?
+		const FMassEntityView NextVehicleEntityView(EntityManager, NextVehicleFragment.GetNextVehicle());
+		const FMassZoneGraphLaneLocationFragment& NextLaneLocationFragment = NextVehicleEntityView.GetFragmentData<FMassZoneGraphLaneLocationFragment>();
+		const FMassTrafficVehicleControlFragment& NextVehicleControlFragment = NextVehicleEntityView.GetFragmentData<FMassTrafficVehicleControlFragment>();
+		if (NextLaneLocationFragment.LaneHandle != LaneLocationFragment.LaneHandle ||
+			NextVehicleControlFragment.Speed >= GMassTrafficQueueSleepSpeedThreshold)
+		{
+			return;
+		}
+
+		// The next vehicle must either be queue sleeping itself, or be the head of the queue, stopped at the front of
+		// the lane waiting for a closed lane exit.
+		bool bIsNextVehicleQueued = NextVehicleControlFragment.IsQueueSleeping(CurrentLane);
+		if (!bIsNextVehicleQueued && NextVehicleControlFragment.NextLane && !NextVehicleControlFragment.NextLane->bIsOpen)
+		{
+			const FMassTrafficNextVehicleFragment& NextNextVehicleFragment = NextVehicleEntityView.GetFragmentData<FMassTrafficNextVehicleFragment>();
+			bIsNextVehicleQueued = !NextNextVehicleFragment.HasNextVehicle() ||
+				EntityManager.GetFragmentDataChecked<FMassZoneGraphLaneLocationFragment>(NextNextVehicleFragment.GetNextVehicle()).LaneHandle != LaneLocationFragment.LaneHandle;
+		}
+
+		if (bIsNextVehicleQueued)
+		{
+			VehicleControlFragment.QueueSleep(*CurrentLane);
+		}
+	}
+
+
+	// (See all ANALYTICMOTION.)
+	void StartAnalyticMotion(
+		FMassTrafficAnalyticMotionFragment& AnalyticMotionFragment,
+		const FMassTrafficVehicleControlFragment& VehicleControlFragment,
+		const FMassZoneGraphLaneLocationFragment& LaneLocationFragment,
+		const FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+		const FAgentRadiusFragment& RadiusFragment,
+		const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+		const UMassTrafficSettings& MassTrafficSettings,
+		const float TargetSpeed)
+	{
+		// The trajectory is only valid up to where the speed limit starts blending into the next lanes', the vehicle
+		// could start braking for the lane exit, or starts marking its next intersection lane as ready to use.
+		// (See all READYLANE.)
+		const float DistanceAlongLaneToStopAt = UE::MassTraffic::GetDistanceAlongLaneToStopAt(RadiusFragment.Radius, LaneLocationFragment.LaneLength, RandomFractionFragment.RandomFraction, MassTrafficSettings.StoppingDistanceRange);
+		const float DistanceAlongLaneToBrakeFrom = UE::MassTraffic::GetDistanceAlongLaneToBrakeFrom(TargetSpeed, RadiusFragment.Radius, LaneLocationFragment.LaneLength, MassTrafficSettings.StopSignBrakingTime, DistanceAlongLaneToStopAt);
+		const float DistanceAlongLaneToBlendSpeedLimitFrom = LaneLocationFragment.LaneLength - TargetSpeed * MassTrafficSettings.SpeedLimitBlendTime;
+		const float EndDistance = FMath::Min3(DistanceAlongLaneToBrakeFrom, DistanceAlongLaneToStopAt - 150.0f/*1m safety fudge*/, DistanceAlongLaneToBlendSpeedLimitFrom);
+		if (LaneLocationFragment.DistanceAlongLane >= EndDistance)
+		{
+			return;
+		}
+
+		// Braking down to a lower target speed is left to full vehicle control, which also drives the brake lights
+		if (VehicleControlFragment.Speed > TargetSpeed + 1.0f)
+		{
+			return;
+		}
+
+		// The next vehicle must already be beyond the distance we'd start braking for it at
+		const float MinimumDistanceToNextVehicle = UE::MassTraffic::GetMinimumDistanceToObstacle(RandomFractionFragment.RandomFraction, MassTrafficSettings.MinimumDistanceToNextVehicleRange);
+		const float IdealDistanceToNextVehicle = UE::MassTraffic::GetIdealDistanceToObstacle(TargetSpeed, RandomFractionFragment.RandomFraction, MassTrafficSettings.IdealTimeToNextVehicleRange, MinimumDistanceToNextVehicle);
+		if (AvoidanceFragment.DistanceToNext < IdealDistanceToNextVehicle)
+		{
+			return;
+		}
+
+		AnalyticMotionFragment.Time = 0.0f;
+		AnalyticMotionFragment.StartDistance = LaneLocationFragment.DistanceAlongLane;
+		AnalyticMotionFragment.ResolvedDistanceAlongLane = LaneLocationFragment.DistanceAlongLane;
+		AnalyticMotionFragment.MinDistanceToNext = IdealDistanceToNextVehicle;
+		AnalyticMotionFragment.LaneHandle = LaneLocationFragment.LaneHandle;
+		AnalyticMotionFragment.NextLane = VehicleControlFragment.NextLane;
+		AnalyticMotionFragment.StartSpeed = VehicleControlFragment.Speed;
+		if (FMath::IsNearlyEqual(VehicleControlFragment.Speed, TargetSpeed, 1.0f))
+		{
+			// Already at target speed, so just cruise
+			AnalyticMotionFragment.TargetSpeed = VehicleControlFragment.Speed;
+			AnalyticMotionFragment.Acceleration = 0.0f;
+		}
+		else
+		{
+			AnalyticMotionFragment.TargetSpeed = TargetSpeed;
+			AnalyticMotionFragment.Acceleration = MassTrafficSettings.Acceleration * (1.0f + MassTrafficSettings.AccelerationVariancePct * (RandomFractionFragment.RandomFraction * 2.0f - 1.0f));
+		}
+		AnalyticMotionFragment.EndTime = AnalyticMotionFragment.GetTimeAtDistance(EndDistance);
+	}
+
+	
+	// Advances a vehicle along its closed form free flow trajectory, returning false if the trajectory is no longer
+	// valid and full vehicle control is needed. (See all ANALYTICMOTION.)
+	bool AdvanceAnalyticMotion(
+		FMassTrafficAnalyticMotionFragment& AnalyticMotionFragment,
+		FMassTrafficVehicleControlFragment& VehicleControlFragment,
+		FMassZoneGraphLaneLocationFragment& LaneLocationFragment,
+		FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+		const FMassTrafficVehicleLaneChangeFragment* LaneChangeFragment,
+		const float ObstacleAvoidanceBrakingTime,
+		const float DeltaTime)
+	{
+		// Has the vehicle been moved by something else since we last advanced it? (e.g: lane changing, or re-spawned,
+		// possibly at the same distance along another lane)
+		if (LaneLocationFragment.LaneHandle != AnalyticMotionFragment.LaneHandle ||
+			!FMath::IsNearlyEqual(LaneLocationFragment.DistanceAlongLane, AnalyticMotionFragment.ResolvedDistanceAlongLane, 1.0f) ||
+			(LaneChangeFragment && LaneChangeFragment->IsLaneChangeInProgress()) ||
+			VehicleControlFragment.EmergencyOffset != 0.0f)
+		{
+			return false;
+		}
+
+		// Has the next vehicle or an obstacle come within braking distance?
+		if (AvoidanceFragment.DistanceToNext < AnalyticMotionFragment.MinDistanceToNext ||
+			AvoidanceFragment.TimeToCollidingObstacle < ObstacleAvoidanceBrakingTime)
+		{
+			return false;
+		}
+
+		// Has the next lane changed, or is it closing?
+		const FZoneGraphTrafficLaneData* NextLane = VehicleControlFragment.NextLane;
+		if (!NextLane || NextLane != AnalyticMotionFragment.NextLane || !NextLane->bIsOpen || NextLane->bIsAboutToClose)
+		{
+			return false;
+		}
+
+		// Has the trajectory reached where braking for the lane exit could begin?
+		AnalyticMotionFragment.Time += DeltaTime;
+		if (AnalyticMotionFragment.Time >= AnalyticMotionFragment.EndTime)
+		{
+			return false;
+		}
+
+		// Resolve the trajectory into the lane location & speed read this tick by interpolation, obstacle avoidance and
+		// lane changing
+		float DistanceAlongLane;
+		float Speed;
+		AnalyticMotionFragment.Evaluate(DistanceAlongLane, Speed);
+		AnalyticMotionFragment.ResolvedDistanceAlongLane = DistanceAlongLane;
+
+		const float DistanceDelta = DistanceAlongLane - LaneLocationFragment.DistanceAlongLane;
+		LaneLocationFragment.DistanceAlongLane = DistanceAlongLane;
+		VehicleControlFragment.Speed = Speed;
+		VehicleControlFragment.NoiseInput += DistanceDelta;
+
+		// Speculatively close the gap to the next vehicle, as SimpleVehicleControl does
+		AvoidanceFragment.DistanceToNext = FMath::Max(AvoidanceFragment.DistanceToNext - DistanceDelta, 0.0f);
+
+		return true;
+	}
 }
 
 
@@ -119,7 +336,10 @@ UMassTrafficVehicleControlProcessor::UMassTrafficVehicleControlProcessor()
 void UMassTrafficVehicleControlProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	SimpleVehicleControlEntityQuery_Conditional.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
-	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::None, EMassFragmentPresence::None);
+	// With archetype stable simulation LOD, vehicles keep PID control fragments below Medium LOD so are instead filtered
+	// per entity. (See all ARCHETYPESTABLELOD.)
+	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly, GetDefault<UMassTrafficSettings>()->bArchetypeStableSimulationLOD ? EMassFragmentPresence::Optional : EMassFragmentPresence::None);
+	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
@@ -131,6 +351,7 @@ void UMassTrafficVehicleControlProcessor::ConfigureQueries(const TSharedRef<FMas
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficNextVehicleFragment>(EMassFragmentAccess::ReadWrite);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficDebugFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficVehicleLaneChangeFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficAnalyticMotionFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
 	SimpleVehicleControlEntityQuery_Conditional.AddRequirement<FMassSimulationVariableTickFragment>(EMassFragmentAccess::ReadOnly);
 	SimpleVehicleControlEntityQuery_Conditional.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly);
 	SimpleVehicleControlEntityQuery_Conditional.SetChunkFilter(FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
@@ -138,6 +359,7 @@ void UMassTrafficVehicleControlProcessor::ConfigureQueries(const TSharedRef<FMas
 
 	PIDVehicleControlEntityQuery_Conditional.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
 	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadWrite);
+	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficObstacleAvoidanceFragment>(EMassFragmentAccess::ReadOnly);
 	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
 	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
@@ -153,12 +375,17 @@ void UMassTrafficVehicleControlProcessor::ConfigureQueries(const TSharedRef<FMas
 	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassSimulationVariableTickFragment>(EMassFragmentAccess::ReadOnly);
 	PIDVehicleControlEntityQuery_Conditional.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly);
 	PIDVehicleControlEntityQuery_Conditional.SetChunkFilter(FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
+	PIDVehicleControlEntityQuery_Conditional.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	PIDVehicleControlEntityQuery_Conditional.AddSubsystemRequirement<UZoneGraphSubsystem>(EMassFragmentAccess::ReadOnly);
+	PIDVehicleControlEntityQuery_Conditional.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadWrite);
 }
 
 
 void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& ExecutionContext)
 {
+	int32 NumQueueSleepingVehicles = 0;
+	int32 NumAnalyticMotionVehicles = 0;
+
 	// Advance simple agents
 	SimpleVehicleControlEntityQuery_Conditional.ForEachEntityChunk(ExecutionContext, [&](FMassExecutionContext& Context)
 		{
@@ -174,10 +401,24 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 			const TArrayView<FMassTrafficObstacleAvoidanceFragment> AvoidanceFragments = Context.GetMutableFragmentView<FMassTrafficObstacleAvoidanceFragment>();
 			const TConstArrayView<FMassTrafficDebugFragment> DebugFragments = Context.GetFragmentView<FMassTrafficDebugFragment>();
 			const TArrayView<FMassTrafficVehicleLaneChangeFragment> LaneChangeFragments = Context.GetMutableFragmentView<FMassTrafficVehicleLaneChangeFragment>();
+			const TArrayView<FMassTrafficAnalyticMotionFragment> AnalyticMotionFragments = Context.GetMutableFragmentView<FMassTrafficAnalyticMotionFragment>();
 			const TConstArrayView<FMassTrafficNextVehicleFragment> NextVehicleFragments = Context.GetMutableFragmentView<FMassTrafficNextVehicleFragment>();
+			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
+			const bool bHasPIDVehicleControl = !Context.GetFragmentView<FMassTrafficPIDVehicleControlFragment>().IsEmpty();
+
+			// (See all ANALYTICMOTION.)
+			const EMassLOD::Type LOD = UE::MassLOD::GetLODFromArchetype(Context);
+			const bool bCanUseAnalyticMotion = GMassTrafficAnalyticMotion && (LOD == EMassLOD::Low || LOD == EMassLOD::Off);
 
 			for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
+				// Skip vehicles with active PID control, kept in this archetype by archetype stable simulation LOD.
+				// (See all ARCHETYPESTABLELOD.)
+				if (bHasPIDVehicleControl && SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+				{
+					continue;
+				}
+
 				const FMassSimulationVariableTickFragment& VariableTickFragment = VariableTickFragments[EntityIt];
 				const FMassTrafficRandomFractionFragment& RandomFractionFragment = RandomFractionFragments[EntityIt];
 				const FTransformFragment& TransformFragment = TransformFragments[EntityIt];
@@ -188,8 +429,32 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 				FMassTrafficLaneOffsetFragment& LaneOffsetFragment = LaneOffsetFragments[EntityIt];
 				FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment = AvoidanceFragments[EntityIt];
 				FMassTrafficVehicleLaneChangeFragment* LaneChangeFragment = !LaneChangeFragments.IsEmpty() ? &LaneChangeFragments[EntityIt] : nullptr;
+				FMassTrafficAnalyticMotionFragment* AnalyticMotionFragment = !AnalyticMotionFragments.IsEmpty() ? &AnalyticMotionFragments[EntityIt] : nullptr;
 				const FMassTrafficNextVehicleFragment& NextVehicleFragment = NextVehicleFragments[EntityIt];
+
+				// Sample speeds for the density grid before skipping anything, so queue sleeping vehicles are counted
+				// as stopped. (See all DENSITYGRID.)
+				MassTrafficSubsystem.SampleDensityGridVehicle(LaneLocationFragment.LaneHandle, VehicleControlFragment.Speed, VariableTickFragment.DeltaTime);
 				
+				// Skip vehicles sleeping in a stopped queue until their lane wakes them. (See all QUEUESLEEP.)
+				if (UpdateQueueSleeping(VehicleControlFragment, AvoidanceFragment, RandomFractionFragment, *MassTrafficSettings, MassTrafficSubsystem))
+				{
+					++NumQueueSleepingVehicles;
+					continue;
+				}
+
+				// Advance vehicles following a closed form free flow trajectory, until it's no longer valid.
+				// (See all ANALYTICMOTION.)
+				if (AnalyticMotionFragment && AnalyticMotionFragment->IsActive())
+				{
+					const float ObstacleAvoidanceBrakingTime = UE::MassTraffic::GeObstacleAvoidanceBrakingTime(RandomFractionFragment.RandomFraction, MassTrafficSettings->ObstacleAvoidanceBrakingTimeRange);
+					if (bCanUseAnalyticMotion && AdvanceAnalyticMotion(*AnalyticMotionFragment, VehicleControlFragment, LaneLocationFragment, AvoidanceFragment, LaneChangeFragment, ObstacleAvoidanceBrakingTime, VariableTickFragment.DeltaTime))
+					{
+						++NumAnalyticMotionVehicles;
+						continue;
+					}
+					AnalyticMotionFragment->Clear();
+				}
 				
 				// Debug
 				const bool bVisLog = DebugFragments.IsEmpty() ? false : DebugFragments[EntityIt].bVisLog > 0;
@@ -208,7 +473,7 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 					LaneLocationFragment,
 					LaneOffsetFragment,
 					AvoidanceFragment,
-					LaneChangeFragment, NextVehicleFragment, bVisLog);
+					LaneChangeFragment, AnalyticMotionFragment, NextVehicleFragment, bVisLog);
 				}
 		});
 
@@ -216,6 +481,7 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 	PIDVehicleControlEntityQuery_Conditional.ForEachEntityChunk(ExecutionContext, [&](FMassExecutionContext& Context)
 		{
 			const UZoneGraphSubsystem& ZoneGraphSubsystem = Context.GetSubsystemChecked<UZoneGraphSubsystem>();
+			UMassTrafficSubsystem& MassTrafficSubsystem = Context.GetMutableSubsystemChecked<UMassTrafficSubsystem>();
 
 			const TConstArrayView<FMassSimulationVariableTickFragment> VariableTickFragments = Context.GetFragmentView<FMassSimulationVariableTickFragment>();
 			const TConstArrayView<FMassTrafficRandomFractionFragment> RandomFractionFragments = Context.GetFragmentView<FMassTrafficRandomFractionFragment>();
@@ -230,9 +496,17 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 			const TConstArrayView<FMassTrafficDebugFragment> DebugFragments = Context.GetFragmentView<FMassTrafficDebugFragment>();
 			const TArrayView<FMassTrafficVehicleLaneChangeFragment> LaneChangeFragments = Context.GetMutableFragmentView<FMassTrafficVehicleLaneChangeFragment>();
 			const TConstArrayView<FMassTrafficNextVehicleFragment> NextVehicleFragments = Context.GetFragmentView<FMassTrafficNextVehicleFragment>();
+			const TConstArrayView<FMassTrafficVehiclePhysicsFragment> SimplePhysicsVehicleFragments = Context.GetFragmentView<FMassTrafficVehiclePhysicsFragment>();
+			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
 
 			for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
+				// Skip vehicles keeping inactive PID control fragments below Medium LOD. (See all ARCHETYPESTABLELOD.)
+				if (bArchetypeStableSimulationLOD && !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+				{
+					continue;
+				}
+
 				const FMassSimulationVariableTickFragment& VariableTickFragment = VariableTickFragments[EntityIt];
 				const FMassTrafficRandomFractionFragment& RandomFractionFragment = RandomFractionFragments[EntityIt];
 				const FAgentRadiusFragment& RadiusFragment = RadiusFragments[EntityIt];
@@ -244,6 +518,17 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 				FMassTrafficPIDControlInterpolationFragment& VehiclePIDMovementInterpolationFragment = VehiclePIDMovementInterpolationFragments[EntityIt];
 				FMassTrafficVehicleLaneChangeFragment* LaneChangeFragment = !LaneChangeFragments.IsEmpty() ? &LaneChangeFragments[EntityIt] : nullptr;
 				const FMassTrafficNextVehicleFragment& NextVehicleFragment = NextVehicleFragments[EntityIt];
+				const FMassTrafficVehiclePhysicsFragment* SimplePhysicsVehicleFragment = !SimplePhysicsVehicleFragments.IsEmpty() ? &SimplePhysicsVehicleFragments[EntityIt] : nullptr;
+
+				// (See all DENSITYGRID.)
+				MassTrafficSubsystem.SampleDensityGridVehicle(LaneLocationFragment.LaneHandle, VehicleControlFragment.Speed, VariableTickFragment.DeltaTime);
+
+				// Skip vehicles sleeping in a stopped queue until their lane wakes them. (See all QUEUESLEEP.)
+				if (UpdateQueueSleeping(VehicleControlFragment, AvoidanceFragment, RandomFractionFragment, *MassTrafficSettings, MassTrafficSubsystem))
+				{
+					++NumQueueSleepingVehicles;
+					continue;
+				}
 
 				const FZoneGraphStorage* ZoneGraphStorage = ZoneGraphSubsystem.GetZoneGraphStorage(LaneLocationFragment.LaneHandle.DataHandle);
 				check(ZoneGraphStorage);
@@ -253,6 +538,7 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 
 				PIDVehicleControl(
 					EntityManager,
+					MassTrafficSubsystem,
 					Context,
 					EntityIt,
 					*ZoneGraphStorage,
@@ -267,9 +553,13 @@ void UMassTrafficVehicleControlProcessor::Execute(FMassEntityManager& EntityMana
 					LaneLocationFragment,
 					PIDVehicleControlFragments[EntityIt],
 					VehiclePIDMovementInterpolationFragment,
-					NextVehicleFragment, bVisLog);
+					NextVehicleFragment,
+					SimplePhysicsVehicleFragment, bVisLog);
 				}
 		});
+
+	INC_DWORD_STAT_BY(STAT_Traffic_QueueSleepingVehicles, NumQueueSleepingVehicles);
+	INC_DWORD_STAT_BY(STAT_Traffic_AnalyticMotionVehicles, NumAnalyticMotionVehicles);
 }
 
 void UMassTrafficVehicleControlProcessor::SimpleVehicleControl(
@@ -287,6 +577,7 @@ void UMassTrafficVehicleControlProcessor::SimpleVehicleControl(
 	FMassTrafficLaneOffsetFragment& LaneOffsetFragment,
 	FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
 	FMassTrafficVehicleLaneChangeFragment* LaneChangeFragment,
+	FMassTrafficAnalyticMotionFragment* AnalyticMotionFragment,
 	const FMassTrafficNextVehicleFragment& NextVehicleFragment, const bool bVisLog
 ) const
 {
@@ -422,6 +713,11 @@ void UMassTrafficVehicleControlProcessor::SimpleVehicleControl(
 	// (See all READYLANE.)
 	SetIsVehicleReadyToUseNextIntersectionLane(VehicleControlFragment, LaneLocationFragment, AgentRadiusFragment, RandomFractionFragment, MassTrafficSettings->StoppingDistanceRange, bVehicleHasNoRoom);
 
+	// (See all QUEUESLEEP.)
+	const bool bCanQueueSleep = !VehicleControlFragment.bCantStopAtLaneExit && !(LaneChangeFragment && LaneChangeFragment->IsLaneChangeInProgress())
+		&& !IsQueueSleepInterrupted(VehicleControlFragment, AvoidanceFragment, RandomFractionFragment, *MassTrafficSettings);
+	UpdateQueueSleep(VehicleControlFragment, MassTrafficSubsystem.GetMutableTrafficLaneData(LaneLocationFragment.LaneHandle), LaneLocationFragment, NextVehicleFragment, TargetSpeed, bCanQueueSleep, EntityManager);
+
 	
 	// @todo Reduce speed on corners 
 
@@ -547,6 +843,18 @@ void UMassTrafficVehicleControlProcessor::SimpleVehicleControl(
 			LaneLocationFragment.DistanceAlongLane = LaneLocationFragment.LaneLength;
 		}
 	}
+
+	// Unobstructed Low & Off LOD vehicles on free flowing lanes can follow a closed form trajectory from here, skipping
+	// the above until their next vehicle, next lane or lane exit could affect them. (See all ANALYTICMOTION.)
+	const bool bIsFreeFlowing = !bMustStopAtLaneExit && !VehicleControlFragment.bCantStopAtLaneExit &&
+		VehicleControlFragment.NextLane && VehicleControlFragment.NextLane->bIsOpen && !VehicleControlFragment.NextLane->bIsAboutToClose &&
+		TargetSpeed >= VariedSpeedLimit && TargetSpeed >= VehicleControlFragment.Speed && !VehicleLightsFragment.bBrakeLights &&
+		AvoidanceFragment.TimeToCollidingObstacle >= UE::MassTraffic::GeObstacleAvoidanceBrakingTime(RandomFractionFragment.RandomFraction, MassTrafficSettings->ObstacleAvoidanceBrakingTimeRange) &&
+		VehicleControlFragment.EmergencyOffset == 0.0f && !(LaneChangeFragment && LaneChangeFragment->IsLaneChangeInProgress());
+	if (AnalyticMotionFragment && GMassTrafficAnalyticMotion && (bIsOffLOD || bIsLowLOD) && bIsFreeFlowing)
+	{
+		StartAnalyticMotion(*AnalyticMotionFragment, VehicleControlFragment, LaneLocationFragment, AvoidanceFragment, AgentRadiusFragment, RandomFractionFragment, *MassTrafficSettings, TargetSpeed);
+	}
 	
 	// Debug speed
 	UE::MassTraffic::DrawDebugSpeed(
@@ -562,6 +870,7 @@ void UMassTrafficVehicleControlProcessor::SimpleVehicleControl(
 
 void UMassTrafficVehicleControlProcessor::PIDVehicleControl(
 	const FMassEntityManager& EntityManager,
+	UMassTrafficSubsystem& MassTrafficSubsystem,
 	const FMassExecutionContext& Context,
 	const int32 EntityIndex,
 	const FZoneGraphStorage& ZoneGraphStorage,
@@ -577,6 +886,7 @@ void UMassTrafficVehicleControlProcessor::PIDVehicleControl(
 	FMassTrafficPIDVehicleControlFragment& PIDVehicleControlFragment,
 	FMassTrafficPIDControlInterpolationFragment& VehiclePIDMovementInterpolationFragment,
 	const FMassTrafficNextVehicleFragment& NextVehicleFragment,
+	const FMassTrafficVehiclePhysicsFragment* SimplePhysicsVehicleFragment,
 	const bool bVisLog
 ) const
 {
@@ -760,6 +1070,14 @@ void UMassTrafficVehicleControlProcessor::PIDVehicleControl(
 	const float TurnSpeedFactor = FMath::GetMappedRangeValueClamped<>(TRange<float>(0.0f, HALF_PI), TRange<float>(1.0f, MassTrafficSettings->TurnSpeedScale), FMath::Abs(TurnAngle));
 	TargetSpeed *= TurnSpeedFactor; 
 
+	// Vehicles with a simple physics sim only queue sleep once the sim has come to rest. This also prevents queue
+	// sleeping at high LOD, where the vehicle is driven by its physics actor instead.
+	// (See all QUEUESLEEP.)
+	const bool bCanQueueSleep = SimplePhysicsVehicleFragment && SimplePhysicsVehicleFragment->VehicleSim.IsSleeping()
+		&& !VehicleControlFragment.bCantStopAtLaneExit && !(LaneChangeFragment && LaneChangeFragment->IsLaneChangeInProgress())
+		&& !IsQueueSleepInterrupted(VehicleControlFragment, AvoidanceFragment, RandomFractionFragment, *MassTrafficSettings);
+	UpdateQueueSleep(VehicleControlFragment, MassTrafficSubsystem.GetMutableTrafficLaneData(LaneLocationFragment.LaneHandle), LaneLocationFragment, NextVehicleFragment, TargetSpeed, bCanQueueSleep, EntityManager);
+
 	// Tick the throttle and brake control PID. Feed throttle & brake PID controller with current speed delta. If returned 
 	// value is positive, it's applied as throttle - negative values are applied as brake.
 	float ThrottleOrBrake = PIDVehicleControlFragment.ThrottleAndBrakeController.Tick(TargetSpeed,
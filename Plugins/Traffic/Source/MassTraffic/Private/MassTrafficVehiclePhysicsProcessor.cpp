@@ -22,6 +22,8 @@
 #include "ZoneGraphTypes.h"
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simple Physics Vehicle Steps"), STAT_Traffic_SimplePhysicsVehicleSteps, STATGROUP_Traffic);
+
 template<typename FormatType>
 void AddForceAtPosition(const FVector& WorldCenterOfMass, const FVector& Force, const FVector& Position, FVector& InOutTotalForce, FVector& InOutTotalTorque, bool bVisLog, UObject* VisLogOwner, const FormatType& VisLogFormat)
 {
@@ -61,6 +63,7 @@ void UMassTrafficVehiclePhysicsProcessor::ConfigureQueries(const TSharedRef<FMas
 {
 	SimplePhysicsVehiclesQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::Any);
 	SimplePhysicsVehiclesQuery.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadOnly);
+	SimplePhysicsVehiclesQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 	SimplePhysicsVehiclesQuery.AddRequirement<FMassTrafficVehicleLaneChangeFragment>(EMassFragmentAccess::ReadOnly);
 	SimplePhysicsVehiclesQuery.AddRequirement<FMassTrafficLaneOffsetFragment>(EMassFragmentAccess::ReadOnly);
 	SimplePhysicsVehiclesQuery.AddRequirement<FMassTrafficConstrainedTrailerFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
@@ -95,13 +98,21 @@ void UMassTrafficVehiclePhysicsProcessor::Execute(FMassEntityManager& EntityMana
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("SimplePhysicsVehicle"))
 
 	// Get Chaos solver settings
-	const int32 NumChaosConstraintSolverIterations = UPhysicsSettingsCore::Get()->SolverOptions.PositionIterations;
+	const int32 NumChaosConstraintSolverIterations = MassTrafficSettings->SimplePhysicsPositionIterations > 0 ? MassTrafficSettings->SimplePhysicsPositionIterations : UPhysicsSettingsCore::Get()->SolverOptions.PositionIterations;
 	const float MinDeltaTime = UPhysicsSettings::Get()->MinPhysicsDeltaTime;
 	const float MaxDeltaTime = UPhysicsSettings::Get()->MaxPhysicsDeltaTime;
-	const float DeltaTime = FMath::Min(Context.GetDeltaTimeSeconds(), MaxDeltaTime);
 
+	// Determine the step size to simulate with. With a fixed timestep, the number of steps is decided per vehicle below.
+	const bool bFixedTimestep = MassTrafficSettings->SimplePhysicsFixedTimestepHz > 0.0f;
+	const float FrameDeltaTime = Context.GetDeltaTimeSeconds();
+	const int32 MaxSubsteps = FMath::Max(MassTrafficSettings->SimplePhysicsMaxSubsteps, 1);
+	float DeltaTime = FMath::Min(FrameDeltaTime, MaxDeltaTime);
+	if (bFixedTimestep)
+	{
+		DeltaTime = 1.0f / MassTrafficSettings->SimplePhysicsFixedTimestepHz;
+	}
 	// Skip simulation if Dt < MinDeltaTime 
-	if (DeltaTime < MinDeltaTime)
+	else if (DeltaTime < MinDeltaTime)
 	{
 		return;
 	}
@@ -128,9 +139,16 @@ void UMassTrafficVehiclePhysicsProcessor::Execute(FMassEntityManager& EntityMana
 			const TArrayView<FMassZoneGraphLaneLocationFragment> LaneLocationFragments = QueryContext.GetMutableFragmentView<FMassZoneGraphLaneLocationFragment>();
 			const TArrayView<FMassTrafficInterpolationFragment> InterpolationFragments = QueryContext.GetMutableFragmentView<FMassTrafficInterpolationFragment>();
 			const TConstArrayView<FMassTrafficDebugFragment> DebugFragments = QueryContext.GetFragmentView<FMassTrafficDebugFragment>();
+			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
 
 			for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
+				// Skip vehicles keeping inactive PID control fragments below Medium LOD. (See all ARCHETYPESTABLELOD.)
+				if (bArchetypeStableSimulationLOD && !SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
+				{
+					continue;
+				}
+
 				// Note: Simple vehicle physics is always run for both high & low viewer LOD vehicles. Most of the time
 				//		 this simple simulation is discarded / ignored by the high LOD physics actor which does its
 				//		 own simulation. However, when a high LOD drops back to medium LOD on a frame, this simulation
@@ -152,201 +170,338 @@ void UMassTrafficVehiclePhysicsProcessor::Execute(FMassEntityManager& EntityMana
 
 				bool bVisLog = DebugFragments.IsEmpty() ? false : DebugFragments[EntityIt].bVisLog > 0;
 
-				// Copy input world transform
-				const FTransform VehicleWorldTransform = TransformFragment.GetTransform();
-				
 				// Skip sleeping vehicles
-				const bool bIsSleeping = ProcessSleeping(VehicleControlFragment, PIDVehicleControlFragment, SimplePhysicsVehicleFragment, VehicleWorldTransform, bVisLog);
+				const bool bIsSleeping = ProcessSleeping(VehicleControlFragment, PIDVehicleControlFragment, SimplePhysicsVehicleFragment, TransformFragment.GetTransform(), bVisLog);
 				if (bIsSleeping)
 				{
 					continue;
 				}
-				
-				// Interpolate current raw lane location
-				FTransform RawLaneLocationTransform;
-				UE::MassTraffic::InterpolatePositionAndOrientationAlongLane(*ZoneGraphStorage, LaneLocationFragment.LaneHandle.Index, LaneLocationFragment.DistanceAlongLane, ETrafficVehicleMovementInterpolationMethod::CubicBezier, InterpolationFragment.LaneLocationLaneSegment, RawLaneLocationTransform);
-				RawLaneLocationTransform.AddToTranslation(RawLaneLocationTransform.GetRotation().GetRightVector() * LaneOffsetFragment.LateralOffset);
-				UE::MassTraffic::AdjustVehicleTransformDuringLaneChange(LaneChangeFragment, LaneLocationFragment.DistanceAlongLane, RawLaneLocationTransform, nullptr/*TrafficCoordinator->GetWorld()*/);
-
-				// Perform suspension traces
-				TArray<FHitResult, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> SuspensionTraceHitResults;
-				TArray<FVector, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> SuspensionTargets;
-				PerformSuspensionTraces(
-					SimplePhysicsVehicleFragment,
-					VehicleWorldTransform,
-					RawLaneLocationTransform,
-					SuspensionTraceHitResults,
-					SuspensionTargets,
-					bVisLog,
-					/*Color*/UE::MassTraffic::EntityToColor(QueryContext.GetEntity(EntityIt)));
-				
-				// Simulate drive forces 
-				SimulateDriveForces(
-					DeltaTime,
-					GravityZ,
-					PIDVehicleControlFragment,
-					SimplePhysicsVehicleFragment,
-					VelocityFragment,
-					AngularVelocityFragment,
-					TransformFragment,
-					VehicleWorldTransform,
-					SuspensionTraceHitResults,
-					bVisLog
-				);
 
 				// Has a simulating trailer? (Vehicles with trailers need to iterate constraints for both the vehicle & the trailer together)
-				bool bHasTrailer = false;
+				TOptional<FMassEntityView> TrailerMassEntityView;
+				FMassTrafficVehiclePhysicsFragment* TrailerSimplePhysicsVehicleFragmentPtr = nullptr;
 				if (!TrailerConstraintFragments.IsEmpty())
 				{
 					const FMassTrafficConstrainedTrailerFragment& TrailerConstraintFragment = TrailerConstraintFragments[EntityIt];
 					if (TrailerConstraintFragment.Trailer.IsSet())
 					{
-						FMassEntityView TrailerMassEntityView(EntityManager, TrailerConstraintFragment.Trailer);
-						FMassTrafficVehiclePhysicsFragment* TrailerSimplePhysicsVehicleFragmentPtr = TrailerMassEntityView.GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>();
-						if (TrailerSimplePhysicsVehicleFragmentPtr)
-						{
-							TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("SuspensionConstraintsAndTrailer"))
-							bHasTrailer = true;
-							
-							FMassTrafficVehiclePhysicsFragment& TrailerSimplePhysicsVehicleFragment = *TrailerSimplePhysicsVehicleFragmentPtr; 
-							FMassVelocityFragment& TrailerVelocityFragment = TrailerMassEntityView.GetFragmentData<FMassVelocityFragment>();
-							FMassTrafficAngularVelocityFragment& TrailerAngularVelocityFragment = TrailerMassEntityView.GetFragmentData<FMassTrafficAngularVelocityFragment>();
-							FTransformFragment& TrailerTransformFragment = TrailerMassEntityView.GetFragmentData<FTransformFragment>();
-							FMassTrafficInterpolationFragment& TrailerInterpolationFragment = TrailerMassEntityView.GetFragmentData<FMassTrafficInterpolationFragment>();
-					
-							// Get trailer simulation config
-							const FMassTrafficTrailerSimulationParameters& TrailerSimulationConfig = TrailerMassEntityView.GetConstSharedFragmentData<FMassTrafficTrailerSimulationParameters>();
-					
-							// Capture input world transform
-							const FTransform TrailerWorldTransform = TrailerTransformFragment.GetTransform();
-					
-							// Interpolate current raw lane location for trailer rear axle
-							// Note: As we don't do ClampLateralDeviation for trailers, we can skip
-							//       performing AdjustVehicleTransformDuringLaneChange as we're only using this raw lane
-							//		 location to form the tracing plane for suspensions traces, which isn't affected by lane
-							//		 change lateral offsets anyway.
-							FTransform TrailerRawLaneLocationTransform;
-							UE::MassTraffic::InterpolatePositionAndOrientationAlongContinuousLanes(
-								*ZoneGraphStorage,
-								VehicleControlFragment.PreviousLaneIndex,
-								VehicleControlFragment.PreviousLaneLength,
-								LaneLocationFragment.LaneHandle.Index,
-								LaneLocationFragment.LaneLength,
-								/*NextLaneIndex*/INDEX_NONE,
-								LaneLocationFragment.DistanceAlongLane + TrailerSimulationConfig.RearAxleX, ETrafficVehicleMovementInterpolationMethod::CubicBezier, TrailerInterpolationFragment.LaneLocationLaneSegment, TrailerRawLaneLocationTransform);
+						TrailerMassEntityView.Emplace(EntityManager, TrailerConstraintFragment.Trailer);
+						TrailerSimplePhysicsVehicleFragmentPtr = TrailerMassEntityView->GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>();
+					}
+				}
+
+				int32 NumSubsteps = 1;
+				float InterpolationAlpha = 1.0f;
+				if (bFixedTimestep)
+				{
+					// Rewind presented transforms to the last simulated fixed step. The trailer steps with its vehicle so
+					// was presented at the vehicle's interpolation alpha.
+					const float PresentedInterpolationAlpha = FMath::Clamp(SimplePhysicsVehicleFragment.SubstepTimeAccumulator / DeltaTime, 0.0f, 1.0f);
+					RestoreSimulatedState(SimplePhysicsVehicleFragment, TransformFragment, VelocityFragment, PresentedInterpolationAlpha);
+					if (TrailerSimplePhysicsVehicleFragmentPtr)
+					{
+						RestoreSimulatedState(*TrailerSimplePhysicsVehicleFragmentPtr, TrailerMassEntityView->GetFragmentData<FTransformFragment>(), TrailerMassEntityView->GetFragmentData<FMassVelocityFragment>(), PresentedInterpolationAlpha);
+					}
+
+					// Accumulate frame time and consume it in fixed steps, up to SimplePhysicsMaxSubsteps. Any time left
+					// over is carried to the next frame and used to interpolate what's presented between the last two
+					// steps.
+					float& SubstepTimeAccumulator = SimplePhysicsVehicleFragment.SubstepTimeAccumulator;
+					SubstepTimeAccumulator += FrameDeltaTime;
+					NumSubsteps = FMath::FloorToInt32(SubstepTimeAccumulator / DeltaTime);
+					if (NumSubsteps > MaxSubsteps)
+					{
+						// Discard the time we can't afford to simulate, so hitches slow vehicles down rather than
+						// destabilize them
+						NumSubsteps = MaxSubsteps;
+						SubstepTimeAccumulator = FMath::Fmod(SubstepTimeAccumulator, DeltaTime);
+					}
+					else
+					{
+						SubstepTimeAccumulator -= NumSubsteps * DeltaTime;
+					}
+					InterpolationAlpha = FMath::Clamp(SubstepTimeAccumulator / DeltaTime, 0.0f, 1.0f);
+				}
+				else
+				{
+					SimplePhysicsVehicleFragment.bHasSimulatedTransform = false;
+				}
+				
+				INC_DWORD_STAT_BY(STAT_Traffic_SimplePhysicsVehicleSteps, NumSubsteps);
+
+				// With multiple substeps, each substep's raw lane location is interpolated at the distance along the
+				// lane the vehicle reaches by the end of that substep, advancing at the speed simulated by the substep
+				// before it, up to the current DistanceAlongLane at the last substep. Just after a lane transition,
+				// early substeps fall back onto the previous lane.
+				const float MinSubstepDistanceAlongLane = VehicleControlFragment.PreviousLaneIndex != INDEX_NONE ? -VehicleControlFragment.PreviousLaneLength : 0.0f;
+				float SubstepDistanceAlongLane = FMath::Max(LaneLocationFragment.DistanceAlongLane - VehicleControlFragment.Speed * DeltaTime * (NumSubsteps - 1), MinSubstepDistanceAlongLane);
+				for (int32 Substep = 0; Substep < NumSubsteps; ++Substep)
+				{
+					// Interpolate raw lane location for this substep
+					if (Substep > 0)
+					{
+						SubstepDistanceAlongLane = Substep < NumSubsteps - 1
+							? FMath::Min(SubstepDistanceAlongLane + VehicleControlFragment.Speed * DeltaTime, LaneLocationFragment.DistanceAlongLane)
+							: LaneLocationFragment.DistanceAlongLane;
+					}
+					FTransform RawLaneLocationTransform;
+					UE::MassTraffic::InterpolatePositionAndOrientationAlongContinuousLanes(
+						*ZoneGraphStorage,
+						VehicleControlFragment.PreviousLaneIndex,
+						VehicleControlFragment.PreviousLaneLength,
+						LaneLocationFragment.LaneHandle.Index,
+						LaneLocationFragment.LaneLength,
+						/*NextLaneIndex*/INDEX_NONE,
+						SubstepDistanceAlongLane, ETrafficVehicleMovementInterpolationMethod::CubicBezier, InterpolationFragment.LaneLocationLaneSegment, RawLaneLocationTransform);
+					RawLaneLocationTransform.AddToTranslation(RawLaneLocationTransform.GetRotation().GetRightVector() * LaneOffsetFragment.LateralOffset);
+					UE::MassTraffic::AdjustVehicleTransformDuringLaneChange(LaneChangeFragment, SubstepDistanceAlongLane, RawLaneLocationTransform, nullptr/*TrafficCoordinator->GetWorld()*/);
+
+					// Copy input world transform
+					const FTransform VehicleWorldTransform = TransformFragment.GetTransform();
+
+					// Perform suspension traces
+					TArray<FHitResult, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> SuspensionTraceHitResults;
+					TArray<FVector, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> SuspensionTargets;
+					PerformSuspensionTraces(
+						SimplePhysicsVehicleFragment,
+						VehicleWorldTransform,
+						RawLaneLocationTransform,
+						SuspensionTraceHitResults,
+						SuspensionTargets,
+						bVisLog,
+						/*Color*/UE::MassTraffic::EntityToColor(QueryContext.GetEntity(EntityIt)));
 					
-							// Perform suspension traces
-							TArray<FHitResult, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> TrailerSuspensionTraceHitResults;
-							TArray<FVector, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> TrailerSuspensionTargets;
-							PerformSuspensionTraces(
-								TrailerSimplePhysicsVehicleFragment,
-								TrailerWorldTransform,
-								TrailerRawLaneLocationTransform,
-								TrailerSuspensionTraceHitResults,
-								TrailerSuspensionTargets,
-								bVisLog,
-								/*Color*/UE::MassTraffic::EntityToColor(QueryContext.GetEntity(EntityIt)));
+					// Simulate drive forces 
+					SimulateDriveForces(
+						DeltaTime,
+						GravityZ,
+						PIDVehicleControlFragment,
+						SimplePhysicsVehicleFragment,
+						VelocityFragment,
+						AngularVelocityFragment,
+						TransformFragment,
+						VehicleWorldTransform,
+						SuspensionTraceHitResults,
+						bVisLog
+					);
+
+					if (TrailerSimplePhysicsVehicleFragmentPtr)
+					{
+						TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("SuspensionConstraintsAndTrailer"))
+						
+						FMassTrafficVehiclePhysicsFragment& TrailerSimplePhysicsVehicleFragment = *TrailerSimplePhysicsVehicleFragmentPtr; 
+						FMassVelocityFragment& TrailerVelocityFragment = TrailerMassEntityView->GetFragmentData<FMassVelocityFragment>();
+						FMassTrafficAngularVelocityFragment& TrailerAngularVelocityFragment = TrailerMassEntityView->GetFragmentData<FMassTrafficAngularVelocityFragment>();
+						FTransformFragment& TrailerTransformFragment = TrailerMassEntityView->GetFragmentData<FTransformFragment>();
+						FMassTrafficInterpolationFragment& TrailerInterpolationFragment = TrailerMassEntityView->GetFragmentData<FMassTrafficInterpolationFragment>();
+				
+						// Get trailer simulation config
+						const FMassTrafficTrailerSimulationParameters& TrailerSimulationConfig = TrailerMassEntityView->GetConstSharedFragmentData<FMassTrafficTrailerSimulationParameters>();
+				
+						// Capture input world transform
+						const FTransform TrailerWorldTransform = TrailerTransformFragment.GetTransform();
+				
+						// Interpolate current raw lane location for trailer rear axle
+						// Note: As we don't do ClampLateralDeviation for trailers, we can skip
+						//       performing AdjustVehicleTransformDuringLaneChange as we're only using this raw lane
+						//		 location to form the tracing plane for suspensions traces, which isn't affected by lane
+						//		 change lateral offsets anyway.
+						FTransform TrailerRawLaneLocationTransform;
+						UE::MassTraffic::InterpolatePositionAndOrientationAlongContinuousLanes(
+							*ZoneGraphStorage,
+							VehicleControlFragment.PreviousLaneIndex,
+							VehicleControlFragment.PreviousLaneLength,
+							LaneLocationFragment.LaneHandle.Index,
+							LaneLocationFragment.LaneLength,
+							/*NextLaneIndex*/INDEX_NONE,
+							SubstepDistanceAlongLane + TrailerSimulationConfig.RearAxleX, ETrafficVehicleMovementInterpolationMethod::CubicBezier, TrailerInterpolationFragment.LaneLocationLaneSegment, TrailerRawLaneLocationTransform);
+				
+						// Perform suspension traces
+						TArray<FHitResult, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> TrailerSuspensionTraceHitResults;
+						TArray<FVector, TFixedAllocator<FMassTrafficSimpleVehiclePhysicsSim::MaxWheels>> TrailerSuspensionTargets;
+						PerformSuspensionTraces(
+							TrailerSimplePhysicsVehicleFragment,
+							TrailerWorldTransform,
+							TrailerRawLaneLocationTransform,
+							TrailerSuspensionTraceHitResults,
+							TrailerSuspensionTargets,
+							bVisLog,
+							/*Color*/UE::MassTraffic::EntityToColor(QueryContext.GetEntity(EntityIt)));
+						
+						// Simulate drive forces 
+						const FMassTrafficPIDVehicleControlFragment NoInputPIDVehicleControlFragment;
+						SimulateDriveForces(
+							DeltaTime,
+							GravityZ,
+							NoInputPIDVehicleControlFragment,
+							TrailerSimplePhysicsVehicleFragment,
+							TrailerVelocityFragment,
+							TrailerAngularVelocityFragment,
+							TrailerTransformFragment,
+							TrailerWorldTransform,
+							TrailerSuspensionTraceHitResults,
+							bVisLog
+						);
+				
+						TrailerConstraintSolver.Init(
+							DeltaTime, 
+							ChaosConstraintSolverSettings,
+							TrailerSimulationConfig.ChaosJointSettings,
+							VehicleWorldTransform.TransformPosition(SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
+							TrailerWorldTransform.TransformPosition(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
+							VehicleWorldTransform.GetRotation() * SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
+							TrailerWorldTransform.GetRotation() * TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
+							SimplePhysicsVehicleFragment.VehicleSim.Setup().Mass > 0.0f ? 1.0f / SimplePhysicsVehicleFragment.VehicleSim.Setup().Mass : 0.0f,
+							SimplePhysicsVehicleFragment.VehicleSim.Setup().InverseMomentOfInertia,
+							TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().Mass > 0.0f ? 1.0f / TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().Mass : 0.0f,
+							TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().InverseMomentOfInertia,
+							Chaos::FRigidTransform3(SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.UnrotateVector(TrailerSimulationConfig.ConstraintSettings.MountPoint - SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass), SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.Inverse()),
+							Chaos::FRigidTransform3(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.UnrotateVector(TrailerSimulationConfig.ConstraintSettings.MountPoint - TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass), TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.Inverse())
+						);
+						
+						// Suspension & trailer attachment constraints 
+						for (int Iteration = 0; Iteration < NumChaosConstraintSolverIterations; ++Iteration)
+						{
+							// Vehicle suspension constraints
+							SolveSuspensionConstraintsIteration(DeltaTime, SimplePhysicsVehicleFragment, VelocityFragment, AngularVelocityFragment, TransformFragment, VehicleWorldTransform, SuspensionTargets, bVisLog);
 							
-							// Simulate drive forces 
-							const FMassTrafficPIDVehicleControlFragment NoInputPIDVehicleControlFragment;
-							SimulateDriveForces(
-								DeltaTime,
-								GravityZ,
-								NoInputPIDVehicleControlFragment,
-								TrailerSimplePhysicsVehicleFragment,
-								TrailerVelocityFragment,
-								TrailerAngularVelocityFragment,
-								TrailerTransformFragment,
-								TrailerWorldTransform,
-								TrailerSuspensionTraceHitResults,
-								bVisLog
-							);
-					
-							TrailerConstraintSolver.Init(
-								DeltaTime, 
+							// Trailer suspension constraints
+							SolveSuspensionConstraintsIteration(DeltaTime, TrailerSimplePhysicsVehicleFragment, TrailerVelocityFragment, TrailerAngularVelocityFragment, TrailerTransformFragment, TrailerWorldTransform, TrailerSuspensionTargets, bVisLog);
+				
+							// Trailer attachment constraint 
+							TrailerConstraintSolver.Update(
+								Iteration,
+								NumChaosConstraintSolverIterations, 
 								ChaosConstraintSolverSettings,
-								TrailerSimulationConfig.ChaosJointSettings,
-								VehicleWorldTransform.TransformPosition(SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
-								TrailerWorldTransform.TransformPosition(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
-								VehicleWorldTransform.GetRotation() * SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
-								TrailerWorldTransform.GetRotation() * TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
-								SimplePhysicsVehicleFragment.VehicleSim.Setup().Mass > 0.0f ? 1.0f / SimplePhysicsVehicleFragment.VehicleSim.Setup().Mass : 0.0f,
-								SimplePhysicsVehicleFragment.VehicleSim.Setup().InverseMomentOfInertia,
-								TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().Mass > 0.0f ? 1.0f / TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().Mass : 0.0f,
-								TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().InverseMomentOfInertia,
-								Chaos::FRigidTransform3(SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.UnrotateVector(TrailerSimulationConfig.ConstraintSettings.MountPoint - SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass), SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.Inverse()),
-								Chaos::FRigidTransform3(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.UnrotateVector(TrailerSimulationConfig.ConstraintSettings.MountPoint - TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass), TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass.Inverse())
+								/*P0*/TransformFragment.GetTransform().TransformPositionNoScale(SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
+								/*Q0*/TransformFragment.GetTransform().GetRotation() * SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
+								/*V0*/VelocityFragment.Value,
+								/*W0*/AngularVelocityFragment.AngularVelocity,
+								/*P1*/TrailerTransformFragment.GetTransform().TransformPositionNoScale(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
+								/*Q1*/TrailerTransformFragment.GetTransform().GetRotation() * TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
+								/*V1*/TrailerVelocityFragment.Value,
+								/*W1*/TrailerAngularVelocityFragment.AngularVelocity
 							);
 							
-							// Suspension & trailer attachment constraints 
-							for (int Iteration = 0; Iteration < NumChaosConstraintSolverIterations; ++Iteration)
+							if (TrailerConstraintSolver.GetIsActive())
 							{
-								// Vehicle suspension constraints
-								SolveSuspensionConstraintsIteration(DeltaTime, SimplePhysicsVehicleFragment, VelocityFragment, AngularVelocityFragment, TransformFragment, VehicleWorldTransform, SuspensionTargets, bVisLog);
-								
-								// Trailer suspension constraints
-								SolveSuspensionConstraintsIteration(DeltaTime, TrailerSimplePhysicsVehicleFragment, TrailerVelocityFragment, TrailerAngularVelocityFragment, TrailerTransformFragment, TrailerWorldTransform, TrailerSuspensionTargets, bVisLog);
-					
-								// Trailer attachment constraint 
-								TrailerConstraintSolver.Update(
-									Iteration,
-									NumChaosConstraintSolverIterations, 
-									ChaosConstraintSolverSettings,
-									/*P0*/TransformFragment.GetTransform().TransformPositionNoScale(SimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
-									/*Q0*/TransformFragment.GetTransform().GetRotation() * SimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
-									/*V0*/VelocityFragment.Value,
-									/*W0*/AngularVelocityFragment.AngularVelocity,
-									/*P1*/TrailerTransformFragment.GetTransform().TransformPositionNoScale(TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().CenterOfMass),
-									/*Q1*/TrailerTransformFragment.GetTransform().GetRotation() * TrailerSimplePhysicsVehicleFragment.VehicleSim.Setup().RotationOfMass,
-									/*V1*/TrailerVelocityFragment.Value,
-									/*W1*/TrailerAngularVelocityFragment.AngularVelocity
-								);
-								
-								if (TrailerConstraintSolver.GetIsActive())
+								TrailerConstraintSolver.ApplyConstraints(DeltaTime, ChaosConstraintSolverSettings, TrailerSimulationConfig.ChaosJointSettings);
+									
+								if (!TrailerConstraintSolver.GetIsActive())
 								{
-									TrailerConstraintSolver.ApplyConstraints(DeltaTime, ChaosConstraintSolverSettings, TrailerSimulationConfig.ChaosJointSettings);
-										
-									if (!TrailerConstraintSolver.GetIsActive())
-									{
-										break;
-									}
-					
-									// Set new constrained Center of Mass transform for vehicle & trailer
-									SetCoMWorldTransform(SimplePhysicsVehicleFragment, TransformFragment, TrailerConstraintSolver.GetP(0), TrailerConstraintSolver.GetQ(0));
-									SetCoMWorldTransform(TrailerSimplePhysicsVehicleFragment, TrailerTransformFragment, TrailerConstraintSolver.GetP(1), TrailerConstraintSolver.GetQ(1));
+									break;
 								}
+				
+								// Set new constrained Center of Mass transform for vehicle & trailer
+								SetCoMWorldTransform(SimplePhysicsVehicleFragment, TransformFragment, TrailerConstraintSolver.GetP(0), TrailerConstraintSolver.GetQ(0));
+								SetCoMWorldTransform(TrailerSimplePhysicsVehicleFragment, TrailerTransformFragment, TrailerConstraintSolver.GetP(1), TrailerConstraintSolver.GetQ(1));
 							}
-					
-							// Update speed & velocity of trailer
-							UpdateCoMVelocity(DeltaTime, TrailerSimplePhysicsVehicleFragment, TrailerTransformFragment, TrailerVelocityFragment, TrailerAngularVelocityFragment, TrailerWorldTransform);
 						}
-					}
-				}
 				
-				// No trailer, we can just simulate our own suspension constraints by ourself
-				if (!bHasTrailer)
-				{
+						// Update speed & velocity of trailer
+						UpdateCoMVelocity(DeltaTime, TrailerSimplePhysicsVehicleFragment, TrailerTransformFragment, TrailerVelocityFragment, TrailerAngularVelocityFragment, TrailerWorldTransform);
 
-					// Suspension Constraints
-					for (int Iteration = 0; Iteration < NumChaosConstraintSolverIterations; ++Iteration)
+						if (bFixedTimestep)
+						{
+							RecordSimulatedState(TrailerSimplePhysicsVehicleFragment, TrailerTransformFragment, TrailerVelocityFragment);
+						}
+					}
+					else
 					{
-						SolveSuspensionConstraintsIteration(DeltaTime, SimplePhysicsVehicleFragment, VelocityFragment, AngularVelocityFragment, TransformFragment, VehicleWorldTransform, SuspensionTargets, bVisLog);
+						// No trailer, we can just simulate our own suspension constraints by ourself
+						for (int Iteration = 0; Iteration < NumChaosConstraintSolverIterations; ++Iteration)
+						{
+							SolveSuspensionConstraintsIteration(DeltaTime, SimplePhysicsVehicleFragment, VelocityFragment, AngularVelocityFragment, TransformFragment, VehicleWorldTransform, SuspensionTargets, bVisLog);
+						}
 					}
-				}
-				
-				// Clamp vehicle position to limit deviation from RawLaneLocation
-				ClampLateralDeviation(TransformFragment, RawLaneLocationTransform);
+					
+					// Clamp vehicle position to limit deviation from RawLaneLocation
+					ClampLateralDeviation(TransformFragment, RawLaneLocationTransform);
+
+					// Update velocity of vehicle
+					UpdateCoMVelocity(DeltaTime, SimplePhysicsVehicleFragment, TransformFragment, VelocityFragment, AngularVelocityFragment, VehicleWorldTransform);
 
-				// Update velocity of vehicle
-				UpdateCoMVelocity(DeltaTime, SimplePhysicsVehicleFragment, TransformFragment, VelocityFragment, AngularVelocityFragment, VehicleWorldTransform);
+					// Update speed from velocity 
+					VehicleControlFragment.Speed = VelocityFragment.Value.Size();
+
+					if (bFixedTimestep)
+					{
+						RecordSimulatedState(SimplePhysicsVehicleFragment, TransformFragment, VelocityFragment);
+					}
+				}
 
-				// Update speed from velocity 
-				VehicleControlFragment.Speed = VelocityFragment.Value.Size();
+				// Present transforms & velocities interpolated between the last two simulated fixed steps
+				if (bFixedTimestep)
+				{
+					PresentSimulatedState(SimplePhysicsVehicleFragment, TransformFragment, VelocityFragment, InterpolationAlpha);
+					if (TrailerSimplePhysicsVehicleFragmentPtr)
+					{
+						PresentSimulatedState(*TrailerSimplePhysicsVehicleFragmentPtr, TrailerMassEntityView->GetFragmentData<FTransformFragment>(), TrailerMassEntityView->GetFragmentData<FMassVelocityFragment>(), InterpolationAlpha);
+					}
+				}
 			}
 		});
 	}
 }
 
+void UMassTrafficVehiclePhysicsProcessor::RestoreSimulatedState(
+	FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+	FTransformFragment& TransformFragment,
+	FMassVelocityFragment& VelocityFragment,
+	const float PresentedInterpolationAlpha)
+{
+	FTransform& Transform = TransformFragment.GetMutableTransform();
+	if (SimplePhysicsVehicleFragment.bHasSimulatedTransform)
+	{
+		// Rebuild what we presented last frame, rather than storing it, to check nothing else has moved the vehicle
+		const FVector PresentedLocation = SimplePhysicsVehicleFragment.SimulatedLocation + FVector(SimplePhysicsVehicleFragment.PreviousSimulatedLocationOffset * (1.0f - PresentedInterpolationAlpha));
+		const FQuat4f PresentedRotation = FQuat4f::Slerp(SimplePhysicsVehicleFragment.PreviousSimulatedRotation, SimplePhysicsVehicleFragment.SimulatedRotation, PresentedInterpolationAlpha);
+		if (Transform.GetLocation().Equals(PresentedLocation, 0.1f) && FQuat4f(Transform.GetRotation()).Equals(PresentedRotation, 1e-3f))
+		{
+			Transform.SetLocation(SimplePhysicsVehicleFragment.SimulatedLocation);
+			Transform.SetRotation(FQuat(SimplePhysicsVehicleFragment.SimulatedRotation));
+			VelocityFragment.Value = FVector(SimplePhysicsVehicleFragment.SimulatedVelocity);
+			return;
+		}
+	}
+
+	// First step, or the vehicle was moved since we last presented it. Start simulating from where it is now.
+	SimplePhysicsVehicleFragment.SimulatedLocation = Transform.GetLocation();
+	SimplePhysicsVehicleFragment.PreviousSimulatedLocationOffset = FVector3f::ZeroVector;
+	SimplePhysicsVehicleFragment.SimulatedRotation = FQuat4f(Transform.GetRotation());
+	SimplePhysicsVehicleFragment.PreviousSimulatedRotation = SimplePhysicsVehicleFragment.SimulatedRotation;
+	SimplePhysicsVehicleFragment.SimulatedVelocity = FVector3f(VelocityFragment.Value);
+	SimplePhysicsVehicleFragment.PreviousSimulatedVelocity = SimplePhysicsVehicleFragment.SimulatedVelocity;
+	SimplePhysicsVehicleFragment.SubstepTimeAccumulator = 0.0f;
+	SimplePhysicsVehicleFragment.bHasSimulatedTransform = true;
+}
+
+void UMassTrafficVehiclePhysicsProcessor::RecordSimulatedState(
+	FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+	const FTransformFragment& TransformFragment,
+	const FMassVelocityFragment& VelocityFragment)
+{
+	const FTransform& Transform = TransformFragment.GetTransform();
+	SimplePhysicsVehicleFragment.PreviousSimulatedLocationOffset = FVector3f(SimplePhysicsVehicleFragment.SimulatedLocation - Transform.GetLocation());
+	SimplePhysicsVehicleFragment.SimulatedLocation = Transform.GetLocation();
+	SimplePhysicsVehicleFragment.PreviousSimulatedRotation = SimplePhysicsVehicleFragment.SimulatedRotation;
+	SimplePhysicsVehicleFragment.SimulatedRotation = FQuat4f(Transform.GetRotation());
+	SimplePhysicsVehicleFragment.PreviousSimulatedVelocity = SimplePhysicsVehicleFragment.SimulatedVelocity;
+	SimplePhysicsVehicleFragment.SimulatedVelocity = FVector3f(VelocityFragment.Value);
+}
+
+void UMassTrafficVehiclePhysicsProcessor::PresentSimulatedState(
+	const FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+	FTransformFragment& TransformFragment,
+	FMassVelocityFragment& VelocityFragment,
+	const float InterpolationAlpha)
+{
+	FTransform& PresentedTransform = TransformFragment.GetMutableTransform();
+	PresentedTransform.SetLocation(SimplePhysicsVehicleFragment.SimulatedLocation + FVector(SimplePhysicsVehicleFragment.PreviousSimulatedLocationOffset * (1.0f - InterpolationAlpha)));
+	PresentedTransform.SetRotation(FQuat(FQuat4f::Slerp(SimplePhysicsVehicleFragment.PreviousSimulatedRotation, SimplePhysicsVehicleFragment.SimulatedRotation, InterpolationAlpha)));
+	VelocityFragment.Value = FVector(FMath::Lerp(SimplePhysicsVehicleFragment.PreviousSimulatedVelocity, SimplePhysicsVehicleFragment.SimulatedVelocity, InterpolationAlpha));
+}
+
 bool UMassTrafficVehiclePhysicsProcessor::ProcessSleeping(
 	const FMassTrafficVehicleControlFragment& VehicleControlFragment,
 	const FMassTrafficPIDVehicleControlFragment& PIDVehicleControlFragment,
@@ -555,8 +710,12 @@ void UMassTrafficVehiclePhysicsProcessor::SimulateDriveForces(
 
 	// Aerodynamics
 	// @see UChaosVehicleSimulation::ApplyAerodynamics
+	// 
+	// Note: The aerodynamics sim has no per-vehicle state, so rather than store one per vehicle we construct one over
+	//		 the shared config
 	{
-		FVector LocalDragLiftForce = (SimplePhysicsVehicleFragment.VehicleSim.AerodynamicsSim.GetCombinedForces(Chaos::CmToM(ForwardSpeed))) * Chaos::MToCmScaling();
+		Chaos::FSimpleAerodynamicsSim AerodynamicsSim(&SimplePhysicsVehicleFragment.VehicleSim.Setup().AerodynamicsConfig);
+		FVector LocalDragLiftForce = (AerodynamicsSim.GetCombinedForces(Chaos::CmToM(ForwardSpeed))) * Chaos::MToCmScaling();
 		FVector WorldLiftDragForce = VehicleWorldTransform.TransformVectorNoScale(LocalDragLiftForce);
 		AddForce(WorldLiftDragForce, TotalForce, bVisLog, LogOwner, VehicleWorldTransform.GetLocation(), TEXT("Ae"));
 	}
@@ -637,17 +796,17 @@ void UMassTrafficVehiclePhysicsProcessor::SimulateDriveForces(
 			auto& PWheel = SimplePhysicsVehicleFragment.VehicleSim.WheelSims[WheelIndex];
 			if (PWheel.EngineEnabled)
 			{
-				if (SimplePhysicsVehicleFragment.VehicleSim.DifferentialSim.Setup().DifferentialType == Chaos::EDifferentialType::AllWheelDrive)
+				if (SimplePhysicsVehicleFragment.VehicleSim.Setup().DifferentialConfig.DifferentialType == Chaos::EDifferentialType::AllWheelDrive)
 				{
 					float SplitTorque = 1.0f;
 
 					if (PWheel.Setup().AxleType == Chaos::FSimpleWheelConfig::EAxleType::Front)
 					{
-						SplitTorque = (1.0f - SimplePhysicsVehicleFragment.VehicleSim.DifferentialSim.FrontRearSplit);
+						SplitTorque = (1.0f - SimplePhysicsVehicleFragment.VehicleSim.Setup().DifferentialConfig.FrontRearSplit);
 					}
 					else
 					{
-						SplitTorque = SimplePhysicsVehicleFragment.VehicleSim.DifferentialSim.FrontRearSplit;
+						SplitTorque = SimplePhysicsVehicleFragment.VehicleSim.Setup().DifferentialConfig.FrontRearSplit;
 					}
 
 					PWheel.SetDriveTorque(Chaos::TorqueMToCm(TransmissionTorque * SplitTorque) / (float)SimplePhysicsVehicleFragment.VehicleSim.Setup().NumDrivenWheels);
@@ -705,15 +864,15 @@ void UMassTrafficVehiclePhysicsProcessor::SimulateDriveForces(
 		}
 
 		{
-			for (auto& Axle : SimplePhysicsVehicleFragment.VehicleSim.AxleSims)
+			for (const Chaos::FAxleConfig& AxleConfig : SimplePhysicsVehicleFragment.VehicleSim.Setup().AxleConfigs)
 			{
 				// Only works with 2 wheels on an axle.
-				if (Axle.Setup.WheelIndex.Num() == 2)
+				if (AxleConfig.WheelIndex.Num() == 2)
 				{
-					uint16 WheelIndexA = Axle.Setup.WheelIndex[0];
-					uint16 WheelIndexB = Axle.Setup.WheelIndex[1];
+					uint16 WheelIndexA = AxleConfig.WheelIndex[0];
+					uint16 WheelIndexB = AxleConfig.WheelIndex[1];
 
-					float FV = Axle.Setup.RollbarScaling;
+					float FV = AxleConfig.RollbarScaling;
 					float ForceDiffOnAxleF = SusForces[WheelIndexA] - SusForces[WheelIndexB];
 					FVector ForceVector0 = VehicleWorldUpAxis * ForceDiffOnAxleF * FV;
 					FVector ForceVector1 = VehicleWorldUpAxis * ForceDiffOnAxleF * -FV;
@@ -781,7 +940,10 @@ void UMassTrafficVehiclePhysicsProcessor::SimulateDriveForces(
 	// wheel friction to ensure SteerLocalWheelVelocity is calculated using the previous frame's
 	// SteeringAngle, which UChaosWheeledVehicleSimulation::ApplyWheelFrictionForces does by using
 	// the last frames captured state.
+	// 
+	// Note: As with aerodynamics, the steering sim has no per-vehicle state so we construct one over the shared config 
 	{
+		Chaos::FSimpleSteeringSim SteeringSim(&SimplePhysicsVehicleFragment.VehicleSim.Setup().SteeringConfig);
 
 		for (int WheelIndex = 0; WheelIndex < SimplePhysicsVehicleFragment.VehicleSim.WheelSims.Num(); WheelIndex++)
 		{
@@ -794,13 +956,13 @@ void UMassTrafficVehiclePhysicsProcessor::SimulateDriveForces(
 				// allow full counter steering when steering into a power slide
 				//if (ControlInputs.SteeringInput * VehicleState.VehicleLocalVelocity.Y > 0.0f)
 				{
-					SpeedScale = SimplePhysicsVehicleFragment.VehicleSim.SteeringSim.GetSteeringFromVelocity(Chaos::CmSToMPH(ForwardSpeed));
+					SpeedScale = SteeringSim.GetSteeringFromVelocity(Chaos::CmSToMPH(ForwardSpeed));
 				}
 
 				float SteeringAngle = PIDVehicleControlFragment.Steering * SpeedScale;
 
 				float WheelSide = SimplePhysicsVehicleFragment.VehicleSim.SuspensionSims[WheelIndex].GetLocalRestingPosition().Y;
-				SteeringAngle = SimplePhysicsVehicleFragment.VehicleSim.SteeringSim.GetSteeringAngle(SteeringAngle, PWheel.MaxSteeringAngle, WheelSide);
+				SteeringAngle = SteeringSim.GetSteeringAngle(SteeringAngle, PWheel.MaxSteeringAngle, WheelSide);
 
 				PWheel.SetSteeringAngle(SteeringAngle);
 			}
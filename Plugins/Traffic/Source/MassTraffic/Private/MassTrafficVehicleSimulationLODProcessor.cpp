@@ -14,6 +14,8 @@ DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD Low"), STAT_Traffic_SimLODLow, STATGROU
 DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD Off"), STAT_Traffic_SimLODOff, STATGROUP_Traffic);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD Max"), STAT_Traffic_SimLODMax, STATGROUP_Traffic);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD > Off"), STAT_Traffic_SimTotal, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD Archetype Moves"), STAT_Traffic_SimLODArchetypeMoves, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sim LOD Promotion Backlog"), STAT_Traffic_SimLODPromotionBacklog, STATGROUP_Traffic);
 
 UMassTrafficVehicleSimulationLODProcessor::UMassTrafficVehicleSimulationLODProcessor()
 	: EntityQuery(*this)
@@ -49,10 +51,16 @@ void UMassTrafficVehicleSimulationLODProcessor::ConfigureQueries(const TSharedRe
 	EntityQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FMassTrafficDebugFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddChunkRequirement<FMassTrafficSimulationLODChunkFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddSharedRequirement<FMassSimulationVariableTickSharedFragment>(EMassFragmentAccess::ReadOnly);
 
+	// Chunks with promotions deferred last frame are recalculated straight away. (See all LODPROMOTIONBUDGET.)
 	EntityQueryCalculateLOD = EntityQuery;
-	EntityQueryCalculateLOD.SetChunkFilter(FMassSimulationVariableTickSharedFragment::ShouldCalculateLODForChunk);
+	EntityQueryCalculateLOD.SetChunkFilter([](const FMassExecutionContext& Context)
+	{
+		return Context.GetChunkFragment<FMassTrafficSimulationLODChunkFragment>().bHasDeferredPromotions
+			|| FMassSimulationVariableTickSharedFragment::ShouldCalculateLODForChunk(Context);
+	});
 
 	EntityQueryAdjustDistances = EntityQuery;
 	EntityQueryAdjustDistances.SetChunkFilter(&FMassSimulationVariableTickSharedFragment::ShouldAdjustLODFromCountForChunk);
@@ -64,7 +72,10 @@ void UMassTrafficVehicleSimulationLODProcessor::ConfigureQueries(const TSharedRe
 	EntityQueryVariableTick.AddSharedRequirement<FMassSimulationVariableTickSharedFragment>(EMassFragmentAccess::ReadWrite);
 	
 	EntityQueryLODChange = EntityQuery;
-	EntityQueryLODChange.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQueryLODChange.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	EntityQueryLODChange.AddRequirement<FMassTrafficPIDVehicleControlFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	EntityQueryLODChange.AddRequirement<FMassTrafficPIDControlInterpolationFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	EntityQueryLODChange.AddRequirement<FMassTrafficVehicleDamageFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
 	EntityQueryLODChange.AddConstSharedRequirement<FMassTrafficVehiclePhysicsSharedParameters>();
 
 	ProcessorRequirements.AddSubsystemRequirement<UMassLODSubsystem>(EMassFragmentAccess::ReadOnly);
@@ -73,6 +84,7 @@ void UMassTrafficVehicleSimulationLODProcessor::ConfigureQueries(const TSharedRe
 void UMassTrafficVehicleSimulationLODProcessor::InitializeInternal(UObject& InOwner, const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	LODCalculator.Initialize(BaseLODDistance, BufferHysteresisOnDistancePercentage / 100.0f, LODMaxCount, nullptr, DistanceToFrustum, DistanceToFrustumHysteresis, VisibleLODDistance);
+	bArchetypeStableSimulationLOD = GetDefault<UMassTrafficSettings>()->bArchetypeStableSimulationLOD;
 #if WITH_MASSTRAFFIC_DEBUG
 	LogOwner = UWorld::GetSubsystem<UMassTrafficSubsystem>(InOwner.GetWorld());
 #endif // WITH_MASSTRAFFIC_DEBUG
@@ -84,6 +96,12 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 	const UMassLODSubsystem& LODSubsystem = Context.GetSubsystemChecked<UMassLODSubsystem>();
 	const TArray<FViewerInfo>& Viewers = LODSubsystem.GetViewers();
 	LODCalculator.PrepareExecution(Viewers);
+
+	UWorld* World = EntityManager.GetWorld();
+	check(World);
+	const float Time = World->GetTimeSeconds();
+
+	LODPromotions.Reset();
 	
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("CalculateLOD"))
@@ -93,6 +111,13 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 			const TConstArrayView<FMassViewerInfoFragment> ViewersInfoList = Context.GetFragmentView<FMassViewerInfoFragment>();
 			const TArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetMutableFragmentView<FMassTrafficSimulationLODFragment>();
 			LODCalculator.CalculateLOD(Context, ViewersInfoList, SimulationLODFragments);
+
+			// Remember the distance based LOD, so demotions forced by LODMaxCount below can be told apart from it.
+			// (See all PREDICTIVELOD.)
+			for (FMassTrafficSimulationLODFragment& SimulationLODFragment : SimulationLODFragments)
+			{
+				SimulationLODFragment.DistanceLOD = SimulationLODFragment.LOD;
+			}
 		});
 	}
 
@@ -110,15 +135,76 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 		}
 	}
 
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("DelayDemotionsAndCollectPromotions"))
+
+		// Only once LODs are final after any count adjustment, which would otherwise recalculate held LODs from
+		// distance again. This must visit the same chunks as CalculateLOD, so deferred promotion flags are only
+		// cleared here.
+		EntityQueryCalculateLOD.ForEachEntityChunk(Context, [this, Time](FMassExecutionContext& Context)
+		{
+			const TConstArrayView<FMassViewerInfoFragment> ViewersInfoList = Context.GetFragmentView<FMassViewerInfoFragment>();
+			const TArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetMutableFragmentView<FMassTrafficSimulationLODFragment>();
+			FMassTrafficSimulationLODChunkFragment& SimulationLODChunkFragment = Context.GetMutableChunkFragment<FMassTrafficSimulationLODChunkFragment>();
+			SimulationLODChunkFragment.bHasDeferredPromotions = false;
+
+			for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+			{
+				FMassTrafficSimulationLODFragment& SimulationLODFragment = SimulationLODFragments[EntityIt];
+				if (SimulationLODFragment.PrevLOD == EMassLOD::Max)
+				{
+					continue;
+				}
+
+				// Hold back demotions until they've been calculated for DemotionDelay, unless forced further by
+				// LODMaxCount. (See all PREDICTIVELOD.)
+				if (DemotionDelay > 0.0f && SimulationLODFragment.LOD > SimulationLODFragment.PrevLOD && SimulationLODFragment.LOD == SimulationLODFragment.DistanceLOD)
+				{
+					if (SimulationLODFragment.DemotionRequestTime < 0.0f)
+					{
+						SimulationLODFragment.DemotionRequestTime = Time;
+					}
+					if (Time - SimulationLODFragment.DemotionRequestTime < DemotionDelay)
+					{
+						SimulationLODFragment.LOD = SimulationLODFragment.PrevLOD;
+						continue;
+					}
+				}
+				SimulationLODFragment.DemotionRequestTime = -1.0f;
+
+				// Collect promotions to budget once all LODs are final, prioritizing visible vehicles by treating
+				// them as half as far away. Deferred promotions flag their chunk to be recalculated next frame.
+				// (See all LODPROMOTIONBUDGET.)
+				if (MaxPromotionsPerFrame > 0 && SimulationLODFragment.LOD < SimulationLODFragment.PrevLOD)
+				{
+					const float VisibilityScale = SimulationLODFragment.Visibility == EMassVisibility::CanBeSeen ? 1.0f : 4.0f;
+					LODPromotions.Add({ &SimulationLODFragment, ViewersInfoList[EntityIt].ClosestViewerDistanceSq * VisibilityScale, &SimulationLODChunkFragment.bHasDeferredPromotions });
+				}
+			}
+		});
+	}
+
+	if (MaxPromotionsPerFrame > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("LimitLODPromotions"))
+
+		const int32 NumDeferredPromotions = UE::MassTraffic::LimitLODPromotions(LODPromotions, MaxPromotionsPerFrame);
+		INC_DWORD_STAT_BY(STAT_Traffic_SimLODPromotionBacklog, NumDeferredPromotions);
+	}
+
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("LODChanges"))
 		
-		EntityQueryLODChange.ForEachEntityChunk(Context, [this](FMassExecutionContext& QueryContext)
+		int32 NumArchetypeMoves = 0;
+		EntityQueryLODChange.ForEachEntityChunk(Context, [this, &NumArchetypeMoves](FMassExecutionContext& QueryContext)
 		{
 			const FMassTrafficVehiclePhysicsSharedParameters& PhysicsSharedFragment = QueryContext.GetConstSharedFragment<FMassTrafficVehiclePhysicsSharedParameters>();  
 
 			const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = QueryContext.GetFragmentView<FMassTrafficSimulationLODFragment>();
-			const TConstArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = QueryContext.GetFragmentView<FMassTrafficVehiclePhysicsFragment>();
+			const TArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehiclePhysicsFragment>();
+			const TArrayView<FMassTrafficPIDVehicleControlFragment> PIDVehicleControlFragments = QueryContext.GetMutableFragmentView<FMassTrafficPIDVehicleControlFragment>();
+			const TArrayView<FMassTrafficPIDControlInterpolationFragment> PIDControlInterpolationFragments = QueryContext.GetMutableFragmentView<FMassTrafficPIDControlInterpolationFragment>();
+			const TArrayView<FMassTrafficVehicleDamageFragment> VehicleDamageFragments = QueryContext.GetMutableFragmentView<FMassTrafficVehicleDamageFragment>();
 			
 			for (FMassExecutionContext::FEntityIterator EntityIt = QueryContext.CreateEntityIterator(); EntityIt; ++EntityIt)
 			{
@@ -138,8 +224,19 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 										, FMassTrafficPIDVehicleControlFragment(PhysicsSharedFragment.Template->SimpleVehiclePhysicsConfig.MaxSteeringAngle)
 										, FMassTrafficPIDControlInterpolationFragment()
 										, FMassTrafficVehicleDamageFragment());
+								++NumArchetypeMoves;
 							}
 						}
+						// Re-activating fragments kept from a previous stint at Medium or High LOD?
+						else if (bArchetypeStableSimulationLOD && SimulationLODFragment.PrevLOD > EMassLOD::Medium)
+						{
+							// Re-initialize in place, exactly as if they had just been added
+							check(PhysicsSharedFragment.Template);
+							SimpleVehiclePhysicsFragments[EntityIt] = PhysicsSharedFragment.Template->SimpleVehiclePhysicsFragmentTemplate;
+							PIDVehicleControlFragments[EntityIt] = FMassTrafficPIDVehicleControlFragment(PhysicsSharedFragment.Template->SimpleVehiclePhysicsConfig.MaxSteeringAngle);
+							PIDControlInterpolationFragments[EntityIt] = FMassTrafficPIDControlInterpolationFragment();
+							VehicleDamageFragments[EntityIt] = FMassTrafficVehicleDamageFragment();
+						}
 					}
 					// Was Medium or High LOD? 
 					else if (SimulationLODFragment.PrevLOD <= EMassLOD::Medium)
@@ -147,8 +244,11 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 						// Had simple physics?
 						// If there was no VehicleType.SimpleVehiclePhysicsFragmentTemplate (no physics actor set in
 						// the vehicle type configuration to generate it from) then we couldn't
-						// add the fragments above. 
-						if (SimpleVehiclePhysicsFragments.Num())
+						// add the fragments above.
+						//
+						// With archetype stable simulation LOD, the fragments are simply left in place to be ignored
+						// until the vehicle returns to Medium LOD. (See all ARCHETYPESTABLELOD.)
+						if (SimpleVehiclePhysicsFragments.Num() && !bArchetypeStableSimulationLOD)
 						{
 							// We assume here this was High LOD and also had PIDControl fragment etc  
 							QueryContext.Defer().PushCommand<FMassCommandRemoveFragments<
@@ -157,20 +257,18 @@ void UMassTrafficVehicleSimulationLODProcessor::Execute(FMassEntityManager& Enti
 									, FMassTrafficPIDControlInterpolationFragment
 									, FMassTrafficVehicleDamageFragment>>
 								(QueryContext.GetEntity(EntityIt));
+							++NumArchetypeMoves;
 						}
 					}
 				}
 			}
 		});
+		INC_DWORD_STAT_BY(STAT_Traffic_SimLODArchetypeMoves, NumArchetypeMoves);
 	}
 
-	UWorld* World = EntityManager.GetWorld();
-
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("VariableTickRates"))
 		
-		check(World);
-		const float Time = World->GetTimeSeconds();
 		EntityQueryVariableTick.ForEachEntityChunk(Context, [this, Time](FMassExecutionContext& QueryContext)
 		{
 			FMassSimulationVariableTickSharedFragment& TickRateSharedFragment = QueryContext.GetMutableSharedFragment<FMassSimulationVariableTickSharedFragment>();
@@ -41,6 +41,8 @@ void UMassTrafficVehicleSimulationTrait::BuildTemplate(FMassEntityTemplateBuildC
 	SimulationLODFragment.LOD = EMassLOD::Off;
 	SimulationLODFragment.PrevLOD = EMassLOD::Max;
 	BuildContext.AddTag<FMassOffLODTag>();
+	BuildContext.AddChunkFragment<FMassTrafficSimulationLODChunkFragment>();
+	BuildContext.AddFragment<FMassTrafficPredictiveLODFragment>();
 
 	// Vehicle control fragment
 	// @todo Replace FMassTrafficVehicleControlFragment::bRestrictedToTrunkLanesOnly usage with
@@ -48,6 +50,12 @@ void UMassTrafficVehicleSimulationTrait::BuildTemplate(FMassEntityTemplateBuildC
 	FMassTrafficVehicleControlFragment& VehicleControlFragment = BuildContext.AddFragment_GetRef<FMassTrafficVehicleControlFragment>();
 	VehicleControlFragment.bRestrictedToTrunkLanesOnly = Params.bRestrictedToTrunkLanesOnly;
 
+	// (See all ANALYTICMOTION.)
+	if (Params.bAnalyticMotion)
+	{
+		BuildContext.AddFragment<FMassTrafficAnalyticMotionFragment>();
+	}
+
 	// Variable tick
 	BuildContext.AddFragment<FMassSimulationVariableTickFragment>();
 	BuildContext.AddChunkFragment<FMassSimulationVariableTickChunkFragment>();
@@ -78,7 +86,7 @@ void UMassTrafficVehicleSimulationTrait::BuildTemplate(FMassEntityTemplateBuildC
 	if (Params.PhysicsVehicleTemplateActor)
 	{
 		// Extract physics setup from PhysicsVehicleTemplateActor into shared fragment
-		const FMassTrafficSimpleVehiclePhysicsTemplate* Template = MassTrafficSubsystem->GetOrExtractVehiclePhysicsTemplate(Params.PhysicsVehicleTemplateActor);
+		const FMassTrafficSimpleVehiclePhysicsTemplate* Template = MassTrafficSubsystem->GetOrExtractVehiclePhysicsTemplate(Params.PhysicsVehicleTemplateActor, Params.PhysicsVehicleData);
 
 		// Register & add shared fragment
 		if (LIKELY(!BuildContext.IsInspectingData()))
@@ -4,12 +4,14 @@
 #include "MassCommonUtils.h"
 
 #include "MassEntityConfigAsset.h"
+#include "MassLODSubsystem.h"
 #include "MassTrafficChooseNextLaneProcessor.h"
 #include "MassTrafficFieldOperations.h"
 #include "MassTrafficFindNextVehicleProcessor.h"
 #include "MassTrafficInitInterpolationProcessor.h"
 #include "MassTrafficInitTrafficVehicleSpeedProcessor.h"
 #include "MassTrafficInitTrafficVehiclesProcessor.h"
+#include "MassTrafficSpawnPoints.h"
 #include "MassTrafficSubsystem.h"
 #include "MassTrafficUpdateDistanceToNearestObstacleProcessor.h"
 #include "MassTrafficUpdateVelocityProcessor.h"
@@ -17,6 +19,7 @@
 
 #include "ZoneGraphSubsystem.h"
 #include "ZoneGraphQuery.h"
+#include "Async/ParallelFor.h"
 
 void UMassTrafficVehicleSpawnDataGenerator::Generate(UObject& QueryOwner,
 	TConstArrayView<FMassSpawnedEntityType> EntityTypes, int32 Count,
@@ -105,9 +108,10 @@ void UMassTrafficVehicleSpawnDataGenerator::Generate(UObject& QueryOwner,
 		MatchedEntityTypeSpacing.Add(MatchedEntityTypeSpacingIndex);
 	}
 	
-	// Get a list of obstacles to avoid when spawning
+	// Get a list of obstacles to avoid when spawning, hashed by exclusion radius
 	TArray<FVector> ObstacleLocationsToAvoid;
 	MassTrafficSubsystem->GetAllObstacleLocations(ObstacleLocationsToAvoid);
+	const UE::MassTraffic::FObstacleExclusionGrid ObstacleExclusionGrid(ObstacleLocationsToAvoid, ObstacleExclusionRadius);
 
 	// Find potential spawn points.
 	TArray<TArray<FZoneGraphLaneLocation>> SpawnPointsPerSpacing;
@@ -137,22 +141,30 @@ void UMassTrafficVehicleSpawnDataGenerator::Generate(UObject& QueryOwner,
 		};
 
 		// Filter locations to ensure we don't spawn near obstacles (player)
-		const float ObstacleRadiusSquared = FMath::Square(ObstacleExclusionRadius);
 		auto LaneLocationFilterFunction = [&](const FZoneGraphLaneLocation& LaneLocation)
 		{
-			// Make sure there are no obstacles.
-			// !This won't scale past very few obstacles!
-			for (const FVector & ObstacleLocation : ObstacleLocationsToAvoid)
-			{
-				if (FVector::DistSquared(LaneLocation.Position, ObstacleLocation) < ObstacleRadiusSquared)
-				{
-					return false;
-				}
-			}
-
-			return true;
+			return !ObstacleExclusionGrid.IsExcluded(LaneLocation.Position);
 		};
 		
+		// Sample from baked spawn points if we have up to date ones for this zone graph
+		const FMassTrafficBakedZoneGraphSpawnPoints* BakedZoneGraphSpawnPoints = BakedSpawnPoints ? BakedSpawnPoints->FindZoneGraphSpawnPoints(*ZoneGraphStorage) : nullptr;
+		if (BakedZoneGraphSpawnPoints && SampleBakedLanePoints(
+			*ZoneGraphStorage,
+			*BakedSpawnPoints,
+			*BakedZoneGraphSpawnPoints,
+			RandomStream,
+			DefaultAndVehicleTypeSpacings,
+			MinGapBetweenSpaces,
+			/*Out*/SpawnPointsPerSpacing,
+			LaneFilterFunction, LaneLocationFilterFunction))
+		{
+			continue;
+		}
+		if (BakedSpawnPoints)
+		{
+			UE_LOG(LogMassTraffic, Warning, TEXT("%s - %s has no up to date spawn points for zone graph %d. Falling back to runtime spawn point generation."), ANSI_TO_TCHAR(__FUNCTION__), *BakedSpawnPoints->GetName(), TrafficZoneGraphData.DataHandle.Index);
+		}
+		
 		// Find the non-overlapping spawn point candidates - for each unique vehicle type spacing.
 		const bool bFoundPoints = FindNonOverlappingLanePoints(
 			*ZoneGraphStorage,
@@ -225,6 +237,90 @@ void UMassTrafficVehicleSpawnDataGenerator::Generate(UObject& QueryOwner,
 		}
 	}
 
+	// Queue the vehicles for streaming spawn, rather than returning them to the spawner to create all at once.
+	// (See all STREAMINGSPAWN.)
+	if (bStreamingSpawn && !Results.IsEmpty())
+	{
+		FMassTrafficStreamingSpawnRequest StreamingSpawnRequest;
+		StreamingSpawnRequest.Owner = &QueryOwner;
+		StreamingSpawnRequest.SpawnDataProcessor = Results[0].SpawnDataProcessor;
+		StreamingSpawnRequest.PostSpawnProcessors = Results[0].PostSpawnProcessors;
+		StreamingSpawnRequest.MaxVehiclesPerFrame = MaxStreamingSpawnVehiclesPerFrame;
+		StreamingSpawnRequest.EntityConfigs.Reserve(EntityTypes.Num());
+		for (const FMassSpawnedEntityType& EntityType : EntityTypes)
+		{
+			StreamingSpawnRequest.EntityConfigs.Add(EntityType.EntityConfig);
+		}
+
+		// Assign each spawn point to a ring, by its distance to the nearest viewer
+		const UMassLODSubsystem* LODSubsystem = UWorld::GetSubsystem<UMassLODSubsystem>(World);
+		TArray<FVector, TInlineAllocator<8>> ViewerLocations;
+		if (LODSubsystem)
+		{
+			for (const FViewerInfo& Viewer : LODSubsystem->GetViewers())
+			{
+				if (Viewer.Handle.IsValid())
+				{
+					ViewerLocations.Add(Viewer.Location);
+				}
+			}
+		}
+		
+		const float RingWidth = FMath::Max(StreamingSpawnRingWidth, 1.0f);
+		for (const FMassEntitySpawnDataGeneratorResult& Result : Results)
+		{
+			for (const FZoneGraphLaneLocation& LaneLocation : Result.SpawnData.Get<FMassTrafficVehiclesSpawnData>().LaneLocations)
+			{
+				FMassTrafficStreamingSpawnPoint& SpawnPoint = StreamingSpawnRequest.SpawnPoints.AddDefaulted_GetRef();
+				SpawnPoint.LaneLocation = LaneLocation;
+				SpawnPoint.EntityTypeIndex = Result.EntityConfigIndex;
+				if (!ViewerLocations.IsEmpty())
+				{
+					float MinDistanceSquared = TNumericLimits<float>::Max();
+					for (const FVector& ViewerLocation : ViewerLocations)
+					{
+						MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared2D(ViewerLocation, LaneLocation.Position));
+					}
+					SpawnPoint.ViewerRing = FMath::FloorToInt32(FMath::Sqrt(MinDistanceSquared) / RingWidth);
+				}
+			}
+		}
+
+		// Sort by ring, then group by lane, so lanes are spawned whole in rings expanding out from the viewers. A lane
+		// spanning multiple rings is spawned with its nearest point's ring.
+		TMap<FZoneGraphLaneHandle, int32> LaneRings;
+		for (const FMassTrafficStreamingSpawnPoint& SpawnPoint : StreamingSpawnRequest.SpawnPoints)
+		{
+			int32& LaneRing = LaneRings.FindOrAdd(SpawnPoint.LaneLocation.LaneHandle, SpawnPoint.ViewerRing);
+			LaneRing = FMath::Min(LaneRing, SpawnPoint.ViewerRing);
+		}
+		for (FMassTrafficStreamingSpawnPoint& SpawnPoint : StreamingSpawnRequest.SpawnPoints)
+		{
+			SpawnPoint.ViewerRing = LaneRings.FindChecked(SpawnPoint.LaneLocation.LaneHandle);
+		}
+		StreamingSpawnRequest.SpawnPoints.Sort([](const FMassTrafficStreamingSpawnPoint& A, const FMassTrafficStreamingSpawnPoint& B)
+		{
+			if (A.ViewerRing != B.ViewerRing)
+			{
+				return A.ViewerRing < B.ViewerRing;
+			}
+			if (A.LaneLocation.LaneHandle.DataHandle.Index != B.LaneLocation.LaneHandle.DataHandle.Index)
+			{
+				return A.LaneLocation.LaneHandle.DataHandle.Index < B.LaneLocation.LaneHandle.DataHandle.Index;
+			}
+			if (A.LaneLocation.LaneHandle.Index != B.LaneLocation.LaneHandle.Index)
+			{
+				return A.LaneLocation.LaneHandle.Index < B.LaneLocation.LaneHandle.Index;
+			}
+			return A.LaneLocation.DistanceAlongLane < B.LaneLocation.DistanceAlongLane;
+		});
+
+		MassTrafficSubsystem->QueueStreamingSpawn(MoveTemp(StreamingSpawnRequest));
+
+		// Nothing left for the spawner to create itself. The subsystem tracks the streamed vehicles against it instead.
+		Results.Reset();
+	}
+
 	// Return results
 	FinishedGeneratingSpawnPointsDelegate.Execute(Results);
 }
@@ -315,13 +411,24 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 	
 	// Loop lanes.
 	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FindNonOverlappingLanePoints"))
+
 		// Prepare discrete random stream to pull spacing choices from.
 		const UE::MassTraffic::TDiscreteRandomStream VehicleTypeSpacingDiscreteRandomStream(SpacingProportions);
 
+		// Lanes are independent, so we generate their points in parallel, each lane with its own random stream seeded
+		// from the lane index, then gather the points in lane order. This keeps the output independent of how lanes
+		// are distributed across threads.
+		const uint32 BaseLaneSeed = RandomStream.GetUnsignedInt();
+		TArray<TArray<TPair<int32, FZoneGraphLaneLocation>>> SpawnPointsPerLane;
+		SpawnPointsPerLane.SetNum(LaneIndices.Num());
+
 		// Go through all lanes we have chosen to work on.
-		for (int32 LaneIndexIndex = 0; LaneIndexIndex < LaneIndices.Num(); ++LaneIndexIndex)
+		ParallelFor(LaneIndices.Num(), [&](const int32 LaneIndexIndex)
 		{
 			const int32 LaneIndex = LaneIndices[LaneIndexIndex];
+			const FRandomStream LaneRandomStream(static_cast<int32>(HashCombineFast(BaseLaneSeed, static_cast<uint32>(LaneIndex))));
+			TArray<TPair<int32, FZoneGraphLaneLocation>>& LaneSpawnPoints = SpawnPointsPerLane[LaneIndexIndex];
 
 			float LaneLength = 0.0f;
 			UE::ZoneGraph::Query::GetLaneLength(ZoneGraphStorage, LaneIndex, LaneLength);
@@ -346,7 +453,7 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 				if (DensityMultiplier <= 0.0f)
 				{
 					// Continue to next lane, no spaces generated on this lane
-					continue;  
+					return;  
 				}
 
 				SpacingScale = 1.0f / DensityMultiplier;
@@ -356,7 +463,7 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 			auto ChooseVehicleTypeSpacingIndex = [&]() -> int32
 			{
 				// Pick a unique vehicle spacing index.
-				int32 VehicleTypeSpacingIndex = VehicleTypeSpacingDiscreteRandomStream.RandChoice(RandomStream);
+				int32 VehicleTypeSpacingIndex = VehicleTypeSpacingDiscreteRandomStream.RandChoice(LaneRandomStream);
 
 				const int32 NumSpacings = Spacings.Num();
 				for (int32 I = 0; I < NumSpacings; I++)
@@ -384,7 +491,7 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 
 			
 			// Allocate points along the lane, starting at 0
-			for (float Distance = RandomStream.FRandRange(MinGapBetweenSpaces, MaxGapBetweenSpaces); Distance < LaneLength; /*see end of block*/)
+			for (float Distance = LaneRandomStream.FRandRange(MinGapBetweenSpaces, MaxGapBetweenSpaces); Distance < LaneLength; /*see end of block*/)
 			{
 				const int32 VehicleTypeSpacingIndex = ChooseVehicleTypeSpacingIndex();
 				if (VehicleTypeSpacingIndex == INDEX_NONE)
@@ -403,12 +510,21 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 					if (!LaneLocationFilterFunction || LaneLocationFilterFunction(LaneLocation))
 					{
 						// Passed filter, add location
-						OutSpawnPointsPerSpacing[VehicleTypeSpacingIndex].Add(LaneLocation);
+						LaneSpawnPoints.Emplace(VehicleTypeSpacingIndex, LaneLocation);
 					}
 				}
 				
 				// Advance ahead past the space we just consumed, plus a random gap.
-				Distance += VehicleTypeSpacing.Space * SpacingScale + RandomStream.FRandRange(MinGapBetweenSpaces, MaxGapBetweenSpaces);
+				Distance += VehicleTypeSpacing.Space * SpacingScale + LaneRandomStream.FRandRange(MinGapBetweenSpaces, MaxGapBetweenSpaces);
+			}
+		}, GMassTrafficParallelSpawnPointGeneration ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+
+		// Gather lane points in lane order
+		for (const TArray<TPair<int32, FZoneGraphLaneLocation>>& LaneSpawnPoints : SpawnPointsPerLane)
+		{
+			for (const TPair<int32, FZoneGraphLaneLocation>& LaneSpawnPoint : LaneSpawnPoints)
+			{
+				OutSpawnPointsPerSpacing[LaneSpawnPoint.Key].Add(LaneSpawnPoint.Value);
 			}
 		}
 	}
@@ -428,5 +544,123 @@ bool UMassTrafficVehicleSpawnDataGenerator::FindNonOverlappingLanePoints(
 	}
 
 
+	return true;
+}
+
+bool UMassTrafficVehicleSpawnDataGenerator::SampleBakedLanePoints(
+	const FZoneGraphStorage& ZoneGraphStorage,
+	const UMassTrafficSpawnPointsDataAsset& BakedSpawnPoints,
+	const FMassTrafficBakedZoneGraphSpawnPoints& ZoneGraphSpawnPoints,
+	const FRandomStream& RandomStream,
+	const TArray<FMassTrafficVehicleSpacing>& Spacings,
+	const float MinGapBetweenSpaces,
+	TArray<TArray<FZoneGraphLaneLocation>>& OutSpawnPointsPerSpacing,
+	TFunction<bool(const FZoneGraphStorage&, int32 LaneIndex)> LaneFilterFunction,
+	TFunction<bool(const FZoneGraphLaneLocation& LaneLocation)> LaneLocationFilterFunction
+)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("SampleBakedLanePoints"))
+
+	check(Spacings.Num() > 0);
+
+	// Match Spacings to baked spacings
+	TArray<int32> SpacingToBakedSpacingIndex;
+	TArray<float> SpacingProportions;
+	SpacingToBakedSpacingIndex.Init(INDEX_NONE, Spacings.Num());
+	SpacingProportions.SetNumZeroed(Spacings.Num());
+	for (int32 SpacingIndex = 0; SpacingIndex < Spacings.Num(); ++SpacingIndex)
+	{
+		const FMassTrafficVehicleSpacing& Spacing = Spacings[SpacingIndex];
+		if (Spacing.Proportion <= 0.0f)
+		{
+			continue;
+		}
+
+		SpacingToBakedSpacingIndex[SpacingIndex] = BakedSpawnPoints.VehicleTypeSpacings.IndexOfByPredicate([&Spacing](const FMassTrafficVehicleSpacing& BakedSpacing)
+		{
+			return BakedSpacing.Name == Spacing.Name && FMath::IsNearlyEqual(BakedSpacing.Space, Spacing.Space);
+		});
+		if (SpacingToBakedSpacingIndex[SpacingIndex] == INDEX_NONE)
+		{
+			return false;
+		}
+
+		SpacingProportions[SpacingIndex] = Spacing.Proportion;
+	}
+
+	OutSpawnPointsPerSpacing.SetNum(Spacings.Num());
+
+	const UE::MassTraffic::TDiscreteRandomStream VehicleTypeSpacingDiscreteRandomStream(SpacingProportions);
+	TArray<int32, TInlineAllocator<8>> NextBakedSpawnPointIndices;
+	for (const FMassTrafficBakedLaneSpawnPoints& BakedLane : ZoneGraphSpawnPoints.Lanes)
+	{
+		if (!ZoneGraphStorage.Lanes.IsValidIndex(BakedLane.LaneIndex))
+		{
+			continue;
+		}
+		if (LaneFilterFunction && !LaneFilterFunction(ZoneGraphStorage, BakedLane.LaneIndex))
+		{
+			continue;
+		}
+
+		// Walk along the lane, choosing a spacing for each space and taking that spacing's next baked point that
+		// doesn't overlap the last space taken, plus MinGapBetweenSpaces. Points baked for the same spacing are already
+		// at least MinGapBetweenSpaces apart, but interleaved spacings aren't. If the chosen spacing has no more points,
+		// try the others in turn.
+		NextBakedSpawnPointIndices.Init(0, Spacings.Num());
+		float FreeDistance = 0.0f;
+		while (true)
+		{
+			const int32 ChosenSpacingIndex = VehicleTypeSpacingDiscreteRandomStream.RandChoice(RandomStream);
+			
+			int32 SpacingIndex = INDEX_NONE;
+			int32 BakedSpawnPointIndex = INDEX_NONE;
+			for (int32 I = 0; I < Spacings.Num() && BakedSpawnPointIndex == INDEX_NONE; ++I)
+			{
+				SpacingIndex = (ChosenSpacingIndex + I) % Spacings.Num();
+				const int32 BakedSpacingIndex = SpacingToBakedSpacingIndex[SpacingIndex];
+				if (BakedSpacingIndex == INDEX_NONE)
+				{
+					continue;
+				}
+
+				for (int32& NextIndex = NextBakedSpawnPointIndices[SpacingIndex]; NextIndex < BakedLane.SpawnPoints.Num(); ++NextIndex)
+				{
+					const FMassTrafficBakedLaneSpawnPoint& BakedSpawnPoint = BakedLane.SpawnPoints[NextIndex];
+					if (BakedSpawnPoint.SpacingIndex == BakedSpacingIndex
+						&& BakedSpawnPoint.LaneLocation.DistanceAlongLane - Spacings[SpacingIndex].Space / 2.0f >= FreeDistance)
+					{
+						BakedSpawnPointIndex = NextIndex++;
+						break;
+					}
+				}
+			}
+			if (BakedSpawnPointIndex == INDEX_NONE)
+			{
+				break;
+			}
+
+			// Baked lane handles refer to the zone graph data as registered at bake time
+			FZoneGraphLaneLocation LaneLocation = BakedLane.SpawnPoints[BakedSpawnPointIndex].LaneLocation;
+			LaneLocation.LaneHandle = FZoneGraphLaneHandle(BakedLane.LaneIndex, ZoneGraphStorage.DataHandle);
+			FreeDistance = LaneLocation.DistanceAlongLane + Spacings[SpacingIndex].Space / 2.0f + MinGapBetweenSpaces;
+
+			if (!LaneLocationFilterFunction || LaneLocationFilterFunction(LaneLocation))
+			{
+				OutSpawnPointsPerSpacing[SpacingIndex].Add(LaneLocation);
+			}
+		}
+	}
+
+	// Shuffle results
+	for (TArray<FZoneGraphLaneLocation>& OutSpawnPoints : OutSpawnPointsPerSpacing)
+	{
+		for (int32 I = 0; I < OutSpawnPoints.Num(); ++I)
+		{
+			const int32 J = RandomStream.RandHelper(OutSpawnPoints.Num());
+			OutSpawnPoints.Swap(I, J);
+		}
+	}
+
 	return true;
 }
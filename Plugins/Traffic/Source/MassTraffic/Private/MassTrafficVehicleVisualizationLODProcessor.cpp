@@ -2,8 +2,12 @@
 
 #include "MassTrafficVehicleVisualizationLODProcessor.h"
 #include "MassTraffic.h"
+#include "MassTrafficOcclusion.h"
 #include "MassCommonFragments.h"
 #include "MassExecutionContext.h"
+#include "MassLODSubsystem.h"
+#include "MassZoneGraphNavigationFragments.h"
+#include "Algo/NoneOf.h"
 #include "GameFramework/PlayerController.h"
 #include "VisualLogger/VisualLogger.h"
 #include "DrawDebugHelpers.h"
@@ -16,6 +20,8 @@ DECLARE_DWORD_COUNTER_STAT(TEXT("Vis LOD Low"), STAT_Traffic_VisLODLow, STATGROU
 DECLARE_DWORD_COUNTER_STAT(TEXT("Vis LOD Off"), STAT_Traffic_VisLODOff, STATGROUP_Traffic);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Vis LOD Max"), STAT_Traffic_VisLODMax, STATGROUP_Traffic);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Total Visible"), STAT_Traffic_VisTotal, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vis LOD Promotion Backlog"), STAT_Traffic_VisLODPromotionBacklog, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Occluded Vehicles"), STAT_Traffic_OccludedVehicles, STATGROUP_Traffic);
 
 namespace UE::MassTraffic
 {
@@ -25,6 +31,7 @@ namespace UE::MassTraffic
 }
 
 UMassTrafficVehicleVisualizationLODProcessor::UMassTrafficVehicleVisualizationLODProcessor()
+	: OcclusionEntityQuery(*this)
 {
 	ExecutionFlags = (int32)(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
 	
@@ -33,6 +40,9 @@ UMassTrafficVehicleVisualizationLODProcessor::UMassTrafficVehicleVisualizationLO
 	ExecutionOrder.ExecuteAfter.Reset();
 	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::FrameStart);
 	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::VehicleLODCollector);
+
+	// Occlusion only affects visualization, so let simulation LOD see the unoccluded frustum distances first
+	ExecutionOrder.ExecuteAfter.Add(UE::MassTraffic::ProcessorGroupNames::VehicleSimulationLOD);
 }
 
 void UMassTrafficVehicleVisualizationLODProcessor::InitializeInternal(UObject& InOwner, const TSharedRef<FMassEntityManager>& EntityManager)
@@ -61,18 +71,77 @@ void UMassTrafficVehicleVisualizationLODProcessor::ConfigureQueries(const TShare
 	DebugEntityQuery.AddRequirement<FMassTrafficDebugFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 
 	FilterTag = FMassTrafficVehicleTag::StaticStruct();
+
+	// Parked vehicles have no lane to look up occlusion for. (See all OCCLUSIONPVS.)
+	OcclusionEntityQuery.AddTagRequirement<FMassTrafficVehicleTag>(EMassFragmentPresence::All);
+	OcclusionEntityQuery.AddRequirement<FMassZoneGraphLaneLocationFragment>(EMassFragmentAccess::ReadOnly);
+	OcclusionEntityQuery.AddRequirement<FMassViewerInfoFragment>(EMassFragmentAccess::ReadWrite);
+
+	ProcessorRequirements.AddSubsystemRequirement<UMassTrafficSubsystem>(EMassFragmentAccess::ReadOnly);
+	ProcessorRequirements.AddSubsystemRequirement<UMassLODSubsystem>(EMassFragmentAccess::ReadOnly);
 }
 
 void UMassTrafficVehicleVisualizationLODProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& ExecutionContext)
 {
 	ForceOffLOD((bool)UE::MassTraffic::GTrafficTurnOffVisualization);
 
+	if (GMassTrafficOcclusionCulling)
+	{
+		ApplyOcclusion(ExecutionContext);
+	}
+
 	Super::Execute(EntityManager, ExecutionContext);
 
+	// Put back the collector's frustum distances, which stay in the viewer info of chunks it doesn't refresh every
+	// frame and are read by other processors. (See all OCCLUSIONPVS.)
+	for (const TPair<FMassViewerInfoFragment*, float>& OccludedViewerInfo : OccludedViewerInfos)
+	{
+		OccludedViewerInfo.Key->ClosestDistanceToFrustum = OccludedViewerInfo.Value;
+	}
+	OccludedViewerInfos.Reset();
+
+	// Limit promotions among the close entities, whose LOD was just calculated, by LOD significance.
+	// (See all LODPROMOTIONBUDGET.)
+	if (MaxPromotionsPerFrame > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("LimitLODPromotions"))
+
+		LODPromotions.Reset();
+		CloseEntityQuery.ForEachEntityChunk(ExecutionContext, [this](FMassExecutionContext& Context)
+		{
+			const TArrayView<FMassRepresentationLODFragment> VisualizationLODFragments = Context.GetMutableFragmentView<FMassRepresentationLODFragment>();
+			for (FMassRepresentationLODFragment& VisualizationLODFragment : VisualizationLODFragments)
+			{
+				if (VisualizationLODFragment.LOD < VisualizationLODFragment.PrevLOD && VisualizationLODFragment.PrevLOD != EMassLOD::Max)
+				{
+					LODPromotions.Add({ &VisualizationLODFragment, VisualizationLODFragment.LODSignificance });
+				}
+			}
+		});
+
+		const int32 NumDeferredPromotions = UE::MassTraffic::LimitLODPromotions(LODPromotions, MaxPromotionsPerFrame);
+		INC_DWORD_STAT_BY(STAT_Traffic_VisLODPromotionBacklog, NumDeferredPromotions);
+
+		// LODSignificance was calculated for the promoted LOD, and would pick that LOD's representation and ISM
+		// significance range. Bring reverted promotions back to the most significant end of their previous LOD, which
+		// is as close as their distance allows.
+		if (NumDeferredPromotions > 0)
+		{
+			for (int32 PromotionIndex = MaxPromotionsPerFrame; PromotionIndex < LODPromotions.Num(); ++PromotionIndex)
+			{
+				FMassRepresentationLODFragment& VisualizationLODFragment = *LODPromotions[PromotionIndex].LODFragment;
+				if (VisualizationLODFragment.LOD == VisualizationLODFragment.PrevLOD)
+				{
+					VisualizationLODFragment.LODSignificance = FMath::Max(VisualizationLODFragment.LODSignificance, static_cast<float>(VisualizationLODFragment.LOD));
+				}
+			}
+		}
+	}
+
 #if WITH_MASSTRAFFIC_DEBUG
 	UWorld* World = EntityManager.GetWorld();
 
-	// LOD Stats
+	// LOD Stats, counted once promotions are limited so deferred promotions count at the LOD they were held at
 	DebugEntityQuery.ForEachEntityChunk(ExecutionContext, [this](FMassExecutionContext& Context)
 	{
 		TConstArrayView<FMassRepresentationLODFragment> VisualizationLODFragments = Context.GetFragmentView<FMassRepresentationLODFragment>();
@@ -143,6 +212,83 @@ void UMassTrafficVehicleVisualizationLODProcessor::Execute(FMassEntityManager& E
 #endif
 }
 
+void UMassTrafficVehicleVisualizationLODProcessor::ApplyOcclusion(FMassExecutionContext& ExecutionContext)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("ApplyOcclusion"))
+
+	const UMassTrafficSubsystem& MassTrafficSubsystem = ExecutionContext.GetSubsystemChecked<UMassTrafficSubsystem>();
+	const TArray<FViewerInfo>& Viewers = ExecutionContext.GetSubsystemChecked<UMassLODSubsystem>().GetViewers();
+
+	// Find the baked cell containing each viewer, for each zone graph with baked occlusion. Nothing we don't have baked
+	// visibility for can be culled, so zone graphs with any viewer outside their baked cells aren't occluded at all.
+	const TIndirectArray<FMassTrafficZoneGraphData>& TrafficZoneGraphDataArray = MassTrafficSubsystem.GetTrafficZoneGraphData();
+	ZoneGraphViewerCells.SetNum(TrafficZoneGraphDataArray.Num());
+
+	bool bAnyOcclusion = false;
+	for (int32 ZoneGraphIndex = 0; ZoneGraphIndex < TrafficZoneGraphDataArray.Num(); ++ZoneGraphIndex)
+	{
+		TArray<const FMassTrafficBakedOcclusionCell*, TInlineAllocator<4>>& ViewerCells = ZoneGraphViewerCells[ZoneGraphIndex];
+		ViewerCells.Reset();
+
+		const FMassTrafficBakedZoneGraphOcclusion* Occlusion = TrafficZoneGraphDataArray[ZoneGraphIndex].Occlusion;
+		if (!Occlusion)
+		{
+			continue;
+		}
+
+		for (const FViewerInfo& Viewer : Viewers)
+		{
+			if (!Viewer.Handle.IsValid())
+			{
+				continue;
+			}
+
+			const FMassTrafficBakedOcclusionCell* ViewerCell = Occlusion->FindCell(Viewer.Location);
+			if (!ViewerCell)
+			{
+				ViewerCells.Reset();
+				break;
+			}
+			ViewerCells.Add(ViewerCell);
+		}
+
+		bAnyOcclusion |= !ViewerCells.IsEmpty();
+	}
+
+	if (!bAnyOcclusion)
+	{
+		return;
+	}
+
+	OcclusionEntityQuery.ForEachEntityChunk(ExecutionContext, [this](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FMassZoneGraphLaneLocationFragment> LaneLocationFragments = Context.GetFragmentView<FMassZoneGraphLaneLocationFragment>();
+		const TArrayView<FMassViewerInfoFragment> ViewerInfoFragments = Context.GetMutableFragmentView<FMassViewerInfoFragment>();
+
+		for (FMassExecutionContext::FEntityIterator EntityIt = Context.CreateEntityIterator(); EntityIt; ++EntityIt)
+		{
+			const FZoneGraphLaneHandle& LaneHandle = LaneLocationFragments[EntityIt].LaneHandle;
+			if (!ZoneGraphViewerCells.IsValidIndex(LaneHandle.DataHandle.Index))
+			{
+				continue;
+			}
+
+			const TArray<const FMassTrafficBakedOcclusionCell*, TInlineAllocator<4>>& ViewerCells = ZoneGraphViewerCells[LaneHandle.DataHandle.Index];
+			if (!ViewerCells.IsEmpty() && Algo::NoneOf(ViewerCells, [&LaneHandle](const FMassTrafficBakedOcclusionCell* ViewerCell)
+				{
+					return ViewerCell->IsLaneVisible(LaneHandle.Index);
+				}))
+			{
+				FMassViewerInfoFragment& ViewerInfoFragment = ViewerInfoFragments[EntityIt];
+				OccludedViewerInfos.Emplace(&ViewerInfoFragment, ViewerInfoFragment.ClosestDistanceToFrustum);
+				ViewerInfoFragment.ClosestDistanceToFrustum = TNumericLimits<float>::Max();
+			}
+		}
+	});
+
+	INC_DWORD_STAT_BY(STAT_Traffic_OccludedVehicles, OccludedViewerInfos.Num());
+}
+
 //----------------------------------------------------------------------//
 // UMassTrafficVehicleLODCollectorProcessor
 //----------------------------------------------------------------------//
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MassTrafficVehicleVisualizationProcessor.h"
+#include "MassTraffic.h"
 #include "MassTrafficVehicleComponent.h"
 #include "MassTrafficSubsystem.h"
 #include "MassTrafficDamageRepairProcessor.h"
@@ -12,6 +13,9 @@
 #include "Components/PrimitiveComponent.h"
 #include "VisualLogger/VisualLogger.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicle Custom Data Writes"), STAT_Traffic_VehicleCustomDataWrites, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicle Custom Data Writes Skipped"), STAT_Traffic_VehicleCustomDataWritesSkipped, STATGROUP_Traffic);
+
 //----------------------------------------------------------------------//
 // FMassTrafficVehicleInstanceCustomData 
 //----------------------------------------------------------------------//
@@ -209,7 +213,9 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::ConfigureQueries(con
 
 	EntityQuery.AddRequirement<FMassTrafficRandomFractionFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddRequirement<FMassTrafficVehicleLightsFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassTrafficVehicleCustomDataFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FMassTrafficVehiclePhysicsFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassTrafficSimulationLODFragment>(EMassFragmentAccess::ReadOnly);
 
 #if WITH_MASSTRAFFIC_DEBUG
 	DebugEntityQuery = EntityQuery;
@@ -221,16 +227,19 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::ConfigureQueries(con
 
 void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& ExecutionContext)
 {
-	EntityQuery.ForEachEntityChunk(ExecutionContext, [this](FMassExecutionContext& Context)
+	// Chunks are processed on worker threads, gathering ISM instances to be added to the representation subsystem
+	// afterwards on the game thread, and deferring all actor updates. (See all PARALLELISMGATHER.)
+	UE::MassTraffic::ForEachVisualizationEntityChunk(EntityQuery, ExecutionContext, [this](FMassExecutionContext& Context)
 	{
-		// Get mutable ISMInfos to append instances & custom data to
-		UMassRepresentationSubsystem* RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
-		check(RepresentationSubsystem);
-		const FMassInstancedStaticMeshInfoArrayView ISMInfo = RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+		TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData>::FChunkInstances ChunkInstances = InstanceGatherer.BeginChunk(Context);
+		int32 NumChunkCustomDataWrites = 0;
+		int32 NumChunkCustomDataWritesSkipped = 0;
 
 		const TConstArrayView<FMassTrafficRandomFractionFragment> RandomFractionFragments = Context.GetFragmentView<FMassTrafficRandomFractionFragment>();
 		const TConstArrayView<FMassTrafficVehiclePhysicsFragment> SimpleVehiclePhysicsFragments = Context.GetFragmentView<FMassTrafficVehiclePhysicsFragment>();
+		const TConstArrayView<FMassTrafficSimulationLODFragment> SimulationLODFragments = Context.GetFragmentView<FMassTrafficSimulationLODFragment>();
 		const TConstArrayView<FMassTrafficVehicleLightsFragment> VehicleStateFragments = Context.GetFragmentView<FMassTrafficVehicleLightsFragment>();
+		const TArrayView<FMassTrafficVehicleCustomDataFragment> CustomDataFragments = Context.GetMutableFragmentView<FMassTrafficVehicleCustomDataFragment>();
 		const TConstArrayView<FTransformFragment> TransformFragments = Context.GetFragmentView<FTransformFragment>();
 		const TConstArrayView<FMassRepresentationLODFragment> RepresentationLODFragments = Context.GetFragmentView<FMassRepresentationLODFragment>();
 		const TArrayView<FMassActorFragment> ActorFragments = Context.GetMutableFragmentView<FMassActorFragment>();
@@ -244,10 +253,38 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 			const FMassTrafficVehicleLightsFragment& VehicleStateFragment = VehicleStateFragments[EntityIt];
 			const FTransformFragment& TransformFragment = TransformFragments[EntityIt];
 			const FMassRepresentationLODFragment& RepresentationLODFragment = RepresentationLODFragments[EntityIt];
+			FMassTrafficVehicleCustomDataFragment& CustomDataFragment = CustomDataFragments[EntityIt];
 			FMassActorFragment& ActorFragment = ActorFragments[EntityIt];
 			FMassRepresentationFragment& RepresentationFragment = VisualizationFragments[EntityIt];
 
 			AActor* Actor = ActorFragment.GetMutable();
+			const FMassTrafficPackedVehicleInstanceCustomData PackedCustomData = FMassTrafficVehicleInstanceCustomData::MakeTrafficVehicleCustomData(VehicleStateFragment, RandomFractionFragment);
+
+			// SetCustomPrimitiveDataFloat ignores unchanged values itself, but each write still pushes a deferred
+			// command that walks all the actor's primitive components, including its child actors', on the game
+			// thread. Skip that for actors already holding this custom data. A representation switch always rewrites
+			// it, as pooled actors may have been used by another vehicle since. (See all DIRTYCUSTOMDATA.)
+			const auto UpdateActorCustomData = [&]()
+			{
+				if (CustomDataFragment.Actor == TObjectKey<AActor>(Actor)
+					&& CustomDataFragment.PackedParam1Bits == PackedCustomData.GetPackedParam1Bits()
+					&& RepresentationFragment.PrevRepresentation == RepresentationFragment.CurrentRepresentation)
+				{
+					++NumChunkCustomDataWritesSkipped;
+					return;
+				}
+
+				Context.Defer().PushCommand<FMassDeferredSetCommand>([Actor, PackedCustomData](FMassEntityManager&)
+				{
+					Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/true, [&PackedCustomData](UPrimitiveComponent* PrimitiveComponent)
+					{
+						PrimitiveComponent->SetCustomPrimitiveDataFloat(/*DataIndex*/1, PackedCustomData.PackedParam1);
+					});
+				});
+				CustomDataFragment.Actor = TObjectKey<AActor>(Actor);
+				CustomDataFragment.PackedParam1Bits = PackedCustomData.GetPackedParam1Bits();
+				++NumChunkCustomDataWrites;
+			};
 			
 			// Update active representation
 			{
@@ -259,11 +296,9 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 						// Add ISMC instance with custom data
 						if (RepresentationFragment.StaticMeshDescHandle.IsValid())
 						{
-							ISMInfo[RepresentationFragment.StaticMeshDescHandle.ToIndex()].AddBatchedTransform(Entity
-								, TransformFragment.GetTransform(), RepresentationFragment.PrevTransform, RepresentationLODFragment.LODSignificance);
-
-							const FMassTrafficPackedVehicleInstanceCustomData PackedCustomData = FMassTrafficVehicleInstanceCustomData::MakeTrafficVehicleCustomData(VehicleStateFragment, RandomFractionFragment);
-							ISMInfo[RepresentationFragment.StaticMeshDescHandle.ToIndex()].AddBatchedCustomData(PackedCustomData, RepresentationLODFragment.LODSignificance);
+							// Instances are rebatched every frame, so their custom data must be too
+							ChunkInstances.Instances.Add({ Entity, RepresentationFragment.StaticMeshDescHandle
+								, TransformFragment.GetTransform(), RepresentationFragment.PrevTransform, RepresentationLODFragment.LODSignificance, PackedCustomData });
 						}
 						break;
 					}
@@ -281,46 +316,41 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 								Actor->SetActorTransform(NewActorTransform);
 							});
 						
-							// Has simple vehicle physics?
-							if (!SimpleVehiclePhysicsFragments.IsEmpty())
+							// Has active simple vehicle physics? Fragments may be kept, inactive, below Medium LOD. (See all ARCHETYPESTABLELOD.)
+							if (!SimpleVehiclePhysicsFragments.IsEmpty() && SimulationLODFragments[EntityIt].IsMediumLODSimulationActive())
 							{
-								// Has a UMassTrafficVehicleComponent with wheel mesh references? 
-								UMassTrafficVehicleComponent* MassTrafficVehicleComponent = Actor->FindComponentByClass<UMassTrafficVehicleComponent>();
-								if (MassTrafficVehicleComponent)
+								// Update wheel component transforms from simple vehicle physics sim, if there's a
+								// UMassTrafficVehicleComponent with wheel mesh references. This is looked up in the
+								// deferred command as we may be on a worker thread here.
+								Context.Defer().PushCommand<FMassDeferredSetCommand>([Actor, Entity](FMassEntityManager& CallbackEntitySubsystem)
 								{
-									// Update wheel component transforms from simple vehicle physics sim
-									Context.Defer().PushCommand<FMassDeferredSetCommand>([MassTrafficVehicleComponent, Entity](FMassEntityManager& CallbackEntitySubsystem)
+									UMassTrafficVehicleComponent* MassTrafficVehicleComponent = Actor->FindComponentByClass<UMassTrafficVehicleComponent>();
+									if (MassTrafficVehicleComponent && CallbackEntitySubsystem.IsEntityValid(Entity))
 									{
-										if (CallbackEntitySubsystem.IsEntityValid(Entity))
+										// If the simulation LOD changed this frame, removal of the
+										// FDataFragment_SimpleVehiclePhysics would have been queued and executed 
+										// before this deferred command, thus actually removing the fragment we
+										// thought we had via the check above. So we safely check again here for
+										// FDataFragment_SimpleVehiclePhysics using an FMassEntityView
+										const FMassTrafficVehiclePhysicsFragment* SimpleVehiclePhysicsFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>(Entity);
+										const FMassTrafficSimulationLODFragment* SimulationLODFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficSimulationLODFragment>(Entity);
+										if (SimpleVehiclePhysicsFragment && SimulationLODFragment && SimulationLODFragment->IsMediumLODSimulationActive())
 										{
-											// If the simulation LOD changed this frame, removal of the
-											// FDataFragment_SimpleVehiclePhysics would have been queued and executed 
-											// before this deferred command, thus actually removing the fragment we
-											// thought we had via the check above. So we safely check again here for
-											// FDataFragment_SimpleVehiclePhysics using an FMassEntityView
-											const FMassTrafficVehiclePhysicsFragment* SimpleVehiclePhysicsFragment = CallbackEntitySubsystem.GetFragmentDataPtr<FMassTrafficVehiclePhysicsFragment>(Entity);
-											if (SimpleVehiclePhysicsFragment)
+											// Init offsets?
+											if (MassTrafficVehicleComponent->WheelOffsets.IsEmpty())
 											{
-												// Init offsets?
-												if (MassTrafficVehicleComponent->WheelOffsets.IsEmpty())
-												{
-													MassTrafficVehicleComponent->InitWheelAttachmentOffsets(SimpleVehiclePhysicsFragment->VehicleSim);
-												}
-								
-												// Update
-												MassTrafficVehicleComponent->UpdateWheelComponents(SimpleVehiclePhysicsFragment->VehicleSim);
+												MassTrafficVehicleComponent->InitWheelAttachmentOffsets(SimpleVehiclePhysicsFragment->VehicleSim);
 											}
+							
+											// Update
+											MassTrafficVehicleComponent->UpdateWheelComponents(SimpleVehiclePhysicsFragment->VehicleSim);
 										}
-									});
-								}
+									}
+								});
 							}
 						
 							// Update primitive component custom data
-							const FMassTrafficPackedVehicleInstanceCustomData PackedCustomData = FMassTrafficVehicleInstanceCustomData::MakeTrafficVehicleCustomData(VehicleStateFragment, RandomFractionFragment);
-							Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/true, [&PackedCustomData](UPrimitiveComponent* PrimitiveComponent)
-							{
-								PrimitiveComponent->SetCustomPrimitiveDataFloat(/*DataIndex*/1, PackedCustomData.PackedParam1);
-							});
+							UpdateActorCustomData();
 						}
 
 						break;
@@ -333,11 +363,7 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 						if (Actor)
 						{
 							// Update primitive component custom data
-							const FMassTrafficPackedVehicleInstanceCustomData PackedCustomData = FMassTrafficVehicleInstanceCustomData::MakeTrafficVehicleCustomData(VehicleStateFragment, RandomFractionFragment);
-							Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors*/true, [&PackedCustomData](UPrimitiveComponent* PrimitiveComponent)
-							{
-								PrimitiveComponent->SetCustomPrimitiveDataFloat(/*DataIndex*/1, PackedCustomData.PackedParam1);
-							});
+							UpdateActorCustomData();
 						}
 
 						break;
@@ -352,8 +378,15 @@ void UMassTrafficVehicleUpdateCustomVisualizationProcessor::Execute(FMassEntityM
 
 			RepresentationFragment.PrevTransform = TransformFragment.GetTransform();
 		}
+
+		InstanceGatherer.EndChunk(MoveTemp(ChunkInstances));
+
+		INC_DWORD_STAT_BY(STAT_Traffic_VehicleCustomDataWrites, NumChunkCustomDataWrites);
+		INC_DWORD_STAT_BY(STAT_Traffic_VehicleCustomDataWritesSkipped, NumChunkCustomDataWritesSkipped);
 	});
 
+	InstanceGatherer.AddBatchedInstances();
+
 #if WITH_MASSTRAFFIC_DEBUG
 	// Debug draw current visualization
 	if (GMassTrafficDebugVisualization && LogOwner.IsValid())
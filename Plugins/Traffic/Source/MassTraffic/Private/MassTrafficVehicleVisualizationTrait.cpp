@@ -50,4 +50,5 @@ void UMassTrafficVehicleVisualizationTrait::BuildTemplate(FMassEntityTemplateBui
 	
 	BuildContext.RequireFragment<FMassTrafficRandomFractionFragment>();
 	BuildContext.RequireFragment<FMassTrafficVehicleLightsFragment>();
+	BuildContext.AddFragment<FMassTrafficVehicleCustomDataFragment>();
 }
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassTrafficOcclusion.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "ZoneGraphTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+namespace UE::MassTraffic::Tests
+{
+	/** Adds a straight two point lane from Start to End to ZoneGraphStorage */
+	static void AddStraightLane(FZoneGraphStorage& ZoneGraphStorage, const FVector& Start, const FVector& End)
+	{
+		FZoneLaneData& LaneData = ZoneGraphStorage.Lanes.AddDefaulted_GetRef();
+		LaneData.PointsBegin = ZoneGraphStorage.LanePoints.Num();
+		LaneData.PointsEnd = LaneData.PointsBegin + 2;
+
+		const FVector Tangent = (End - Start).GetSafeNormal();
+		ZoneGraphStorage.LanePoints.Append({ Start, End });
+		ZoneGraphStorage.LaneTangentVectors.Append({ Tangent, Tangent });
+		ZoneGraphStorage.LaneUpVectors.Append({ FVector::UpVector, FVector::UpVector });
+		ZoneGraphStorage.LanePointProgressions.Append({ 0.0f, static_cast<float>(FVector::Dist(Start, End)) });
+	}
+}
+
+/**
+ * Bakes occlusion for two lanes either side of a wall, and checks each lane is only visible from its own side.
+ * (See all OCCLUSIONPVS.)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMassTrafficOcclusionBakeTest, "System.Plugins.MassTraffic.Occlusion.Bake", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMassTrafficOcclusionBakeTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Cube mesh"), CubeMesh))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld*/false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	// A 100cm cube scaled into a wall along X at Y = 10000, taller than any viewer sample
+	AStaticMeshActor* Wall = World->SpawnActor<AStaticMeshActor>(FVector(500.0f, 10000.0f, 2000.0f), FRotator::ZeroRotator);
+	Wall->SetActorScale3D(FVector(110.0f, 1.0f, 60.0f));
+	UStaticMeshComponent* WallMeshComponent = Wall->GetStaticMeshComponent();
+	WallMeshComponent->SetMobility(EComponentMobility::Movable);
+	WallMeshComponent->SetStaticMesh(CubeMesh);
+	WallMeshComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+	// Let the physics scene pick up the wall
+	World->Tick(LEVELTICK_All, 1.0f / 30.0f);
+
+	FZoneGraphStorage ZoneGraphStorage;
+	UE::MassTraffic::Tests::AddStraightLane(ZoneGraphStorage, FVector(0.0f, 0.0f, 0.0f), FVector(1000.0f, 0.0f, 0.0f));
+	UE::MassTraffic::Tests::AddStraightLane(ZoneGraphStorage, FVector(0.0f, 20000.0f, 0.0f), FVector(1000.0f, 20000.0f, 0.0f));
+
+	UMassTrafficOcclusionDataAsset* OcclusionData = NewObject<UMassTrafficOcclusionDataAsset>();
+	OcclusionData->CellSize = 1000.0f;
+	OcclusionData->ViewerHeight = 200.0f;
+	OcclusionData->ViewerHeightTolerance = 500.0f;
+	OcclusionData->MaxOcclusionDistance = 30000.0f;
+
+	FMassTrafficBakedZoneGraphOcclusion Occlusion;
+	const bool bBaked = OcclusionData->BakeZoneGraphOcclusion(*World, ZoneGraphStorage, FZoneGraphTagFilter(), Occlusion);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(/*bInformEngineOfWorld*/false);
+
+	if (!TestTrue(TEXT("Bake completed"), bBaked))
+	{
+		return false;
+	}
+
+	// Both lanes cross two cells
+	TestEqual(TEXT("Number of viewer cells"), Occlusion.Cells.Num(), 4);
+
+	const FVector NearSideViewer(500.0f, 500.0f, 200.0f);
+	const FVector FarSideViewer(500.0f, 20500.0f, 200.0f);
+	TestTrue(TEXT("Lane visible from its own side"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, NearSideViewer, 0));
+	TestFalse(TEXT("Lane occluded from the other side of the wall"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, NearSideViewer, 1));
+	TestTrue(TEXT("Other lane visible from its own side"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, FarSideViewer, 1));
+	TestFalse(TEXT("Other lane occluded from the other side of the wall"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, FarSideViewer, 0));
+
+	// Viewers outside any cell's height band, or outside all cells, see every lane
+	TestTrue(TEXT("Lane visible from above the height band"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, NearSideViewer + FVector(0.0f, 0.0f, 10000.0f), 1));
+	TestTrue(TEXT("Lane visible from outside all cells"), UMassTrafficOcclusionDataAsset::IsLaneVisible(Occlusion, FVector(500.0f, 10500.0f, 200.0f), 1));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "HAL/LowLevelMemTracker.h"
 #include "Stats/Stats.h"
 #include "MassCommonTypes.h"
 
@@ -34,6 +35,13 @@ DECLARE_LOG_CATEGORY_EXTERN(LogMassTraffic, Log, All);
 // Stats
 DECLARE_STATS_GROUP(TEXT("Traffic"), STATGROUP_Traffic, STATCAT_Advanced)
 
+// LLM tags for traffic owned heap allocations. Fragment memory lives in Mass archetype chunks and is reported per
+// archetype by MassTraffic.DumpMemory instead. (See all MEMORYREPORT.)
+LLM_DECLARE_TAG_API(MassTraffic_LaneData, MASSTRAFFIC_API);
+LLM_DECLARE_TAG_API(MassTraffic_Intersections, MASSTRAFFIC_API);
+LLM_DECLARE_TAG_API(MassTraffic_PathFinder, MASSTRAFFIC_API);
+LLM_DECLARE_TAG_API(MassTraffic_Scratch, MASSTRAFFIC_API);
+
 // CVars
 extern int32 GDebugMassTraffic;
 extern int32 GMassTrafficDebugDistanceToNext;
@@ -61,14 +69,23 @@ extern int32 GMassTrafficDrivers;
 extern float GMassTrafficMaxDriverVisualizationDistance;
 extern int32 GMassTrafficMaxDriverVisualizationLOD;
 extern int32 GMassTrafficOverseer;
+extern int32 GMassTrafficMesoscopic;
 extern int32 GMassTrafficRepairDamage;
 extern float GMassTrafficNumTrafficVehiclesScale;
 extern float GMassTrafficNumParkedVehiclesScale;
+extern int32 GMassTrafficParallelSpawnPointGeneration;
+extern int32 GMassTrafficParallelVisualizationGathering;
 extern float GMassTrafficLODPlayerVehicleDistanceScale;
 extern int32 GMassTrafficSleepEnabled;
 extern int32 GMassTrafficSleepCounterThreshold;
 extern float GMassTrafficLinearSpeedSleepThreshold;
 extern float GMassTrafficControlInputWakeTolerance;
+extern int32 GMassTrafficQueueSleepEnabled;
+extern float GMassTrafficQueueSleepSpeedThreshold;
+extern int32 GMassTrafficAnalyticMotion;
+extern int32 GMassTrafficOcclusionCulling;
+
+extern int32 GMassTrafficTimeSlicing;
 
 extern float GMassTrafficSpeedLimitScale;
 
@@ -12,7 +12,7 @@
 
 
 // Forward declarations
-struct FMassTrafficLaneSegment;
+struct FMassTrafficCompactLaneSegment;
 struct FTransformFragment;
 struct FZoneGraphStorage;
 enum class EMassTrafficCombineDistanceToNextType : uint8;
@@ -42,7 +42,7 @@ void DrawDebugParkingSpace(UWorld* World, const FVector& Location, const FQuat&
 void DrawDebugTrafficLight(const UWorld* World, const FVector& Location, const FVector& XDirection, const FVector* IntersectionSideMidpoint = nullptr, const FColor ColorForVehicles = FColor::White, const FColor ColorForPedestrians_FrontSide = FColor::White, const FColor ColorForPedestrians_LeftSide = FColor::White, const FColor ColorForPedestrians_RightSide = FColor::White,bool bPersist = false, float Lifetime = 10.0f);
 void DrawDebugSpeed(UWorld* World, const FVector& Location, const float Speed, const bool bBraking, const float DistanceAlongLane, const float CurrentLaneLength, const int32 LOD, const bool bVisLog = false, const UObject* VisLogOwner = nullptr);
 void DrawDebugChaosVehicleControl(UWorld* World, const FVector& Location, const FVector& SpeedControlChaseTargetLocation, const FVector& SteeringControlChaseTargetLocation, float TargetSpeed, float Throttle, float Brake, float Steering, bool bHandBrake, bool bVisLog = false, const UObject* VisLogOwner = nullptr);
-void DrawDebugLaneSegment(UWorld* World, const FMassTrafficLaneSegment& LaneSegment, bool bVisLog = false, const UObject* VisLogOwner = nullptr);
+void DrawDebugLaneSegment(UWorld* World, const FZoneGraphStorage& ZoneGraphStorage, const FMassTrafficCompactLaneSegment& CompactLaneSegment, bool bVisLog = false, const UObject* VisLogOwner = nullptr);
 void DrawDebugInterpolatedAxles(UWorld* World, const FVector& FrontAxleLocation, const FVector& RearAxleLocation, bool bVisLog = false, const UObject* VisLogOwner = nullptr);
 void DrawDebugShouldStop(float DebugDrawSize, const FColor DebugDrawColor, const FString DebugText, bool bVisLog = false, const UObject* VisLogOwner = nullptr, const FTransform* VisLogTransform = nullptr);
 void DrawDebugLaneChange(UWorld* World, const FTransform& Transform, bool bToLeftLane, bool bVisLog = false, const UObject* VisLogOwner = nullptr);
@@ -63,7 +63,7 @@ inline void DrawDebugParkingSpace(UWorld* World, const FVector& Location, const
 inline void DrawDebugTrafficLight(const UWorld* World, const FVector& Location, const FVector& XDirection, const FVector* IntersectionSideMidpoint = nullptr, const FColor ColorForVehicles = FColor::White, const FColor ColorForPedestrians_FrontSide = FColor::White, const FColor ColorForPedestrians_LeftSide = FColor::White, const FColor ColorForPedestrians_RightSide = FColor::White,bool bPersist = false, float Lifetime = 10.0f) {}
 inline void DrawDebugSpeed(UWorld* World, const FVector& Location, const float Speed, const bool bBraking, const float DistanceAlongLane, const float CurrentLaneLength, const int32 LOD, const bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
 inline void DrawDebugChaosVehicleControl(UWorld* World, const FVector& Location, const FVector& SpeedControlChaseTargetLocation, const FVector& SteeringControlChaseTargetLocation, float TargetSpeed, float Throttle, float Brake, float Steering, bool bHandBrake, bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
-inline void DrawDebugLaneSegment(UWorld* World, const FMassTrafficLaneSegment& LaneSegment, bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
+inline void DrawDebugLaneSegment(UWorld* World, const FZoneGraphStorage& ZoneGraphStorage, const FMassTrafficCompactLaneSegment& CompactLaneSegment, bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
 inline void DrawDebugInterpolatedAxles(UWorld* World, const FVector& FrontAxleLocation, const FVector& RearAxleLocation, bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
 inline void DrawDebugShouldStop(float DebugDrawSize, const FColor DebugDrawColor, bool bVisLog = false, const UObject* VisLogOwner = nullptr, const FTransform* VisLogTransform = nullptr) {}
 inline void DrawDebugLaneChange(UWorld* World, const FTransform& Transform, bool bToLeftLane, bool bVisLog = false, const UObject* VisLogOwner = nullptr) {}
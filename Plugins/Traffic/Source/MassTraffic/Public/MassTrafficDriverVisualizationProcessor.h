@@ -7,6 +7,7 @@
 #if UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_6
 #include "MassActorSubsystem.h"
 #endif // UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_6
+#include "MassTrafficInstanceGatherer.h"
 #include "MassTrafficInstancePlaybackHelpers.h"
 #include "MassTrafficDriverVisualizationProcessor.generated.h"
 
@@ -30,9 +31,9 @@ protected:
 	virtual void InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager) override;
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
-private:
+public:
 
-	bool PopulateAnimEvalFromAnimState(
+	static bool PopulateAnimEvalFromAnimState(
 		const UAnimToTextureDataAsset* AnimData,
 		int32 StateIndex,
 		int32 VariationIndex,
@@ -40,14 +41,22 @@ private:
 		const FFloatInterval& InputInterval,
 		FMassTrafficInstancePlaybackData& OutPlaybackData);
 
-	bool PopulateAnimPlaybackFromAnimState(
+	/** Populates the held centered steering frame drawn for drivers beyond FullAnimationDistance. (See all DRIVERLOD.) */
+	static bool PopulateFrozenPose(
+		const UAnimToTextureDataAsset* AnimData,
+		int32 VariationIndex,
+		FMassTrafficInstancePlaybackData& OutPlaybackData);
+
+private:
+
+	static bool PopulateAnimPlaybackFromAnimState(
 		const UAnimToTextureDataAsset* AnimData, 
 		int32 StateIndex, 
 		int32 VariationIndex, 
 		float GlobalStartTime,
 		FMassTrafficInstancePlaybackData& OutPlaybackData);
 
-	bool PopulateAnimFromAnimState(
+	static bool PopulateAnimFromAnimState(
 		const UAnimToTextureDataAsset* AnimData, 
 		int32 StateIndex, 
 		int32 VariationIndex,
@@ -78,4 +87,7 @@ public:
 	UWorld* World;
 
 	FMassEntityQuery EntityQuery_Conditional;
+
+	/** (See all PARALLELISMGATHER.) */
+	TMassTrafficInstanceGatherer<FMassTrafficInstancePlaybackData> InstanceGatherer;
 };
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "MassRepresentationTypes.h"
 #include "Engine/DataTable.h"
 #include "AnimToTextureDataAsset.h"
+#include "MassTrafficInstancePlaybackHelpers.h"
 #include "MassTrafficDrivers.generated.h"
 
 class UStaticMesh;
@@ -88,6 +89,32 @@ struct MASSTRAFFIC_API FMassTrafficDriversParameters : public FMassConstSharedFr
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay)
 	EDriverAnimStateVariation AnimStateVariationOverride = EDriverAnimStateVariation::None;
 
+	/**
+	 * Drivers within this distance of a viewer are fully animated, playing idle, look and steering animations. Beyond
+	 * it they hold a single frozen pose, skipping all animation state updates. (See all DRIVERLOD.)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mass Traffic|Drivers|LOD", meta=(ClampMin="0.0", UIMin="0.0"))
+	float FullAnimationDistance = 5000.0f;
+
+	/**
+	 * Drivers beyond this distance from all viewers aren't drawn at all. MassTraffic.MaxDriverVisualizationDistance and
+	 * MassTraffic.MaxDriverVisualizationLOD can further limit drawn drivers. (See all DRIVERLOD.)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mass Traffic|Drivers|LOD", meta=(ClampMin="0.0", UIMin="0.0"))
+	float FrozenPoseDistance = 20000.0f;
+
 	UPROPERTY(Transient)
 	TArray<FStaticMeshInstanceVisualizationDescHandle> DriverTypesStaticMeshDescHandle;
+
+	/**
+	 * Frozen pose instance custom data for each driver type and anim state variation, indexed by
+	 * GetFrozenPoseIndex. (See all DRIVERLOD.)
+	 */
+	UPROPERTY(Transient)
+	TArray<FMassTrafficInstancePlaybackData> DriverTypesFrozenPose;
+
+	static int32 GetFrozenPoseIndex(const int32 DriverTypeIndex, const int32 AnimStateVariationIndex)
+	{
+		return DriverTypeIndex * static_cast<int32>(EDriverAnimStateVariation::None) + AnimStateVariationIndex;
+	}
 };
@@ -26,6 +26,9 @@ protected:
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
 	FMassEntityQuery NominalTrafficVehicleEntityQuery;
+
+	/** Deviation check progress over entity buckets. @see UMassTrafficProcessorBase::ForTimeSlicedEntityBuckets */
+	FMassTrafficTimeSliceCursor NominalTimeSliceCursor;
 	
 	FMassEntityQuery DeviantTrafficVehicleEntityQuery;
 	
@@ -17,6 +17,7 @@
 #include "MassEntityTypes.h"
 #include "ZoneGraphTypes.h"
 #include "MassTrafficSettings.h"
+#include "UObject/ObjectKey.h"
 #include "MassTrafficFragments.generated.h"
 
 
@@ -88,6 +89,17 @@ struct MASSTRAFFIC_API FMassTrafficRecyclableVehicleTag : public FMassTag
 };
 
 
+/**
+ * Special tag for traffic vehicles absorbed into a mesoscopic lane's aggregate flow. Swapped in place of
+ * FMassTrafficVehicleTag while the vehicle is off every lane, waiting to be re-emitted. (See all MESOSCOPIC.)
+ */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficMesoscopicVehicleTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+
 /** Special tag to differentiate the TrafficIntersection from the rest of the other entities */
 USTRUCT()
 struct MASSTRAFFIC_API FMassTrafficIntersectionTag : public FMassTag
@@ -318,6 +330,14 @@ struct FMassTrafficPeriod
 
 	MASSTRAFFIC_API FMassTrafficLightControl* GetTrafficLightControl(const int8 TrafficLightIndex);
 
+	/** @return Heap memory used by this period's lane and light control arrays beyond their inline storage. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return VehicleLanes.GetAllocatedSize() + VehicleLaneIndices_ClosedInNextPeriod.GetAllocatedSize()
+			+ CrosswalkLanes.GetAllocatedSize() + CrosswalkWaitingLanes.GetAllocatedSize()
+			+ TrafficLightControls.GetAllocatedSize();
+	}
+
 	
 	// Accessing open vehicle lanes this period controls.
 	
@@ -408,6 +428,17 @@ struct MASSTRAFFIC_API FMassTrafficIntersectionFragment : public FMassFragment
 
 	uint8 CurrentPeriodIndex = 0;
 
+	/** @return Heap memory used by Periods and TrafficLights beyond their inline storage. (See all MEMORYREPORT.) */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = Periods.GetAllocatedSize() + TrafficLights.GetAllocatedSize();
+		for (const FMassTrafficPeriod& Period : Periods)
+		{
+			AllocatedSize += Period.GetAllocatedSize();
+		}
+		return AllocatedSize;
+	}
+
 	FORCEINLINE FMassTrafficPeriod& AddPeriod(const float Duration)
 	{
 		FMassTrafficPeriod& Period = Periods.AddDefaulted_GetRef();
@@ -493,6 +524,59 @@ struct MASSTRAFFIC_API FMassTrafficSimulationLODFragment : public FMassFragment
 	/** Visibility Info */
 	EMassVisibility Visibility = EMassVisibility::Max;
 	EMassVisibility PrevVisibility = EMassVisibility::Max;
+
+	/** LOD calculated from viewer distances this frame, before any adjustment from LODMaxCount. (See all PREDICTIVELOD.) */
+	TEnumAsByte<EMassLOD::Type> DistanceLOD = EMassLOD::Max;
+
+	/** World time this vehicle's pending demotion to a lower LOD was first calculated, or < 0 if none. (See all PREDICTIVELOD.) */
+	float DemotionRequestTime = -1.0f;
+
+	/**
+	 * Whether medium LOD simulation fragments (FMassTrafficPIDVehicleControlFragment, FMassTrafficVehiclePhysicsFragment
+	 * etc.) should be used to simulate this vehicle, if present. Only needs checking with
+	 * UMassTrafficSettings::bArchetypeStableSimulationLOD, where these fragments are kept on vehicles below Medium LOD.
+	 */
+	bool IsMediumLODSimulationActive() const
+	{
+		return LOD <= EMassLOD::Medium;
+	}
+};
+
+/**
+ * Viewer distances of a vehicle as last calculated by the LOD collector, before UMassTrafficPredictiveLODProcessor
+ * pulls them in towards where viewers are heading. The collector doesn't refresh every chunk every frame, so these are
+ * restored before each frame's look ahead is applied, rather than repeatedly lowering already lowered distances.
+ * (See all PREDICTIVELOD.)
+ */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficPredictiveLODFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** FMassViewerInfoFragment distances as last calculated by the LOD collector */
+	float CollectedClosestViewerDistanceSq = 0.0f;
+	float CollectedClosestDistanceToFrustum = 0.0f;
+
+	/** FMassViewerInfoFragment distances as last written with look ahead, to tell whether the collector has since refreshed them */
+	float LookAheadClosestViewerDistanceSq = 0.0f;
+	float LookAheadClosestDistanceToFrustum = 0.0f;
+
+	/** Whether look ahead was applied to FMassViewerInfoFragment last frame */
+	bool bHasLookAhead = false;
+};
+
+/** Simulation LOD chunk fragment */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficSimulationLODChunkFragment : public FMassChunkFragment
+{
+	GENERATED_BODY()
+
+	/**
+	 * True if promotions in this chunk were deferred by UMassTrafficVehicleSimulationLODProcessor::MaxPromotionsPerFrame
+	 * so its LOD is recalculated next frame, rather than waiting for its regular LOD calculation.
+	 * (See all LODPROMOTIONBUDGET.)
+	 */
+	bool bHasDeferredPromotions = false;
 };
 
 
@@ -677,6 +761,22 @@ struct MASSTRAFFIC_API FMassTrafficVehicleLightsFragment : public FMassFragment
 	bool bBrakeLights : 1;
 };
 
+/**
+ * Packed instance custom data last written to a traffic vehicle's actor, so no deferred command is pushed to update the
+ * actor's primitive components until the vehicle's lights change. (See all DIRTYCUSTOMDATA.)
+ */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficVehicleCustomDataFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Bits of FMassTrafficPackedVehicleInstanceCustomData::PackedParam1 last written to Actor */
+	uint32 PackedParam1Bits = 0;
+
+	/** Actor PackedParam1Bits were last written to, if any */
+	TObjectKey<AActor> Actor;
+};
+
 /** Miscellaneous fields commonly used in traffic vehicle movement control */
 USTRUCT()
 struct MASSTRAFFIC_API FMassTrafficVehicleControlFragment : public FMassFragment
@@ -716,6 +816,110 @@ struct MASSTRAFFIC_API FMassTrafficVehicleControlFragment : public FMassFragment
 
 	// -1.0 to 1.0 
 	float EmergencyOffset = 0.0f;
+
+	// The lane this vehicle went to sleep on, stopped in a queue behind another stopped vehicle. (See all QUEUESLEEP.)
+	FZoneGraphLaneHandle QueueSleepLaneHandle;
+
+	// QueueSleepEpoch of the QueueSleepLaneHandle lane when this vehicle went to sleep. (See all QUEUESLEEP.)
+	uint16 QueueSleepEpoch = 0;
+
+	/**
+	 * Returns true if this vehicle is queue sleeping on QueueSleepLane and hasn't since been woken by it.
+	 * (See all QUEUESLEEP.)
+	 * @param QueueSleepLane The traffic lane data for QueueSleepLaneHandle, or nullptr if it's no longer available
+	 * @see FZoneGraphTrafficLaneData::WakeQueueSleepingVehicles
+	 */
+	FORCEINLINE bool IsQueueSleeping(const FZoneGraphTrafficLaneData* QueueSleepLane) const
+	{
+		return QueueSleepLane && QueueSleepLane->LaneHandle == QueueSleepLaneHandle && QueueSleepLane->QueueSleepEpoch == QueueSleepEpoch;
+	}
+
+	/** Puts this vehicle to sleep, at rest, until Lane wakes its queue sleeping vehicles. (See all QUEUESLEEP.) */
+	FORCEINLINE void QueueSleep(const FZoneGraphTrafficLaneData& Lane)
+	{
+		QueueSleepLaneHandle = Lane.LaneHandle;
+		QueueSleepEpoch = Lane.QueueSleepEpoch;
+		Speed = 0.0f;
+	}
+
+	/** Wakes this vehicle from queue sleep, if it was queue sleeping. (See all QUEUESLEEP.) */
+	FORCEINLINE void WakeFromQueueSleep()
+	{
+		QueueSleepLaneHandle.Reset();
+	}
+};
+
+
+/**
+ * Closed form free flow trajectory state for Low & Off LOD simple vehicles. Kept out of
+ * FMassTrafficVehicleControlFragment as it's only needed by vehicle types that opt in with
+ * FMassTrafficVehicleSimulationParameters::bAnalyticMotion. (See all ANALYTICMOTION.)
+ */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficAnalyticMotionFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	// Seconds since this vehicle started following its trajectory, or negative if it isn't
+	float Time = -1.0f;
+
+	// Time beyond which the trajectory is no longer valid, e.g: when braking for the lane exit could begin. Solved once
+	// when the trajectory starts, so advancing it needn't evaluate where the vehicle is to detect the end.
+	float EndTime = 0.0f;
+
+	// Distance along lane and speed the trajectory started with, changing speed at Acceleration (negative to
+	// decelerate) until reaching TargetSpeed
+	float StartDistance = 0.0f;
+	float StartSpeed = 0.0f;
+	float TargetSpeed = 0.0f;
+	float Acceleration = 0.0f;
+
+	// Distance along lane the trajectory last put the vehicle at, to detect it being moved by something else
+	float ResolvedDistanceAlongLane = 0.0f;
+
+	// DistanceToNext below which the trajectory is no longer valid, as we'd start braking for the next vehicle
+	float MinDistanceToNext = 0.0f;
+
+	// Lane the trajectory is along
+	FZoneGraphLaneHandle LaneHandle;
+
+	// NextLane when the trajectory started
+	const FZoneGraphTrafficLaneData* NextLane = nullptr;
+
+	/** Returns true if this vehicle is following a closed form free flow trajectory. */
+	FORCEINLINE bool IsActive() const
+	{
+		return Time >= 0.0f;
+	}
+
+	/** Stops following the closed form free flow trajectory. */
+	FORCEINLINE void Clear()
+	{
+		Time = -1.0f;
+	}
+
+	/** Seconds spent changing speed from StartSpeed to TargetSpeed, before cruising. */
+	FORCEINLINE float GetAccelerationTime() const
+	{
+		// Acceleration and the speed change share a sign, unless they disagree in which case we just cruise
+		return Acceleration != 0.0f ? FMath::Max((TargetSpeed - StartSpeed) / Acceleration, 0.0f) : 0.0f;
+	}
+
+	/** Evaluates the closed form free flow trajectory, Time seconds after it started. */
+	FORCEINLINE void Evaluate(float& OutDistanceAlongLane, float& OutSpeed) const
+	{
+		const float AccelerationTime = GetAccelerationTime();
+		const float AcceleratingTime = FMath::Min(Time, AccelerationTime);
+		const float CruisingTime = FMath::Max(Time - AccelerationTime, 0.0f);
+
+		OutSpeed = StartSpeed + Acceleration * AcceleratingTime;
+		OutDistanceAlongLane = StartDistance
+			+ StartSpeed * AcceleratingTime + 0.5f * Acceleration * FMath::Square(AcceleratingTime)
+			+ TargetSpeed * CruisingTime;
+	}
+
+	/** Returns the time the trajectory reaches DistanceAlongLane, or TNumericLimits<float>::Max() if it never does. */
+	float GetTimeAtDistance(const float DistanceAlongLane) const;
 };
 
 
@@ -880,7 +1084,13 @@ struct MASSTRAFFIC_API FMassTrafficDebugFragment : public FMassFragment
 
 
 /** Interpolation and Lane Segment Structs */
-struct MASSTRAFFIC_API FMassTrafficPositionOnlyLaneSegment
+
+/**
+ * Lane segment identified only by its lane point indices & progressions. Segment points, control points and up vectors
+ * are reconstructed from FZoneGraphStorage on demand. (See all COMPACTLANESEGMENT.)
+ * @see UE::MassTraffic::ResolveLaneSegment
+ */
+struct MASSTRAFFIC_API FMassTrafficCompactLaneSegment
 {
 	FZoneGraphLaneHandle LaneHandle;
 
@@ -888,6 +1098,11 @@ struct MASSTRAFFIC_API FMassTrafficPositionOnlyLaneSegment
 	float EndProgression = 0.0f;
 
 	int32 StartPointIndex = INDEX_NONE;
+};
+
+
+struct MASSTRAFFIC_API FMassTrafficPositionOnlyLaneSegment : FMassTrafficCompactLaneSegment
+{
 	FVector StartPoint;
 	FVector StartControlPoint;
 
@@ -908,7 +1123,9 @@ struct MASSTRAFFIC_API FMassTrafficInterpolationFragment : public FMassFragment
 {
 	GENERATED_BODY()
 
-	FMassTrafficLaneSegment LaneLocationLaneSegment;
+	// Compact, as this is carried by every traffic vehicle & trailer, most of which are Low / Off LOD.
+	// (See all COMPACTLANESEGMENT.)
+	FMassTrafficCompactLaneSegment LaneLocationLaneSegment;
 };
 
 
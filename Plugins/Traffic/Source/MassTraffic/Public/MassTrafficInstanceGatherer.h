@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MassTraffic.h"
+#include "MassEntityQuery.h"
+#include "MassExecutionContext.h"
+#include "MassRepresentationFragments.h"
+#include "MassRepresentationSubsystem.h"
+#include "MassRepresentationTypes.h"
+#include "Misc/ScopeLock.h"
+
+/**
+ * Instanced static mesh instances gathered from entity chunks, possibly in parallel on worker threads, to be added to
+ * their UMassRepresentationSubsystem's instanced static mesh infos afterwards on the game thread.
+ *
+ * This lets visualization processors do their per entity work (transform composition, custom data packing, animation
+ * state etc.) with ParallelForEachEntityChunk, leaving only the final hand-off on the game thread.
+ * (See all PARALLELISMGATHER.)
+ */
+template<typename TCustomData>
+class TMassTrafficInstanceGatherer
+{
+public:
+
+	struct FInstance
+	{
+		FMassEntityHandle Entity;
+		FStaticMeshInstanceVisualizationDescHandle StaticMeshDescHandle;
+		FTransform Transform;
+		FTransform PrevTransform;
+		float LODSignificance = 0.0f;
+		TCustomData CustomData;
+	};
+
+	/** Instances gathered from a single chunk */
+	struct FChunkInstances
+	{
+		UMassRepresentationSubsystem* RepresentationSubsystem = nullptr;
+		TArray<FInstance> Instances;
+	};
+
+	/** Start gathering a chunk's instances. Thread safe. */
+	static FChunkInstances BeginChunk(FMassExecutionContext& Context)
+	{
+		FChunkInstances ChunkInstances;
+		ChunkInstances.RepresentationSubsystem = Context.GetMutableSharedFragment<FMassRepresentationSubsystemSharedFragment>().RepresentationSubsystem;
+		check(ChunkInstances.RepresentationSubsystem);
+		ChunkInstances.Instances.Reserve(Context.GetNumEntities());
+		return ChunkInstances;
+	}
+
+	/** Queue a chunk's gathered instances for AddBatchedInstances. Thread safe. */
+	void EndChunk(FChunkInstances&& ChunkInstances)
+	{
+		if (!ChunkInstances.Instances.IsEmpty())
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			GatheredChunkInstances.Add(MoveTemp(ChunkInstances));
+		}
+	}
+
+	/** Adds all gathered instances to their representation subsystem's instanced static mesh infos. Game thread only. */
+	void AddBatchedInstances()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("AddBatchedInstances"))
+		check(IsInGameThread());
+
+		for (const FChunkInstances& ChunkInstances : GatheredChunkInstances)
+		{
+			const FMassInstancedStaticMeshInfoArrayView ISMInfo = ChunkInstances.RepresentationSubsystem->GetMutableInstancedStaticMeshInfos();
+			for (const FInstance& Instance : ChunkInstances.Instances)
+			{
+				FMassInstancedStaticMeshInfo& InstancedStaticMeshInfo = ISMInfo[Instance.StaticMeshDescHandle.ToIndex()];
+				InstancedStaticMeshInfo.AddBatchedTransform(Instance.Entity, Instance.Transform, Instance.PrevTransform, Instance.LODSignificance);
+				InstancedStaticMeshInfo.AddBatchedCustomData(Instance.CustomData, Instance.LODSignificance);
+			}
+		}
+
+		GatheredChunkInstances.Reset();
+	}
+
+private:
+
+	TArray<FChunkInstances> GatheredChunkInstances;
+	FCriticalSection CriticalSection;
+};
+
+namespace UE::MassTraffic
+{
+
+/** ParallelForEachEntityChunk if MassTraffic.ParallelVisualizationGathering is enabled, ForEachEntityChunk otherwise. (See all PARALLELISMGATHER.) */
+inline void ForEachVisualizationEntityChunk(FMassEntityQuery& EntityQuery, FMassExecutionContext& ExecutionContext, const FMassExecuteFunction& ExecuteFunction)
+{
+	if (GMassTrafficParallelVisualizationGathering)
+	{
+		EntityQuery.ParallelForEachEntityChunk(ExecutionContext, ExecuteFunction);
+	}
+	else
+	{
+		EntityQuery.ForEachEntityChunk(ExecutionContext, ExecuteFunction);
+	}
+}
+
+}
@@ -17,6 +17,11 @@ namespace UE
 namespace MassTraffic
 {
 
+MASSTRAFFIC_API void InitCompactLaneSegment(const FZoneGraphStorage& ZoneGraphStorage, int32 LaneIndex, float DistanceAlongLane, FMassTrafficCompactLaneSegment& InOutLaneSegment);
+
+/** Reconstructs the full lane segment for CompactLaneSegment from ZoneGraphStorage. (See all COMPACTLANESEGMENT.) */
+MASSTRAFFIC_API void ResolveLaneSegment(const FZoneGraphStorage& ZoneGraphStorage, const FMassTrafficCompactLaneSegment& CompactLaneSegment, FMassTrafficLaneSegment& OutLaneSegment);
+
 MASSTRAFFIC_API void InitPositionOnlyLaneSegment(const FZoneGraphStorage& ZoneGraphStorage, int32 LaneIndex, float DistanceAlongLane, FMassTrafficPositionOnlyLaneSegment& InOutLaneSegment);
 	
 MASSTRAFFIC_API void InitLaneSegment(const FZoneGraphStorage& ZoneGraphStorage, int32 LaneIndex, float DistanceAlongLane, FMassTrafficLaneSegment& InOutLaneSegment);
@@ -70,6 +75,37 @@ FORCEINLINE void InterpolatePositionAndOrientationAlongLane(
 	OutTransform.SetRotation(OutOrientation);
 }
 
+/**
+ * As above, but only the compact lane segment is cached for the next call with the full segment reconstructed from
+ * ZoneGraphStorage each call. (See all COMPACTLANESEGMENT.)
+ */
+MASSTRAFFIC_API void InterpolatePositionAndOrientationAlongLane(
+	const FZoneGraphStorage& ZoneGraphStorage, 
+	int32 LaneIndex,
+	float DistanceAlongLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficCompactLaneSegment& InOutLaneSegment,
+	FVector& OutPosition,
+	FQuat& OutOrientation);
+
+FORCEINLINE void InterpolatePositionAndOrientationAlongLane(
+	const FZoneGraphStorage& ZoneGraphStorage, 
+	int32 LaneIndex,
+	float DistanceAlongLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficCompactLaneSegment& InOutLaneSegment,
+	FTransform& OutTransform)
+{
+	FVector OutPosition;
+	FQuat OutOrientation;
+	InterpolatePositionAndOrientationAlongLane(ZoneGraphStorage,
+		LaneIndex, DistanceAlongLane, InterpolationMethod,
+		InOutLaneSegment, OutPosition, OutOrientation);
+
+	OutTransform.SetLocation(OutPosition);
+	OutTransform.SetRotation(OutOrientation);
+}
+
 MASSTRAFFIC_API void InterpolatePositionAlongContinuousLanes(
 	const FZoneGraphStorage& ZoneGraphStorage, 
 	int32 CurrentLaneIndex,
@@ -147,6 +183,43 @@ FORCEINLINE void InterpolatePositionAndOrientationAlongContinuousLanes(
 	OutTransform.SetLocation(OutPosition);
 	OutTransform.SetRotation(OutOrientation);
 }
+
+/** (See all COMPACTLANESEGMENT.) */
+MASSTRAFFIC_API void InterpolatePositionAndOrientationAlongContinuousLanes(
+	const FZoneGraphStorage& ZoneGraphStorage, 
+	int32 PreviousLaneIndex,
+	float PreviousLaneLength,
+	int32 CurrentLaneIndex,
+	float CurrentLaneLength,
+	int32 NextLaneIndex,
+	float DistanceAlongCurrentLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficCompactLaneSegment& InOutLaneSegment,
+	FVector& OutPosition,
+	FQuat& OutOrientation);
+
+FORCEINLINE void InterpolatePositionAndOrientationAlongContinuousLanes(
+	const FZoneGraphStorage& ZoneGraphStorage, 
+	int32 PreviousLaneIndex,
+	float PreviousLaneLength,
+	int32 CurrentLaneIndex,
+	float CurrentLaneLength,
+	int32 NextLaneIndex,
+	float DistanceAlongCurrentLane,
+	ETrafficVehicleMovementInterpolationMethod InterpolationMethod,
+	FMassTrafficCompactLaneSegment& InOutLaneSegment,
+	FTransform& OutTransform)
+{
+	FVector OutPosition;
+	FQuat OutOrientation;
+	InterpolatePositionAndOrientationAlongContinuousLanes(ZoneGraphStorage,
+		PreviousLaneIndex, PreviousLaneLength, CurrentLaneIndex, CurrentLaneLength,
+		NextLaneIndex, DistanceAlongCurrentLane, InterpolationMethod,
+		InOutLaneSegment, OutPosition, OutOrientation);
+
+	OutTransform.SetLocation(OutPosition);
+	OutTransform.SetRotation(OutOrientation);
+}
 	
 }
 }
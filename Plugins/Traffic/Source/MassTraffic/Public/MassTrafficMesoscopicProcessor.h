@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MassTrafficProcessorBase.h"
+#include "MassTrafficFragments.h"
+#include "MassTrafficMesoscopicProcessor.generated.h"
+
+
+/**
+ * Simulates traffic on lanes far from all viewers as aggregate flow, rather than as individual vehicles, so the cost
+ * of far field traffic scales with the number of lanes rather than the number of vehicles.
+ *
+ * Each mesoscopic lane is a single cell of a cell transmission model, holding the vehicles aggregated on it in
+ * FZoneGraphTrafficLaneData::MesoscopicVehicles. Each step, vehicles are sent on to NextLanes at the lane's free flow
+ * speed (its SpeedLimit), limited by how much room the next lanes have below their MaxDensity.
+ *
+ * Off LOD vehicles are absorbed into their mesoscopic lane as they become the lane's tail vehicle. The absorbed
+ * entities are kept (tagged with FMassTrafficMesoscopicVehicleTag instead of FMassTrafficVehicleTag) and move from
+ * lane to lane with the flow, so they are only ever re-emitted as individual vehicles on the lane the flow has carried
+ * them to, once that is a non-mesoscopic lane or a mesoscopic lane comes back into range.
+ *
+ * Aggregated vehicles keep occupying the lane they are on, each taking MesoscopicVehicleSpacing of its
+ * SpaceAvailable and counting in its NumVehiclesOnLane, density buckets and density grid cell, so the overseer and
+ * spawning see mesoscopic lanes as occupied.
+ *
+ * Lanes are updated and stepped in time slices, resuming where the last frame left off, so each step covers the time
+ * since the lane's previous step. @see UMassTrafficSettings::NumMesoscopicLanePartitions
+ *
+ * @see UMassTrafficSettings::bMesoscopicTraffic
+ * (See all MESOSCOPIC.)
+ */
+UCLASS()
+class MASSTRAFFIC_API UMassTrafficMesoscopicProcessor : public UMassTrafficProcessorBase
+{
+	GENERATED_BODY()
+
+public:
+	UMassTrafficMesoscopicProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	/**
+	 * Absorbs up to MaxVehicles Off LOD vehicles from the tail of TrafficLaneData into the front of its
+	 * MesoscopicVehicles.
+	 * @return The number of vehicles absorbed. 
+	 */
+	int32 AbsorbVehicles(
+		FMassEntityManager& EntityManager,
+		FMassExecutionContext& Context,
+		FZoneGraphTrafficLaneData& TrafficLaneData,
+		const int32 MaxVehicles) const;
+
+	/**
+	 * Re-emits up to MaxVehicles of TrafficLaneData's MesoscopicVehicles, front first, as individual vehicles onto the
+	 * tail of the lane.
+	 * @return The number of vehicles emitted.
+	 */
+	int32 EmitVehicles(
+		FMassEntityManager& EntityManager,
+		FMassExecutionContext& Context,
+		FZoneGraphTrafficLaneData& TrafficLaneData,
+		const int32 MaxVehicles) const;
+
+	/**
+	 * Sends whole vehicles from the front of TrafficLaneData's MesoscopicVehicles on to its NextLanes'
+	 * MesoscopicInflow for one cell transmission model step of DeltaTime, and updates its MesoscopicSpeed &
+	 * MesoscopicFlow. 
+	 */
+	void SendMesoscopicFlow(FZoneGraphTrafficLaneData& TrafficLaneData, const float DeltaTime) const;
+
+	/** @return Number of vehicles TrafficLaneData can receive from previous lanes this mesoscopic step. */
+	float GetMesoscopicReceivingCapacity(const FZoneGraphTrafficLaneData& TrafficLaneData) const;
+
+	/** @return Number of vehicles TrafficLaneData holds at MaxDensity. */
+	float GetMesoscopicCapacity(const FZoneGraphTrafficLaneData& TrafficLaneData) const;
+
+	/**
+	 * @return True if individual vehicles can be absorbed from or emitted onto the tail of TrafficLaneData. Lanes
+	 *		   involved in lane changes, merges, splits or intersections are skipped to avoid ghost vehicle & intersection
+	 *		   bookkeeping.
+	 */
+	static bool CanTransitionVehiclesOnLane(const FZoneGraphTrafficLaneData& TrafficLaneData);
+
+	/** Lane update progress across all registered zone graphs. @see UMassTrafficProcessorBase::MakeTimeSlice */
+	FMassTrafficTimeSliceCursor LaneTimeSliceCursor;
+
+	/** Time since the current lane pass started, and the duration of the last completed pass. */
+	float LanePassTime = 0.0f;
+	float LastLanePassTime = 0.0f;
+
+	/** Mesoscopic lanes & vehicles counted over the current lane pass, and over the last completed one. For stats. */
+	int32 PassNumMesoscopicLanes = 0;
+	int32 PassNumMesoscopicVehicles = 0;
+	int32 LastPassNumMesoscopicLanes = 0;
+	int32 LastPassNumMesoscopicVehicles = 0;
+
+	// Scratch buffers
+	TArray<FZoneGraphTrafficLaneData*> EmissionLanes;
+};
@@ -257,4 +257,36 @@ MASSTRAFFIC_API bool TeleportVehicleToAnotherLane(
 	const UMassTrafficSettings& MassTrafficSettings,
 	const FMassEntityManager& EntityManager);
 
+/**
+ * Removes a lane's tail vehicle from the lane, leaving it on no lane with no next vehicle. Used to absorb vehicles into
+ * mesoscopic lane flow. (See all MESOSCOPIC.)
+ * @return false, leaving the vehicle on the lane, if it isn't the lane's tail vehicle or can't stop at the lane exit.
+ */
+MASSTRAFFIC_API bool RemoveTailVehicleFromLane(
+	const FMassEntityHandle VehicleEntity,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	FMassTrafficVehicleControlFragment& VehicleControlFragment,
+	const FAgentRadiusFragment& RadiusFragment,
+	const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+	FMassTrafficNextVehicleFragment& NextVehicleFragment,
+	const UMassTrafficSettings& MassTrafficSettings,
+	const FMassEntityManager& EntityManager);
+
+/**
+ * Inserts a vehicle that is on no lane (@see RemoveTailVehicleFromLane) onto a lane as its new tail vehicle, at
+ * DistanceAlongLane, which must be behind the lane's current tail vehicle. (See all MESOSCOPIC.)
+ */
+MASSTRAFFIC_API void InsertVehicleAsLaneTail(
+	const FMassEntityHandle VehicleEntity,
+	FZoneGraphTrafficLaneData& TrafficLaneData,
+	const float DistanceAlongLane,
+	FMassTrafficVehicleControlFragment& VehicleControlFragment,
+	const FAgentRadiusFragment& RadiusFragment,
+	const FMassTrafficRandomFractionFragment& RandomFractionFragment,
+	FMassZoneGraphLaneLocationFragment& LaneLocationFragment,
+	FMassTrafficNextVehicleFragment& NextVehicleFragment,
+	FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
+	const UMassTrafficSettings& MassTrafficSettings,
+	const FMassEntityManager& EntityManager);
+
 }
@@ -0,0 +1,189 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "MassTrafficOcclusion.generated.h"
+
+struct FZoneGraphStorage;
+struct FZoneGraphTagFilter;
+
+/**
+ * Zone graph lanes potentially visible from a single viewer cell, i.e: visible from any of the points sampled across it
+ * and its height band. (See all OCCLUSIONPVS.)
+ */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedOcclusionCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FIntPoint Cell = FIntPoint::ZeroValue;
+
+	/** Height visibility was tested from in this cell */
+	UPROPERTY()
+	float ViewerZ = 0.0f;
+
+	/** One bit per zone graph lane index, set if the lane is potentially visible from this cell */
+	UPROPERTY()
+	TArray<uint32> VisibleLaneBits;
+
+	FORCEINLINE bool IsLaneVisible(const int32 LaneIndex) const
+	{
+		const int32 WordIndex = LaneIndex >> 5;
+		return !VisibleLaneBits.IsValidIndex(WordIndex) || (VisibleLaneBits[WordIndex] & (1u << (LaneIndex & 31))) != 0;
+	}
+};
+
+/** Lane visibility baked for a single zone graph, from every viewer cell containing one of its traffic lanes */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedZoneGraphOcclusion
+{
+	GENERATED_BODY()
+
+	/** Hash of the zone graph storage and traffic lane filter this was baked with. @see UMassTrafficOcclusionDataAsset::GetOcclusionBakeHash */
+	UPROPERTY(VisibleAnywhere, Category="Occlusion")
+	uint32 BakeHash = 0;
+
+	UPROPERTY(VisibleAnywhere, Category="Occlusion")
+	float CellSize = 0.0f;
+
+	/** Viewers further than this above or below a cell's ViewerZ aren't considered within it. */
+	UPROPERTY(VisibleAnywhere, Category="Occlusion")
+	float ViewerHeightTolerance = 0.0f;
+
+	UPROPERTY()
+	TArray<FMassTrafficBakedOcclusionCell> Cells;
+
+	/** Cell -> Cells index, built on load */
+	TMap<FIntPoint, int32> CellLookup;
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	/**
+	 * Returns the baked cell containing ViewerLocation, or nullptr if there is none and all lanes should be considered
+	 * visible. Viewers outside the cell's baked height band, e.g: flying high above or below the road, aren't contained
+	 * by any cell as they can see over or under the geometry visibility was tested against.
+	 */
+	FORCEINLINE const FMassTrafficBakedOcclusionCell* FindCell(const FVector& ViewerLocation) const
+	{
+		const int32* CellIndex = CellLookup.Find(GetCell(ViewerLocation));
+		if (!CellIndex || FMath::Abs(ViewerLocation.Z - Cells[*CellIndex].ViewerZ) > ViewerHeightTolerance)
+		{
+			return nullptr;
+		}
+		return &Cells[*CellIndex];
+	}
+
+	void BuildCellLookup();
+};
+
+/**
+ * Potentially visible traffic lanes from each cell of a coarse 2D grid of viewer locations, precomputed from the
+ * current map's collision geometry. Traffic vehicles on lanes that aren't potentially visible from any viewer's cell
+ * are treated as outside the view frustum by UMassTrafficVehicleVisualizationLODProcessor, and so demoted to cheaper
+ * visualization LODs.
+ *
+ * As this only needs the baked data at runtime it works the same on headless builds, and can be queried offline with
+ * FindZoneGraphOcclusion and IsLaneVisible.
+ *
+ * @see UMassTrafficSettings::OcclusionData
+ * (See all OCCLUSIONPVS.)
+ */
+UCLASS(Blueprintable, BlueprintType)
+class MASSTRAFFIC_API UMassTrafficOcclusionDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Size of viewer cells. Lanes are baked as visible from a cell if they are visible from any of its viewer sample
+	 * points, or pass through it or a neighboring cell.
+	 */
+	UPROPERTY(EditAnywhere, Category="Occlusion", meta=(ClampMin="100.0", UIMin="100.0"))
+	float CellSize = 5000.0f;
+
+	/**
+	 * Number of viewer sample points along each side of a cell, including its corners. The grid is sampled at the
+	 * bottom, middle and top of the cell's height band. More samples make it less likely to bake a lane as occluded
+	 * when it's visible through a gap from part of the cell, but take longer to bake.
+	 */
+	UPROPERTY(EditAnywhere, Category="Occlusion", meta=(ClampMin="2", UIMin="2"))
+	int32 ViewerSamplesPerCellSide = 3;
+
+	/** Height of viewers above the average lane height in their cell */
+	UPROPERTY(EditAnywhere, Category="Occlusion")
+	float ViewerHeight = 200.0f;
+
+	/**
+	 * Viewers further than this above or below the baked viewer height in their cell use no occlusion, leaving all
+	 * lanes visible.
+	 */
+	UPROPERTY(EditAnywhere, Category="Occlusion", meta=(ClampMin="0.0", UIMin="0.0"))
+	float ViewerHeightTolerance = 500.0f;
+
+	/** Height above the lane to test visibility to, roughly the height of a vehicle's roof */
+	UPROPERTY(EditAnywhere, Category="Occlusion")
+	float VehicleHeight = 150.0f;
+
+	/**
+	 * Maximum distance between points along each lane to test visibility to, including its start and end. Long lanes
+	 * get more points, so a lane isn't baked as occluded just because its few sample points happen to be hidden.
+	 */
+	UPROPERTY(EditAnywhere, Category="Occlusion", meta=(ClampMin="100.0", UIMin="100.0"))
+	float LaneSampleSpacing = 1000.0f;
+
+	/** Lanes further than this from a cell are always considered visible, leaving them to distance based LOD */
+	UPROPERTY(EditAnywhere, Category="Occlusion")
+	float MaxOcclusionDistance = 30000.0f;
+
+	UPROPERTY(EditAnywhere, Category="Occlusion")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	UPROPERTY(VisibleAnywhere, Category="Occlusion")
+	TArray<FMassTrafficBakedZoneGraphOcclusion> ZoneGraphOcclusion;
+
+	/** Returns the baked occlusion for ZoneGraphStorage, or nullptr if there is none or it's out of date */
+	const FMassTrafficBakedZoneGraphOcclusion* FindZoneGraphOcclusion(const FZoneGraphStorage& ZoneGraphStorage) const;
+
+	/** Returns a hash of everything occlusion baked for ZoneGraphStorage depends on, besides the bake settings stored with it */
+	static uint32 GetOcclusionBakeHash(const FZoneGraphStorage& ZoneGraphStorage);
+
+	/** Returns true if the lane at LaneIndex is potentially visible from ViewerLocation */
+	static bool IsLaneVisible(const FMassTrafficBakedZoneGraphOcclusion& Occlusion, const FVector& ViewerLocation, const int32 LaneIndex)
+	{
+		const FMassTrafficBakedOcclusionCell* Cell = Occlusion.FindCell(ViewerLocation);
+		return !Cell || Cell->IsLaneVisible(LaneIndex);
+	}
+
+	// UObject overrides
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+
+	/** Bake potentially visible traffic lanes from viewer cells along all traffic lanes in the current map */
+	UFUNCTION(CallInEditor, Category="Occlusion")
+	void BakeOcclusionFromMap();
+
+	/**
+	 * Bake potentially visible lanes passing LaneFilter in ZoneGraphStorage, against World's collision, into
+	 * OutOcclusion. Doesn't set OutOcclusion's BakeHash.
+	 * 
+	 * @return false if the bake was canceled.
+	 */
+	bool BakeZoneGraphOcclusion(const UWorld& World, const FZoneGraphStorage& ZoneGraphStorage, const FZoneGraphTagFilter& LaneFilter, FMassTrafficBakedZoneGraphOcclusion& OutOcclusion) const;
+
+	UFUNCTION(CallInEditor, Category="Occlusion")
+	void ClearOcclusion()
+	{
+		ZoneGraphOcclusion.Reset();
+		Modify();
+	}
+
+#endif
+};
@@ -44,13 +44,31 @@ protected:
 	FMassEntityQuery RecyclableTrafficVehicleEntityQuery;
 
 	bool bTrunkLanesPhase = false;
-	int32 PartitionIndex = 0;
+
+	/** Lane scan progress across all registered zone graphs. @see UMassTrafficProcessorBase::MakeTimeSlice */
+	FMassTrafficTimeSliceCursor LaneTimeSliceCursor;
+
+	/** Zone graph to start density bucket scans from, rotated each frame so no zone graph's lanes are starved */
+	int32 DensityBucketScanFirstZoneGraph = 0;
+
+	struct FPassViewer
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+
+		/** Half angle of the cone enclosing the viewer's frustum, in radians */
+		float HalfViewAngle = 0.0f;
+	};
+
+	/**
+	 * Mass LOD viewers, captured at the start of each lane pass so every time slice of the pass measures lane
+	 * distances against the same viewers.
+	 */
+	TArray<FPassViewer> PassViewers;
 
 	// Scratch buffers
 	TArray<FMassEntityView> BusiestLaneVehiclesToTransfer;
 	TArray<struct FZoneGraphTrafficLaneData*> BusiestLanes;
-	TArray<float> BusiestLaneDensityExcesses;
 	TArray<struct FZoneGraphTrafficLaneData*> LeastBusiestLanes;
-	TArray<float> LeastBusiestLaneDensities;
 	TArray<FVector> LeastBusiestLaneLocations;
 };
@@ -12,6 +12,8 @@
 #endif // UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_6
 #include "MassTrafficParkedVehicleSpawnDataGenerator.generated.h"
 
+class UMassTrafficSpawnPointsDataAsset;
+
 UCLASS()
 class MASSTRAFFIC_API UMassTrafficParkedVehicleSpawnDataGenerator : public UMassEntitySpawnDataGeneratorBase
 {
@@ -40,6 +42,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	float ObstacleExclusionRadius = 500.0f;
 
+	/**
+	 * Optional precomputed parking spaces to spawn in, rather than gathering AMassTrafficParkingSpotActors at runtime.
+	 * Used if it has any baked parking spaces.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TObjectPtr<const UMassTrafficSpawnPointsDataAsset> BakedSpawnPoints = nullptr;
+
 	/** Generate "Count" number of SpawnPoints and return as a list of position
 	 * @param Count of point to generate
 	 * @param FinishedGeneratingSpawnPointsDelegate is the callback to call once the generation is done
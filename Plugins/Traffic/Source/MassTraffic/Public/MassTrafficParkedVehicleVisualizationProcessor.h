@@ -5,6 +5,8 @@
 #include "MassRepresentationProcessor.h"
 #include "MassVisualizationLODProcessor.h"
 #include "MassTrafficFragments.h"
+#include "MassTrafficInstanceGatherer.h"
+#include "MassTrafficVehicleVisualizationProcessor.h"
 #include "MassTrafficParkedVehicleVisualizationProcessor.generated.h"
 
 class UMassTrafficSubsystem;
@@ -45,4 +47,7 @@ private:
 	UWorld* World;
 
 	FMassEntityQuery EntityQuery;
+
+	/** (See all PARALLELISMGATHER.) */
+	TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData> InstanceGatherer;
 };
\ No newline at end of file
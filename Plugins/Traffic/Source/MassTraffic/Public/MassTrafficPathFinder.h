@@ -26,6 +26,9 @@ public:
 
 	static float CalculatePathLength(const FTrafficPath& TrafficPath);
 
+	// Heap memory used by the lane list and search state
+	SIZE_T GetAllocatedSize() const;
+
 private:
 	//--------------------------------------------------------------------------------------------------------------------------------------------------------
 	struct FLaneNode
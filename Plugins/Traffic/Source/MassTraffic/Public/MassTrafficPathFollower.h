@@ -47,6 +47,8 @@ public:
 	
 	bool GetRandomLocation(FVector& Position) const;
 
+	const FMassTrafficPathFinder& GetPathFinder() const { return PathFinder; }
+
 	DECLARE_DELEGATE_TwoParams(FLaneChanged, const FZoneGraphLaneHandle&, const FZoneGraphLaneHandle&);
 	FLaneChanged OnLaneChanged;
 	
@@ -7,6 +7,7 @@
 #endif // UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_6
 #include "MassTraffic.h"
 #include "ChaosWheeledVehicleMovementComponent.h"
+#include "ChaosVehicleWheel.h"
 #include "SimpleVehicle.h"
 #if UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_6
 #include "SuspensionUtility.h"
@@ -14,6 +15,7 @@
 #include "MassEntityTypes.h"
 #include "WheeledVehiclePawn.h"
 #include "Chaos/PBDJointConstraintTypes.h"
+#include "Engine/DataAsset.h"
 #include "MassTrafficPhysics.generated.h"
 
 
@@ -76,26 +78,17 @@ private:
 	// Default config's just to satisfy need to pass one to the sim structs below in our UStruct mandated 
 	// default constructor below
 	static Chaos::FSimpleEngineConfig DefaultEngineConfig; 
-	static Chaos::FSimpleDifferentialConfig DefaultDifferentialConfig; 
 	static Chaos::FSimpleTransmissionConfig DefaultTransmissionConfig; 
-	static Chaos::FSimpleSteeringConfig DefaultSteeringConfig; 
-	static Chaos::FSimpleAerodynamicsConfig DefaultAerodynamicsConfig;
 
 public:
 	
 	FMassTrafficSimpleVehiclePhysicsSim(
 		const FMassTrafficSimpleVehiclePhysicsConfig* SetupIn = nullptr,
 		const Chaos::FSimpleEngineConfig* EngineConfig = &DefaultEngineConfig, 
-		const Chaos::FSimpleDifferentialConfig* DifferentialConfig = &DefaultDifferentialConfig, 
-		const Chaos::FSimpleTransmissionConfig* TransmissionConfig = &DefaultTransmissionConfig, 
-		const Chaos::FSimpleSteeringConfig* SteeringConfig = &DefaultSteeringConfig, 
-		const Chaos::FSimpleAerodynamicsConfig* AerodynamicsConfig = &DefaultAerodynamicsConfig)
+		const Chaos::FSimpleTransmissionConfig* TransmissionConfig = &DefaultTransmissionConfig)
 	: SetupPtr(SetupIn)
 	, EngineSim(EngineConfig)
-	, DifferentialSim(DifferentialConfig)
 	, TransmissionSim(TransmissionConfig)
-	, SteeringSim(SteeringConfig)
-	, AerodynamicsSim(AerodynamicsConfig)
 	{}
 
 	FORCEINLINE FMassTrafficSimpleVehiclePhysicsConfig& AccessSetup()
@@ -110,17 +103,21 @@ public:
 		return (*SetupPtr);
 	}
 
+	/**
+	 * Immutable vehicle config, shared by all vehicles of the same type.
+	 * 
+	 * Note: Only sims carrying mutable per-vehicle state live in here. Differential, steering, aerodynamics and
+	 *		 axle behaviour is derived purely from config, so is read from (or temporarily constructed over) the
+	 *		 shared Setup() instead of being duplicated for every vehicle. The engine, transmission, wheel and
+	 *		 suspension sims below only hold their state (RPM, gear, wheel omega, suspension displacement etc.) and a
+	 *		 pointer to their config, which also lives in the shared Setup(). The per-vehicle saving is logged as each
+	 *		 vehicle type's template is created. @see UMassTrafficSubsystem::GetOrExtractVehiclePhysicsTemplate
+	 */
 	const FMassTrafficSimpleVehiclePhysicsConfig* SetupPtr;
 
 	Chaos::FSimpleEngineSim EngineSim;
-	Chaos::FSimpleDifferentialSim DifferentialSim;
 	Chaos::FSimpleTransmissionSim TransmissionSim;
-	Chaos::FSimpleSteeringSim SteeringSim;
-	Chaos::FSimpleAerodynamicsSim AerodynamicsSim;
 
-	static constexpr int32 MaxAxles = 2;
-	TArray<Chaos::FAxleSim, TFixedAllocator<MaxAxles>> AxleSims;
-	
 	static constexpr int32 InlineWheels = 4;
 	static constexpr int32 MaxWheels = 6;
 	TArray<Chaos::FSimpleWheelSim, TInlineAllocator<InlineWheels>> WheelSims;
@@ -167,6 +164,29 @@ struct MASSTRAFFIC_API FMassTrafficVehiclePhysicsFragment : public FMassFragment
 	GENERATED_BODY()
 
 	FMassTrafficSimpleVehiclePhysicsSim VehicleSim;
+
+	/**
+	 * Fixed timestep substepping state. SimulatedLocation, SimulatedRotation & SimulatedVelocity are the result of the
+	 * latest fixed step and the Previous* members the result of the one before it, with the previous location kept
+	 * relative to the latest as the two are at most a step apart. The transform & velocity presented in
+	 * FTransformFragment & FMassVelocityFragment are interpolated between the two.
+	 * @see UMassTrafficSettings::SimplePhysicsFixedTimestepHz
+	 */
+	FVector SimulatedLocation = FVector::ZeroVector;
+	FVector3f PreviousSimulatedLocationOffset = FVector3f::ZeroVector;
+	FQuat4f SimulatedRotation = FQuat4f::Identity;
+	FQuat4f PreviousSimulatedRotation = FQuat4f::Identity;
+	FVector3f SimulatedVelocity = FVector3f::ZeroVector;
+	FVector3f PreviousSimulatedVelocity = FVector3f::ZeroVector;
+
+	/**
+	 * This vehicle's frame time accumulated but not yet simulated. Kept per vehicle, as vehicles sleep and enter or
+	 * leave simple physics independently of each other.
+	 */
+	float SubstepTimeAccumulator = 0.0f;
+
+	/** True once the simulated state above has been initialized */
+	bool bHasSimulatedTransform = false;
 };
 
 template<>
@@ -180,6 +200,10 @@ struct TMassFragmentTraits<FMassTrafficVehiclePhysicsFragment> final
 
 /**
  * Physics config & pre-configured sim extracted from a AWheeledVehiclePawn
+ *
+ * Shared by all vehicles of the same type through FMassTrafficVehiclePhysicsSharedParameters. Each vehicle's 
+ * FMassTrafficVehiclePhysicsFragment is copied from SimpleVehiclePhysicsFragmentTemplate and refers back to
+ * SimpleVehiclePhysicsConfig for all immutable config. 
  * @see UMassTrafficSubsystem::GetOrExtractVehiclePhysicsTemplate
  */
 USTRUCT()
@@ -206,6 +230,92 @@ struct MASSTRAFFIC_API FMassTrafficSimpleVehiclePhysicsTemplate
 	FMassTrafficVehiclePhysicsFragment SimpleVehiclePhysicsFragmentTemplate;
 };
 
+/**
+ * Physics config extracted ahead of time from a AWheeledVehiclePawn, to avoid having to spawn a temporary copy of
+ * the vehicle at runtime to extract it from.
+ * @see UMassTrafficSubsystem::GetOrExtractVehiclePhysicsTemplate
+ */
+UCLASS(BlueprintType)
+class MASSTRAFFIC_API UMassTrafficVehiclePhysicsDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** The AWheeledVehiclePawn to extract the physics config from */
+	UPROPERTY(EditAnywhere, Category="Physics")
+	TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor;
+
+	/**
+	 * Returns true if this asset holds a valid physics config extracted from PhysicsVehicleTemplateActor.
+	 * @see ExtractPhysicsVehicleConfig
+	 */
+	bool HasExtractedPhysicsVehicleConfig(TSubclassOf<AWheeledVehiclePawn> InPhysicsVehicleTemplateActor) const;
+
+	/** Initializes OutTemplate from the extracted physics config, as if it had been extracted from a spawned actor */
+	void InitPhysicsVehicleTemplate(FMassTrafficSimpleVehiclePhysicsTemplate& OutTemplate) const;
+
+#if WITH_EDITOR
+	/** Spawns a temporary copy of PhysicsVehicleTemplateActor in the editor world and extracts its physics config */
+	UFUNCTION(CallInEditor, Category="Physics")
+	void ExtractPhysicsVehicleConfig();
+#endif
+
+	// UObject overrides
+	virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	/** Re-extracts when cooking, so cooked data always matches the cooked PhysicsVehicleTemplateActor */
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+
+	/**
+	 * Compares the template this asset builds against one extracted from a spawned PhysicsVehicleTemplateActor, so
+	 * a stale asset (e.g: after the vehicle Blueprint changed) fails validation.
+	 */
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
+protected:
+
+	/** The AWheeledVehiclePawn SimpleVehiclePhysicsConfig was extracted from */
+	UPROPERTY(VisibleAnywhere, Category="Physics")
+	TSubclassOf<AWheeledVehiclePawn> ExtractedPhysicsVehicleTemplateActor;
+
+	UPROPERTY(VisibleAnywhere, Category="Physics")
+	FMassTrafficSimpleVehiclePhysicsConfig SimpleVehiclePhysicsConfig;
+
+	/** Suspension resting positions, in actor space, to initialize FMassTrafficSimpleVehiclePhysicsSim::SuspensionSims with */
+	UPROPERTY()
+	TArray<FVector> WheelRestingPositions;
+
+	/**
+	 * PhysicsVehicleTemplateActor's engine & steering setups and wheel classes. The Chaos torque, steering and lateral
+	 * slip graphs don't expose their points, so rather than re-sampling them we keep what they were built from and
+	 * build them again the same way. @see BuildChaosGraphs
+	 */
+	UPROPERTY()
+	FVehicleEngineConfig EngineSetup;
+
+	UPROPERTY()
+	FVehicleSteeringConfig SteeringSetup;
+
+	UPROPERTY()
+	TArray<TSubclassOf<UChaosVehicleWheel>> WheelClasses;
+
+	/**
+	 * False if the non-reflected Chaos configs in SimpleVehiclePhysicsConfig couldn't be loaded (e.g: because their
+	 * layout changed with an engine upgrade). In which case the config must be extracted again.
+	 */
+	bool bChaosConfigsValid = false;
+
+	/** Builds the Chaos graphs in InOutVehicleConfig from EngineSetup, SteeringSetup & WheelClasses */
+	void BuildChaosGraphs(FMassTrafficSimpleVehiclePhysicsConfig& InOutVehicleConfig) const;
+
+#if WITH_EDITOR
+	/** ExtractPhysicsVehicleConfig, without marking the asset modified. @return false if nothing was extracted */
+	bool ExtractPhysicsVehicleConfigInternal();
+#endif
+};
+
 /** Simplified version of FJointSolverGaussSeidel */  
 USTRUCT()
 struct MASSTRAFFIC_API FMassTrafficSimpleTrailerConstraintSolver
@@ -365,4 +475,50 @@ MASSTRAFFIC_API void ExtractPhysicsVehicleConfig(
 	FMassTrafficSimpleVehiclePhysicsConfig& OutVehicleConfig,
 	FMassTrafficSimpleVehiclePhysicsSim& OutVehicleSim
 );
+
+/**
+ * Spawns a temporary copy of PhysicsVehicleTemplateActor in World to extract its physics config from.
+ * @return false if PhysicsVehicleTemplateActor couldn't be spawned
+ * @see ExtractPhysicsVehicleConfig
+ */
+MASSTRAFFIC_API bool SpawnAndExtractPhysicsVehicleConfig(
+	UWorld& World,
+	TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor,
+	FMassTrafficSimpleVehiclePhysicsConfig& OutVehicleConfig,
+	FMassTrafficSimpleVehiclePhysicsSim& OutVehicleSim
+);
+
+/**
+ * Initializes a freshly constructed OutVehicleSim using VehicleConfig, placing the suspension at WheelRestingPositions.
+ * Used to re-create the sim for configs that were serialized, instead of extracted from a spawned actor.
+ */
+MASSTRAFFIC_API void InitPhysicsVehicleSim(
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfig,
+	TConstArrayView<FVector> WheelRestingPositions,
+	FMassTrafficSimpleVehiclePhysicsSim& OutVehicleSim
+);
+
+/**
+ * Compares two physics configs and the sims made from them, e.g: one re-created from a
+ * UMassTrafficVehiclePhysicsDataAsset and one extracted from a spawned actor.
+ * @param OutConfigDifferences Receives the names of config values which differ
+ * @param OutSimDifferences Receives the names of initial sim state which differs. The sims extracted from a spawned
+ *							actor keep the state they reached while it ticked, which re-created sims start without.
+ * @return true if nothing differs
+ */
+MASSTRAFFIC_API bool DiffPhysicsVehicleConfigs(
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfigA,
+	const FMassTrafficSimpleVehiclePhysicsSim& VehicleSimA,
+	const FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfigB,
+	const FMassTrafficSimpleVehiclePhysicsSim& VehicleSimB,
+	TArray<FString>& OutConfigDifferences,
+	TArray<FString>& OutSimDifferences
+);
+
+/**
+ * Serializes the Chaos configs in VehicleConfig which aren't reflected and so are skipped by tagged property
+ * serialization. The Chaos graphs aren't serialized, as they don't expose their points.
+ * @return false if the configs couldn't be loaded, in which case VehicleConfig must not be used
+ */
+MASSTRAFFIC_API bool SerializeChaosVehicleConfigs(FArchive& Ar, FMassTrafficSimpleVehiclePhysicsConfig& VehicleConfig);
 }
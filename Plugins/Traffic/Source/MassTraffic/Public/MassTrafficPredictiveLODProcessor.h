@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "MassProcessor.h"
+#include "MassLODSubsystem.h"
+#include "MassTrafficFragments.h"
+#include "MassTrafficPredictiveLODProcessor.generated.h"
+
+/*
+ * Pulls the closest viewer and frustum distances of traffic vehicles in towards where moving viewers will be
+ * LookAheadTime from now, so vehicles ahead of fast viewers are promoted to higher simulation and visualization LODs over several frames
+ * before they're needed, rather than all at once as the viewer arrives.
+ *
+ * Runs after the LOD collector has calculated viewer distances and before the LOD processors consume them. The
+ * collector's own distances are kept in FMassTrafficPredictiveLODFragment, so each frame's look ahead replaces the last
+ * rather than accumulating on chunks the collector didn't refresh.
+ * (See all PREDICTIVELOD.)
+ */
+UCLASS()
+class MASSTRAFFIC_API UMassTrafficPredictiveLODProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMassTrafficPredictiveLODProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	/** Seconds ahead of each moving viewer to also measure LOD distances from. 0 disables look ahead. */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
+	float LookAheadTime = 1.5f;
+
+	/** Maximum distance ahead of a viewer to look */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
+	float MaxLookAheadDistance = 20000.0f;
+
+	/** Viewers moving slower than this (cm/s) don't look ahead */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
+	float MinLookAheadViewerSpeed = 1000.0f;
+
+	/** Viewers appearing to move faster than this (cm/s) are assumed to have teleported, and don't look ahead */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
+	float MaxLookAheadViewerSpeed = 20000.0f;
+
+	struct FViewerLookAhead
+	{
+		FMassViewerHandle Handle;
+		FVector PreviousLocation = FVector::ZeroVector;
+		FVector LookAheadLocation = FVector::ZeroVector;
+		bool bIsLookingAhead = false;
+	};
+
+	/** Look ahead state of each viewer, indexed as UMassLODSubsystem::GetViewers */
+	TArray<FViewerLookAhead> ViewerLookAheads;
+
+	/** Whether any viewer looked ahead last frame, so vehicles' distances need restoring even if none do this frame */
+	bool bHadLookAheads = false;
+
+	FMassEntityQuery EntityQuery;
+};
@@ -6,6 +6,115 @@
 #include "MassProcessor.h"
 #include "MassTrafficProcessorBase.generated.h"
 
+/**
+ * Resumable position in a pass over a processor's work items (e.g: lanes or entity chunks) which is spread across
+ * several frames by FMassTrafficTimeSlice.
+ */
+struct FMassTrafficTimeSliceCursor
+{
+	/** Index of the first item not yet processed in the current pass */
+	int32 NextItemIndex = 0;
+
+	/** Number of passes over all items completed so far */
+	int32 NumCompletedPasses = 0;
+
+	/**
+	 * Smoothed cost of an item, in microseconds, for slices which must choose how many items to take before doing
+	 * any work. 0 until measured. @see UMassTrafficProcessorBase::ForTimeSlicedEntityBuckets
+	 */
+	float MicrosecondsPerItem = 0.0f;
+};
+
+/**
+ * Half open range of entity buckets, [FirstBucket, EndBucket), handled by a single pass over entities. Entities are
+ * bucketed by entity index, which unlike chunk ordinals is unaffected by chunk filtering or entities moving between
+ * archetypes.
+ * @see UMassTrafficProcessorBase::ForTimeSlicedEntityBuckets
+ */
+struct FMassTrafficEntityBucketRange
+{
+	/** Number of entity buckets time sliced entity passes are spread over */
+	static constexpr int32 NumBuckets = 16;
+
+	int32 FirstBucket = 0;
+	int32 EndBucket = NumBuckets;
+
+	FORCEINLINE bool Contains(const FMassEntityHandle Entity) const
+	{
+		const int32 EntityBucket = static_cast<int32>(Entity.Index % NumBuckets);
+		return EntityBucket >= FirstBucket && EntityBucket < EndBucket;
+	}
+};
+
+/**
+ * A single frame's slice of work over a FMassTrafficTimeSliceCursor.
+ *
+ * Items must be offered in index order via ShouldProcessItem, which accepts items from the cursor onward until
+ * either the microsecond budget or the max item count for this slice is spent. Finish (or destruction) advances the
+ * cursor past the processed items, or starts a new pass if every remaining item was processed.
+ *
+ * e.g:
+ *		FMassTrafficTimeSlice TimeSlice = MakeTimeSlice(LaneCursor, NumLanes);
+ *		for (int32 LaneIndex = TimeSlice.GetResumeItemIndex(); LaneIndex < NumLanes && TimeSlice.ShouldProcessItem(LaneIndex); ++LaneIndex)
+ *		{
+ *			...
+ *		}
+ *		const bool bCompletedPass = TimeSlice.Finish();
+ *
+ * @see UMassTrafficProcessorBase::MakeTimeSlice
+ */
+struct MASSTRAFFIC_API FMassTrafficTimeSlice
+{
+	/**
+	 * @param InBudgetMicroseconds	Time budget for this slice. <= 0 for no time limit.
+	 * @param InMaxItems			Max number of items to process in this slice.
+	 * @param InNumItems			Total number of items in a pass, if known up front. Otherwise the highest item index
+	 *								offered to ShouldProcessItem is used. Only used for the backlog stat.
+	 */
+	FMassTrafficTimeSlice(FMassTrafficTimeSliceCursor& InCursor, const float InBudgetMicroseconds, const int32 InMaxItems = TNumericLimits<int32>::Max(), const int32 InNumItems = INDEX_NONE);
+	~FMassTrafficTimeSlice();
+
+	FMassTrafficTimeSlice(const FMassTrafficTimeSlice&) = delete;
+	FMassTrafficTimeSlice& operator=(const FMassTrafficTimeSlice&) = delete;
+
+	/** Index of the first item this slice will process, to let callers with random access skip straight to it */
+	int32 GetResumeItemIndex() const
+	{
+		return Cursor.NextItemIndex;
+	}
+
+	/**
+	 * @return true if ItemIndex should be processed in this slice. false if it was already processed earlier in this
+	 *		   pass or the budget is spent, in which case all later items will also be rejected.
+	 */
+	bool ShouldProcessItem(const int32 ItemIndex);
+
+	/** true once the budget is spent and remaining items are deferred to a later frame */
+	bool IsBudgetSpent() const
+	{
+		return bBudgetSpent;
+	}
+
+	/**
+	 * Commits progress to the cursor. Called automatically on destruction if not called explicitly. 
+	 * @return true if this slice completed the current pass over all items, in which case the cursor restarts from
+	 *		   the first item next time.
+	 */
+	bool Finish();
+
+private:
+	FMassTrafficTimeSliceCursor& Cursor;
+	uint64 EndCycles = 0;
+	int32 MaxItems = 0;
+	int32 NumItems = INDEX_NONE;
+	int32 NumItemsOffered = 0;
+	int32 NumItemsProcessed = 0;
+	int32 LastProcessedItemIndex = INDEX_NONE;
+	bool bBudgetSpent = false;
+	bool bFinished = false;
+	bool bCompletedPass = false;
+};
+
 /**
  * Base class for traffic processors that caches a pointer to the traffic subsytem
  */
@@ -18,10 +127,64 @@ protected:
 
 	virtual void InitializeInternal(UObject& InOwner, const TSharedRef<FMassEntityManager>& EntityManager) override;
 
+	/**
+	 * Starts this frame's slice of a pass over Cursor's work items, limited to TimeSliceBudgetMicroseconds.
+	 * @see FMassTrafficTimeSlice
+	 */
+	FMassTrafficTimeSlice MakeTimeSlice(FMassTrafficTimeSliceCursor& Cursor, const int32 NumItems = INDEX_NONE, const int32 MaxItems = TNumericLimits<int32>::Max()) const;
+
+	/**
+	 * Calls Function(const FMassTrafficEntityBucketRange&) once with this frame's time slice of Cursor's entity
+	 * buckets, so the caller makes a single pass over its entities, skipping those not in the range.
+	 *
+	 * As the work for a bucket can't be split from the rest of the pass, the number of buckets is chosen up front from
+	 * the budget and the cost per bucket measured in previous slices. Without a budget all remaining buckets are taken
+	 * at once.
+	 */
+	template<typename TFunction>
+	void ForTimeSlicedEntityBuckets(FMassTrafficTimeSliceCursor& Cursor, TFunction&& Function) const
+	{
+		FMassTrafficTimeSlice TimeSlice(Cursor, 0.0f, GetMaxTimeSlicedEntityBuckets(Cursor), FMassTrafficEntityBucketRange::NumBuckets);
+
+		FMassTrafficEntityBucketRange EntityBuckets;
+		EntityBuckets.FirstBucket = TimeSlice.GetResumeItemIndex();
+		EntityBuckets.EndBucket = EntityBuckets.FirstBucket;
+		while (EntityBuckets.EndBucket < FMassTrafficEntityBucketRange::NumBuckets && TimeSlice.ShouldProcessItem(EntityBuckets.EndBucket))
+		{
+			++EntityBuckets.EndBucket;
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Function(EntityBuckets);
+		UpdateTimeSliceItemCost(Cursor, StartCycles, EntityBuckets.EndBucket - EntityBuckets.FirstBucket);
+	}
+
+	/** Max number of entity buckets this frame's slice may take to stay within budget. @see ForTimeSlicedEntityBuckets */
+	int32 GetMaxTimeSlicedEntityBuckets(const FMassTrafficTimeSliceCursor& Cursor) const;
+
+	/** Folds the cost of NumItems items processed since StartCycles into Cursor.MicrosecondsPerItem */
+	static void UpdateTimeSliceItemCost(FMassTrafficTimeSliceCursor& Cursor, const uint64 StartCycles, const int32 NumItems);
+
+	/** Time budget for a time slice, honoring MassTraffic.TimeSlicing */
+	float GetTimeSliceBudgetMicroseconds() const;
+
+	/**
+	 * Time budget per frame, in microseconds, for processors that spread expensive passes across frames with
+	 * MakeTimeSlice. <= 0 processes all remaining items each frame. (See MassTraffic.TimeSlicing.)
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Time Slicing", config)
+	float TimeSliceBudgetMicroseconds = 0.0f;
+
 	TWeakObjectPtr<const UMassTrafficSettings> MassTrafficSettings;
 
 	FRandomStream RandomStream;
 
+	/**
+	 * Cached UMassTrafficSettings::bArchetypeStableSimulationLOD. When set, vehicles with medium LOD simulation
+	 * fragments must also pass FMassTrafficSimulationLODFragment::IsMediumLODSimulationActive to be simulated with them.
+	 */
+	bool bArchetypeStableSimulationLOD = false;
+
 	UPROPERTY(transient)
 	UObject* LogOwner;
 };
@@ -12,6 +12,8 @@
 DECLARE_MULTICAST_DELEGATE(FOnMassTrafficLanesettingsChanged);
 #endif
 
+class UMassTrafficOcclusionDataAsset;
+
 USTRUCT()
 struct MASSTRAFFIC_API FMassTrafficLaneSpeedLimit
 {
@@ -288,7 +290,47 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, Config, Category="Simple Physics")
 	FVector2D VerticalDeviationClampingRange = FVector2D(50.0f, 100.0f);
-	
+
+	/**
+	 * When > 0, simple vehicle physics is advanced in fixed steps of 1 / SimplePhysicsFixedTimestepHz seconds,
+	 * accumulating the variable frame delta time. The transform presented to the rest of the simulation is then
+	 * interpolated between the last two fixed step states.
+	 *
+	 * When 0, simple vehicle physics is integrated once per frame with the frame delta time, clamped to
+	 * UPhysicsSettings::MaxPhysicsDeltaTime.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category="Simple Physics", meta=(ClampMin="0.0", UIMin="0.0"))
+	float SimplePhysicsFixedTimestepHz = 0.0f;
+
+	/**
+	 * The maximum number of fixed steps simple vehicle physics will take in a single frame. Any further accumulated
+	 * time is discarded, so long hitches slow the simulation down rather than making it take one large, unstable step.
+	 * @see SimplePhysicsFixedTimestepHz
+	 */
+	UPROPERTY(EditAnywhere, Config, Category="Simple Physics", meta=(ClampMin="1", UIMin="1", EditCondition="SimplePhysicsFixedTimestepHz > 0"))
+	int32 SimplePhysicsMaxSubsteps = 4;
+
+	/**
+	 * Number of suspension & trailer constraint solver iterations per simple vehicle physics step. When 0, Chaos'
+	 * UPhysicsSettingsCore::SolverOptions.PositionIterations is used.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category="Simple Physics", meta=(ClampMin="0", UIMin="0"))
+	int32 SimplePhysicsPositionIterations = 0;
+
+	/**
+	 * When false, simple physics & PID control fragments are added to vehicles as they enter Medium simulation LOD and
+	 * removed as they leave it, moving the vehicle to a different archetype each time.
+	 *
+	 * When true, these fragments are added the first time a vehicle enters Medium LOD and then kept, with processors
+	 * selecting vehicles to simulate with them by simulation LOD rather than fragment presence. Vehicles then stay in
+	 * the same archetype as they cross the Medium LOD boundary, at the cost of keeping the (inactive) fragment memory
+	 * for vehicles that have dropped to Low LOD.
+	 *
+	 * Requires a restart to take effect, as it changes processor queries.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category="Simple Physics", meta=(ConfigRestartRequired=true))
+	bool bArchetypeStableSimulationLOD = false;
+
 	/**
 	 * The distance a physics vehicle is allowed to deviate from its natural lane location (e.g: due to being
 	 * pushed off in an accident) before it becomes 'deviant' and is considered an obstacle to avoid by other
@@ -453,6 +495,7 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	int32 NumBusiestLanesToTransferFrom = 50;
 	
+	/** Lanes are only transferred from if their distance to the nearest Mass LOD viewer is in this range */
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	FFloatRange BusiestLaneDistanceToPlayerRange = FFloatRange::GreaterThan(50000.0f);
 
@@ -462,9 +505,23 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	float LeastBusiestLaneMaxDensity = 0.5f;
 	
+	/** Lanes are only transferred to if their distance to the nearest Mass LOD viewer is in this range */
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	FFloatRange LeastBusiestLaneDistanceToPlayerRange = FFloatRange::GreaterThan(50000.0f);
 
+	/**
+	 * When true, lanes overlapping any Mass LOD viewer's view frustum are never transferred from or to, regardless of
+	 * their distance to the viewer.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
+	bool bExcludeLanesInViewerFrustums = false;
+
+	/**
+	 * Minimum number of frames a full density management pass, refreshing all lanes' distances to the nearest viewer,
+	 * is spread across. Each frame refreshes at most 1 / NumDensityManagementLanePartitions of the lanes, and fewer if
+	 * the overseer's time slice budget runs out first. This is also the most lanes considered each frame when picking
+	 * the busiest and least busiest lanes from their density buckets.
+	 */
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	int32 NumDensityManagementLanePartitions = 10;
 
@@ -475,6 +532,69 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Density Management")
 	float MinTransferDistance = 50000.0f;
 
+	/**
+	 * Size of the cells of the coarse 2D traffic density grid queried by UMassTrafficSubsystem::GetTrafficDensityAt.
+	 * (See all DENSITYGRID.)
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Density Grid", meta=(ClampMin="100.0", UIMin="100.0", ConfigRestartRequired=true))
+	float DensityGridCellSize = 10000.0f;
+
+	/** Vehicles slower than this (cm/s) are counted as stopped in the traffic density grid. (See all DENSITYGRID.) */
+	UPROPERTY(EditAnywhere, Config, Category = "Density Grid", meta=(ClampMin="0.0", UIMin="0.0"))
+	float DensityGridStoppedSpeed = 100.0f;
+
+	/** Roughly how many seconds the traffic density grid's average speeds are smoothed over. (See all DENSITYGRID.) */
+	UPROPERTY(EditAnywhere, Config, Category = "Density Grid", meta=(ClampMin="0.0", UIMin="0.0"))
+	float DensityGridSmoothingTime = 2.0f;
+
+	/**
+	 * Baked lane occlusion used to demote vehicles hidden behind level geometry to cheaper visualization LODs. The
+	 * first asset with occlusion baked for a zone graph's current data is used for that zone graph.
+	 * (See all OCCLUSIONPVS.)
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Occlusion", meta=(ConfigRestartRequired=true))
+	TArray<TSoftObjectPtr<UMassTrafficOcclusionDataAsset>> OcclusionData;
+
+	/**
+	 * When true, lanes further than MesoscopicLaneDistance from all viewers are simulated as aggregate flow cells.
+	 * Off LOD vehicles on these lanes are absorbed into their lane's aggregate vehicles, which then flow from lane to
+	 * lane at a rate derived from the lane's SpeedLimit and density. Vehicles are re-emitted as individual vehicles on
+	 * the lane they have flowed to, when it is a non-mesoscopic lane or a mesoscopic lane comes back into range.
+	 * (See all MESOSCOPIC.)
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic")
+	bool bMesoscopicTraffic = false;
+
+	/**
+	 * Lanes further than this from all viewers become mesoscopic. Should be well beyond the Off simulation LOD
+	 * distance, so only Off LOD vehicles are ever absorbed or emitted.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic", meta=(EditCondition="bMesoscopicTraffic", ClampMin="0.0", UIMin="0.0"))
+	float MesoscopicLaneDistance = 60000.0f;
+
+	/** Mesoscopic lanes only return to individual vehicle simulation once closer than MesoscopicLaneDistance minus this. */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic", meta=(EditCondition="bMesoscopicTraffic", ClampMin="0.0", UIMin="0.0"))
+	float MesoscopicLaneDistanceHysteresis = 5000.0f;
+
+	/**
+	 * Average front-to-front spacing of vehicles in a jam. Sets mesoscopic lane capacity (Length / spacing, scaled by
+	 * the lane's MaxDensity) and the spacing vehicles are re-emitted at.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic", meta=(EditCondition="bMesoscopicTraffic", ClampMin="100.0", UIMin="100.0"))
+	float MesoscopicVehicleSpacing = 800.0f;
+
+	/** Maximum number of individual vehicles absorbed into or emitted from mesoscopic lanes per frame. */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic", meta=(EditCondition="bMesoscopicTraffic", ClampMin="0", UIMin="0"))
+	int32 MaxMesoscopicTransitionsPerFrame = 50;
+
+	/**
+	 * Minimum number of frames a full mesoscopic pass, updating which lanes are mesoscopic and stepping their flow, is
+	 * spread across. Each frame updates at most 1 / NumMesoscopicLanePartitions of the lanes, and fewer if the
+	 * mesoscopic processor's time slice budget runs out first.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Mesoscopic", meta=(EditCondition="bMesoscopicTraffic", ClampMin="1", UIMin="1"))
+	int32 NumMesoscopicLanePartitions = 4;
+
 	/**
 	 * How much to mix functional flow density v.s. downstream flow density when managing flow density (0..1).
 	 * Should probably be around 0.5.
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "MassTrafficVehicleSpawnDataGenerator.h"
+#include "ZoneGraphTypes.h"
+#include "MassTrafficSpawnPoints.generated.h"
+
+class UWorld;
+struct FZoneGraphStorage;
+
+/** Parking spaces of a single type, baked from AMassTrafficParkingSpotActors */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedParkingSpaces
+{
+	GENERATED_BODY()
+
+	/** Parking space type, as set on the AMassTrafficParkingSpotActor. May be None for the generator's default type. */
+	UPROPERTY(VisibleAnywhere, Category="Parking")
+	FName ParkingSpaceType;
+
+	UPROPERTY()
+	TArray<FTransform> Transforms;
+};
+
+/** A candidate vehicle spawn point for one of UMassTrafficSpawnPointsDataAsset::VehicleTypeSpacings */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedLaneSpawnPoint
+{
+	GENERATED_BODY()
+
+	/** Lane location at the center of the space. LaneHandle.DataHandle is only valid at bake time. */
+	UPROPERTY()
+	FZoneGraphLaneLocation LaneLocation;
+
+	/** Index into UMassTrafficSpawnPointsDataAsset::VehicleTypeSpacings */
+	UPROPERTY()
+	uint8 SpacingIndex = 0;
+};
+
+/** All candidate spawn points along a single lane, for all spacings, sorted by distance along the lane */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedLaneSpawnPoints
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 LaneIndex = INDEX_NONE;
+
+	UPROPERTY()
+	TArray<FMassTrafficBakedLaneSpawnPoint> SpawnPoints;
+};
+
+/** Candidate vehicle spawn points baked for a single zone graph */
+USTRUCT()
+struct MASSTRAFFIC_API FMassTrafficBakedZoneGraphSpawnPoints
+{
+	GENERATED_BODY()
+
+	/** Hash of the zone graph storage and settings these points were baked with. @see UMassTrafficSpawnPointsDataAsset::GetVehicleSpawnPointsBakeHash */
+	UPROPERTY(VisibleAnywhere, Category="Vehicles")
+	uint32 BakeHash = 0;
+
+	UPROPERTY()
+	TArray<FMassTrafficBakedLaneSpawnPoints> Lanes;
+};
+
+/**
+ * Parking spaces and candidate traffic vehicle spawn points precomputed from the current map, so the parked and
+ * traffic vehicle spawn data generators only have to sample from them at runtime, rather than gathering parking spot
+ * actors or walking every lane. This keeps spawn generation cheap on dedicated server boot and World Partition cell
+ * loads.
+ *
+ * Vehicle spawn points are baked independently for each of VehicleTypeSpacings, as if it were the only spacing. At
+ * runtime, UMassTrafficVehicleSpawnDataGenerator then interleaves the spacings along each lane by the spawned entity
+ * type proportions.
+ *
+ * @see UMassTrafficVehicleSpawnDataGenerator::BakedSpawnPoints
+ * @see UMassTrafficParkedVehicleSpawnDataGenerator::BakedSpawnPoints
+ */
+UCLASS(Blueprintable, BlueprintType)
+class MASSTRAFFIC_API UMassTrafficSpawnPointsDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Vehicle spacings to bake spawn points for. These must match the VehicleTypeSpacings of the
+	 * UMassTrafficVehicleSpawnDataGenerator using this asset by Name and Space, with a None named entry matching its
+	 * DefaultSpace.
+	 */
+	UPROPERTY(EditAnywhere, Category="Vehicles", meta=(TitleProperty="Name"))
+	TArray<FMassTrafficVehicleSpacing> VehicleTypeSpacings;
+
+	UPROPERTY(EditAnywhere, Category="Vehicles")
+	float MinGapBetweenSpaces = 100.0f;
+
+	UPROPERTY(EditAnywhere, Category="Vehicles")
+	float MaxGapBetweenSpaces = 300.0f;
+
+	UPROPERTY(EditAnywhere, Category="Vehicles")
+	int32 RandomSeed = 0;
+
+	UPROPERTY(VisibleAnywhere, Category="Vehicles")
+	TArray<FMassTrafficBakedZoneGraphSpawnPoints> ZoneGraphSpawnPoints;
+
+	UPROPERTY(VisibleAnywhere, Category="Parking")
+	TArray<FMassTrafficBakedParkingSpaces> ParkingSpaces;
+
+	/** Package name of the map ParkingSpaces were baked from */
+	UPROPERTY(VisibleAnywhere, Category="Parking")
+	FName ParkingSpacesWorldPackageName;
+
+	/** Returns the baked spawn points for ZoneGraphStorage, or nullptr if there are none or they are out of date */
+	const FMassTrafficBakedZoneGraphSpawnPoints* FindZoneGraphSpawnPoints(const FZoneGraphStorage& ZoneGraphStorage) const;
+
+	/**
+	 * Returns the baked parking spaces for World, or nullptr if there are none or they were baked from a different map.
+	 * In editor, non partitioned maps are also checked against their current AMassTrafficParkingSpotActors.
+	 */
+	const TArray<FMassTrafficBakedParkingSpaces>* FindParkingSpaces(const UWorld& World) const;
+
+	/** Returns a hash of everything vehicle spawn points baked for ZoneGraphStorage depend on */
+	uint32 GetVehicleSpawnPointsBakeHash(const FZoneGraphStorage& ZoneGraphStorage) const;
+
+	/** Gathers the parking spaces of all AMassTrafficParkingSpotActors in World */
+	static void GatherParkingSpaces(const UWorld& World, TArray<FMassTrafficBakedParkingSpaces>& OutParkingSpaces);
+
+#if WITH_EDITOR
+
+	/** Bake vehicle spawn points for VehicleTypeSpacings along all traffic lanes in the current map */
+	UFUNCTION(CallInEditor, Category="Vehicles")
+	void PopulateVehicleSpawnPointsFromMap();
+
+	/** Bake parking spaces from all AMassTrafficParkingSpotActors in the current map */
+	UFUNCTION(CallInEditor, Category="Parking")
+	void PopulateParkingSpacesFromMap();
+
+	UFUNCTION(CallInEditor, Category="Vehicles")
+	void ClearVehicleSpawnPoints()
+	{
+		ZoneGraphSpawnPoints.Reset();
+		Modify();
+	}
+
+	UFUNCTION(CallInEditor, Category="Parking")
+	void ClearParkingSpaces()
+	{
+		ParkingSpaces.Reset();
+		ParkingSpacesWorldPackageName = NAME_None;
+		Modify();
+	}
+
+#endif
+};
@@ -10,10 +10,15 @@
 #include "MassEntityQuery.h"
 #include "MassExternalSubsystemTraits.h"
 #include "MassSubsystemBase.h"
+#include "UObject/ObjectKey.h"
 #include "MassTrafficSubsystem.generated.h"
 
 class UMassTrafficFieldComponent;
 class UMassTrafficFieldOperationBase;
+class UMassEntityConfigAsset;
+class UMassProcessor;
+class UMassSpawnerSubsystem;
+class UMassTrafficOcclusionDataAsset;
 struct FMassEntityManager;
 
 USTRUCT(Blueprintable)
@@ -29,6 +34,48 @@ struct FZoneGraphLaneLocationEx : public FZoneGraphLaneLocation
 	
 };
 
+/** A traffic vehicle yet to be spawned by a streaming spawn. (See all STREAMINGSPAWN.) */
+struct FMassTrafficStreamingSpawnPoint
+{
+	FZoneGraphLaneLocation LaneLocation;
+
+	/** Index into FMassTrafficStreamingSpawnRequest::EntityConfigs */
+	int32 EntityTypeIndex = INDEX_NONE;
+
+	/** Distance from the nearest viewer, in multiples of the spawning generator's ring width */
+	int32 ViewerRing = 0;
+};
+
+/**
+ * Traffic vehicles queued to be spawned incrementally over several frames, rather than all at once.
+ * @see UMassTrafficVehicleSpawnDataGenerator::bStreamingSpawn
+ * (See all STREAMINGSPAWN.)
+ */
+struct FMassTrafficStreamingSpawnRequest
+{
+	/** Spawner the request was generated for, which its spawned vehicles are tracked against */
+	TObjectKey<UObject> Owner;
+
+	TArray<TSoftObjectPtr<UMassEntityConfigAsset>> EntityConfigs;
+	TSubclassOf<UMassProcessor> SpawnDataProcessor;
+	TArray<TSubclassOf<UMassProcessor>> PostSpawnProcessors;
+
+	/** Vehicles to spawn, sorted by ViewerRing, then by lane and distance along lane so lanes are spawned whole. */
+	TArray<FMassTrafficStreamingSpawnPoint> SpawnPoints;
+
+	/** Index of the next entry in SpawnPoints to spawn */
+	int32 NextSpawnPointIndex = 0;
+
+	/** Vehicles to spawn per frame. Whole lanes are spawned at a time, so this may be exceeded by one lane's worth. */
+	int32 MaxVehiclesPerFrame = 100;
+
+	/**
+	 * FZoneGraphTrafficLaneData::NumVehiclesApproachingLane added by vehicles this request has already spawned, which
+	 * don't stop the approached lanes from being spawned in turn
+	 */
+	TMap<FZoneGraphLaneHandle, int32> NumSpawnedVehiclesApproachingLane;
+};
+
 /**
  * Subsystem that tracks mass traffic entities driving on the zone graph.
  * 
@@ -116,6 +163,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Mass Traffic")
 	void ClearAllTrafficLanes();
 
+	/**
+	 * Returns the traffic in the density grid cell containing Location, in constant time. Vehicle counts are always up
+	 * to date, while speeds are smoothed over UMassTrafficSettings::DensityGridSmoothingTime. (See all DENSITYGRID.)
+	 */
+	UFUNCTION(BlueprintPure, Category="Mass Traffic")
+	FMassTrafficDensity GetTrafficDensityAt(const FVector Location) const;
+
+	const FMassTrafficDensityGrid& GetDensityGrid() const
+	{
+		return DensityGrid;
+	}
+
+	/**
+	 * Samples the speed of a vehicle on LaneHandle for the density grid, weighted by DeltaTime since it was last
+	 * sampled. (See all DENSITYGRID.)
+	 */
+	void SampleDensityGridVehicle(const FZoneGraphLaneHandle LaneHandle, const float Speed, const float DeltaTime);
+
 	/** Find lane **/
 	UFUNCTION(BlueprintCallable, Category="Mass Traffic")
 	bool FindNearestLane(const FVector Location, const float MaxRange, FZoneGraphTagFilterEx TagFilter, FZoneGraphLaneLocationEx& LocationOnRoad, float& SqDistance) const;
@@ -132,8 +197,11 @@ public:
 	/**
 	 * Extracts and caches Mass Traffic vehicle physics simulation configuration, used for medium LOD traffic vehicle
 	 * simulation.
+	 * @param PhysicsVehicleData Optional pre-extracted physics config for PhysicsVehicleTemplateActor. If set and up
+	 *							 to date, it's used instead of spawning a temporary PhysicsVehicleTemplateActor to
+	 *							 extract from.
 	 */
-	const FMassTrafficSimpleVehiclePhysicsTemplate* GetOrExtractVehiclePhysicsTemplate(TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor);
+	const FMassTrafficSimpleVehiclePhysicsTemplate* GetOrExtractVehiclePhysicsTemplate(TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor, const UMassTrafficVehiclePhysicsDataAsset* PhysicsVehicleData = nullptr);
 
 	/** Runs a Mass query to get all the current entities tagged with FMassTrafficObstacleTag or FMassTrafficPlayerVehicleTag */
 	void GetAllObstacleLocations(TArray<FVector> & ObstacleLocations);
@@ -148,6 +216,39 @@ public:
 	 */
 	void RemoveVehiclesOverlappingPlayers();
 
+	/**
+	 * Logs the memory used by traffic lane and intersection tables, path finders, vehicle physics templates and
+	 * traffic entity archetypes, broken down by fragment type and LOD bucket. (See all MEMORYREPORT.)
+	 * @param bWriteCSV If true, the report is also written to a CSV file in the profiling directory.
+	 * @param NumTopLanes Number of traffic lanes using the most memory to also list individually.
+	 * @see MassTraffic.DumpMemory
+	 */
+	void DumpMemory(FOutputDevice& Ar, const bool bWriteCSV, const int32 NumTopLanes = 0) const;
+
+	/**
+	 * Queues vehicles to be spawned at the end of each following frame, up to Request.MaxVehiclesPerFrame at a time.
+	 * Lanes that gain vehicles, or are approached by vehicles other than those spawned by the request, before they are
+	 * reached are skipped.
+	 * (See all STREAMINGSPAWN.)
+	 */
+	void QueueStreamingSpawn(FMassTrafficStreamingSpawnRequest&& Request);
+
+	/** Discards any queued streaming spawn vehicles not yet spawned. Called when traffic lanes are cleared. */
+	void CancelStreamingSpawns()
+	{
+		StreamingSpawnRequests.Reset();
+	}
+
+	/** Discards queued streaming spawn vehicles not yet spawned on DataHandle's lanes. Called when they're removed. */
+	void CancelStreamingSpawns(const FZoneGraphDataHandle DataHandle);
+
+	/**
+	 * Discards Owner's queued streaming spawns, and destroys the vehicles it already had streamed in. Spawners don't
+	 * track streamed vehicles themselves, so this should be called when they despawn. Vehicles streamed in for a
+	 * spawner are also destroyed once the spawner itself is. (See all STREAMINGSPAWN.)
+	 */
+	void DespawnStreamingSpawnedVehicles(const UObject& Owner);
+
 #if WITH_EDITOR
 	/** Clears and rebuilds all lane and intersection data for registered zone graphs using the current settings. */
 	void RebuildLaneData();
@@ -176,6 +277,18 @@ protected:
 
 	FMassTrafficZoneGraphData* GetMutableTrafficZoneGraphData(const FZoneGraphDataHandle DataHandle);
 
+	/** Spawns the next batch of each queued streaming spawn, once Mass processing is done for the frame. */
+	void ProcessStreamingSpawns(const float DeltaSeconds);
+
+	/** Spawns the next batch of Request's vehicles, up to Request.MaxVehiclesPerFrame. */
+	void ProcessStreamingSpawnRequest(FMassTrafficStreamingSpawnRequest& Request, UMassSpawnerSubsystem& SpawnerSubsystem);
+
+	/** Destroys those of SpawnedVehicles which are still valid */
+	void DestroyStreamingSpawnedVehicles(TArray<FMassEntityHandle>& SpawnedVehicles);
+
+	/** Folds the density grid speed samples taken this frame into its averages. (See all DENSITYGRID.) */
+	void UpdateDensityGrid(const float DeltaSeconds);
+
 	UPROPERTY(Transient)
 	TObjectPtr<const UMassTrafficSettings> MassTrafficSettings = nullptr;
 
@@ -185,6 +298,10 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UZoneGraphSubsystem> ZoneGraphSubsystem = nullptr;
 
+	/** Loaded UMassTrafficSettings::OcclusionData. (See all OCCLUSIONPVS.) */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UMassTrafficOcclusionDataAsset>> OcclusionDataAssets;
+
 	TSharedPtr<FMassEntityManager> EntityManager;
 
 	FDelegateHandle OnPostZoneGraphDataAddedHandle;
@@ -213,7 +330,30 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<class UMassTrafficRecycleVehiclesOverlappingPlayersProcessor> RemoveVehiclesOverlappingPlayersProcessor = nullptr;
 
+	/** Queued streaming spawns, each spawning its next batch every frame. (See all STREAMINGSPAWN.) */
+	TArray<FMassTrafficStreamingSpawnRequest> StreamingSpawnRequests;
+
+	/** Vehicles spawned by streaming spawns, by the spawner they were spawned for. (See all STREAMINGSPAWN.) */
+	TMap<TObjectKey<UObject>, TArray<FMassEntityHandle>> StreamingSpawnedVehicles;
+
+	/** Post spawn processor instances used for streaming spawns, created on demand */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMassProcessor>> StreamingSpawnPostSpawnProcessors;
+
+	FDelegateHandle OnStreamingSpawnPhaseFinishedHandle;
+
+	/** Traffic density of all registered lanes. (See all DENSITYGRID.) */
+	FMassTrafficDensityGrid DensityGrid;
+
+	FDelegateHandle OnDensityGridPhaseFinishedHandle;
+
 	TIndirectArray<FMassTrafficSimpleVehiclePhysicsTemplate> VehiclePhysicsTemplates;
+
+	/**
+	 * VehiclePhysicsTemplates by the PhysicsVehicleTemplateActor and optional UMassTrafficVehiclePhysicsDataAsset they
+	 * were requested with, so templates built from an asset and extracted from the actor are never mixed up
+	 */
+	TMap<TPair<const UClass*, const UMassTrafficVehiclePhysicsDataAsset*>, const FMassTrafficSimpleVehiclePhysicsTemplate*> VehiclePhysicsTemplatesByKey;
 };
 
 template<>
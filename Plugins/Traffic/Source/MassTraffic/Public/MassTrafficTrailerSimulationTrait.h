@@ -57,6 +57,13 @@ struct MASSTRAFFIC_API FMassTrafficTrailerSimulationParameters : public FMassCon
 	UPROPERTY(EditAnywhere, Category = "Physics")
 	TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor;
 
+	/**
+	 * Optional physics config pre-extracted from PhysicsVehicleTemplateActor. Avoids spawning a temporary
+	 * PhysicsVehicleTemplateActor at runtime to extract the medium LOD physics config from.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Physics")
+	TObjectPtr<const UMassTrafficVehiclePhysicsDataAsset> PhysicsVehicleData = nullptr;
+
 	Chaos::FPBDJointSettings ChaosJointSettings;
 };
 
@@ -5,6 +5,8 @@
 #include "MassRepresentationProcessor.h"
 #include "MassVisualizationLODProcessor.h"
 #include "MassTrafficFragments.h"
+#include "MassTrafficInstanceGatherer.h"
+#include "MassTrafficVehicleVisualizationProcessor.h"
 #include "MassTrafficTrailerVisualizationProcessor.generated.h"
 
 class UMassTrafficSubsystem;
@@ -45,4 +47,7 @@ private:
 	UWorld* World;
 
 	FMassEntityQuery EntityQuery;
+
+	/** (See all PARALLELISMGATHER.) */
+	TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData> InstanceGatherer;
 };
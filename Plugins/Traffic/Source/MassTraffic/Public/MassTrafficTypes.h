@@ -452,6 +452,10 @@ struct MASSTRAFFIC_API FZoneGraphTrafficLaneConstData
 
 typedef TFunction< bool (const FMassEntityView& VehicleEntityView, struct FMassTrafficNextVehicleFragment& NextVehicleFragment, struct FMassZoneGraphLaneLocationFragment& LaneLocationFragment) > FTrafficVehicleExecuteFunction;
 
+struct FMassTrafficLaneDensityBuckets;
+struct FMassTrafficDensityGrid;
+struct FMassTrafficBakedZoneGraphOcclusion;
+
 USTRUCT()
 struct MASSTRAFFIC_API FZoneGraphTrafficLaneData
 {
@@ -469,6 +473,8 @@ struct MASSTRAFFIC_API FZoneGraphTrafficLaneData
 	bool bIsStoppedVehicleInPreviousLaneOverlappingThisLane : 1; // (See all CROSSWALKOVERLAP.)
 	bool bIsVehicleReadyToUseLane : 1; // (See all READYLANE.)
 	bool bIsEmergencyLane : 1;
+	bool bIsMesoscopic : 1; // ..lane is far from all viewers and simulated as an aggregate flow cell. (See all MESOSCOPIC.)
+	bool bIsInViewerFrustum : 1; // ..as of the overseer's last lane pass. (See all DENSITYBUCKETS.)
 
 	UE::MassTraffic::TFraction<true, uint8> FractionUntilClosed;
 
@@ -488,9 +494,38 @@ struct MASSTRAFFIC_API FZoneGraphTrafficLaneData
 	FMassEntityHandle GhostTailVehicle_FromSplittingLaneVehicle;
 	FMassEntityHandle GhostTailVehicle_FromMergingLaneVehicle;
 	
-	uint8 NumVehiclesOnLane = 0;
+	uint8 NumVehiclesOnLane = 0; // ..including vehicles aggregated on the lane. (See all MESOSCOPIC.)
 	uint8 NumVehiclesApproachingLane = 0; 
 	uint8 NumReservedVehiclesOnLane = 0; // See all CANTSTOPLANEEXIT.
+
+	/**
+	 * Incremented to wake all vehicles queue sleeping on this lane, e.g: when a stopped vehicle on the lane starts
+	 * moving again or a vehicle leaves the lane. (See all QUEUESLEEP.)
+	 */
+	uint16 QueueSleepEpoch = 0;
+
+	/**
+	 * Vehicles aggregated on this lane, in addition to any individual vehicles, ordered from the lane's end to its
+	 * start. On mesoscopic lanes these flow on to NextLanes. On other lanes they are waiting to be re-emitted here as
+	 * individual vehicles. (See all MESOSCOPIC.)
+	 */
+	TArray<FMassEntityHandle> MesoscopicVehicles;
+
+	/** Vehicles received from previous lanes since this lane's last mesoscopic step, yet to join MesoscopicVehicles. */
+	TArray<FMassEntityHandle> MesoscopicInflow;
+
+	/** @return Number of vehicles aggregated on this lane, which are also counted in NumVehiclesOnLane. */
+	FORCEINLINE int32 GetNumMesoscopicVehicles() const
+	{
+		return MesoscopicVehicles.Num() + MesoscopicInflow.Num();
+	}
+
+	/** Fraction of a vehicle due to flow on to NextLanes, carried over until a whole vehicle can be sent. */
+	float MesoscopicOutflow = 0.0f;
+
+	/** Aggregate speed (cm/s) and outflow (vehicles/s) of this lane's last mesoscopic step. (See all MESOSCOPIC.) */
+	FFloat16 MesoscopicSpeed = 0.0f;
+	FFloat16 MesoscopicFlow = 0.0f;
 	
 	FZoneGraphTrafficLaneData* LeftLane = nullptr; // ..non-merging non-splitting same-direction lane on left 
 	FZoneGraphTrafficLaneData* RightLane = nullptr; // ..non-merging non-splitting same-direction lane on right
@@ -510,10 +545,33 @@ struct MASSTRAFFIC_API FZoneGraphTrafficLaneData
 	/** Center location (average between start and end lane location) and radius for distance testing */
 	FVector CenterLocation;
 	FFloat16 Radius;
+
+	/** Distance from the lane bounds to the nearest Mass LOD viewer, as of the overseer's last lane pass. (See all DENSITYBUCKETS.) */
+	float DistanceToNearestViewer = 0.0f;
+
+	/**
+	 * Density buckets this lane is tracked in, updated whenever this lane's occupancy changes, and this lane's
+	 * position in them. (See all DENSITYBUCKETS.)
+	 */
+	FMassTrafficLaneDensityBuckets* DensityBuckets = nullptr;
+	int32 ExcessDensityBucketSlot = INDEX_NONE;
+	int32 FunctionalDensityBucketSlot = INDEX_NONE;
+	uint8 ExcessDensityBucket = 0;
+	uint8 FunctionalDensityBucket = 0;
+
+	/** Density grid this lane's vehicles are counted in, and the grid cell containing CenterLocation. (See all DENSITYGRID.) */
+	FMassTrafficDensityGrid* DensityGrid = nullptr;
+	int32 DensityGridCell = INDEX_NONE;
 	
 	/** Clears all references to vehicles on this lane and reset all vehicle counters */  
 	void ClearVehicles();
 
+	/** Wakes all vehicles queue sleeping on this lane. (See all QUEUESLEEP.) */
+	FORCEINLINE void WakeQueueSleepingVehicles()
+	{
+		++QueueSleepEpoch;
+	}
+
 	/**
 	 * Walks along the vehicles on this lane starting from TailVehicle and following the NextVehicle links,
 	 * calling Function on each vehicle, until we reach a vehicle on another lane or we loop back to TailVehicle.
@@ -556,6 +614,129 @@ private:
 	FFloat16 DownstreamFlowDensity = 0.0f;
 };
 
+/**
+ * Lanes bucketed by density, kept up to date as vehicles add and remove lane occupancy. This lets the overseer find
+ * the busiest and least busy lanes across the whole zone graph every frame, without scanning every lane.
+ * (See all DENSITYBUCKETS.)
+ */
+struct MASSTRAFFIC_API FMassTrafficLaneDensityBuckets
+{
+	static constexpr int32 NumBuckets = 32;
+
+	/** Lanes bucketed by BasicDensity() - MaxDensity, over [-1, 1] */
+	TArray<FZoneGraphTrafficLaneData*> ExcessDensityBuckets[NumBuckets];
+
+	/** Lanes bucketed by FunctionalDensity(), over [0, 2] */
+	TArray<FZoneGraphTrafficLaneData*> FunctionalDensityBuckets[NumBuckets];
+
+	/**
+	 * Index of the first lane to examine in each bucket on the overseer's next scan. Scans resume from here and wrap
+	 * around, so every lane in a bucket is eventually examined even if only part of it is scanned each frame.
+	 */
+	int32 ExcessDensityBucketScanStarts[NumBuckets] = {};
+	int32 FunctionalDensityBucketScanStarts[NumBuckets] = {};
+
+	FORCEINLINE static int32 GetExcessDensityBucket(const float ExcessDensity)
+	{
+		return FMath::Clamp(FMath::FloorToInt32((ExcessDensity + 1.0f) * 0.5f * NumBuckets), 0, NumBuckets - 1);
+	}
+
+	FORCEINLINE static int32 GetFunctionalDensityBucket(const float FunctionalDensity)
+	{
+		return FMath::Clamp(FMath::FloorToInt32(FunctionalDensity * 0.5f * NumBuckets), 0, NumBuckets - 1);
+	}
+
+	/** Starts tracking Lane, or moves it to the buckets matching its current density */
+	void UpdateLane(FZoneGraphTrafficLaneData& Lane);
+
+	/** Stops tracking all lanes. Must only be done along with resetting the tracked lanes. */
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+/** Traffic in a single density grid cell, as returned by UMassTrafficSubsystem::GetTrafficDensityAt. (See all DENSITYGRID.) */
+USTRUCT(BlueprintType)
+struct MASSTRAFFIC_API FMassTrafficDensity
+{
+	GENERATED_BODY()
+
+	/** Number of traffic vehicles on lanes centered in the cell */
+	UPROPERTY(BlueprintReadOnly, Category="Mass Traffic")
+	int32 NumVehicles = 0;
+
+	/** Recent average speed of vehicles in the cell, in cm/s */
+	UPROPERTY(BlueprintReadOnly, Category="Mass Traffic")
+	float AverageSpeed = 0.0f;
+
+	/** Estimated number of stopped vehicles in the cell */
+	UPROPERTY(BlueprintReadOnly, Category="Mass Traffic")
+	int32 NumStoppedVehicles = 0;
+};
+
+/**
+ * Coarse 2D grid of traffic vehicle counts, average speeds and stopped vehicles, for constant time "how busy is
+ * traffic around here" queries. Each lane is counted in the cell containing its CenterLocation, with vehicle counts
+ * kept up to date as vehicles add and remove lane occupancy. Speeds don't change with lane occupancy, so they're
+ * sampled from vehicles as they're controlled instead, and smoothed over time. (See all DENSITYGRID.)
+ */
+struct MASSTRAFFIC_API FMassTrafficDensityGrid
+{
+	struct FCell
+	{
+		int32 NumVehicles = 0;
+		float AverageSpeed = 0.0f;
+		float StoppedFraction = 0.0f;
+
+		/** Time weighted samples taken since the last UpdateAverages */
+		float SampledTime = 0.0f;
+		float SampledSpeedTime = 0.0f;
+		float SampledStoppedTime = 0.0f;
+	};
+
+	float CellSize = 10000.0f;
+
+	/** Cells containing at least one lane's CenterLocation. Cells are never removed, so lanes can cache their index. */
+	TArray<FCell> Cells;
+
+	/** Cell coordinate -> Cells index */
+	TMap<FIntPoint, int32> CellLookup;
+
+	/** Cells with samples to fold in at the next UpdateAverages */
+	TArray<int32> SampledCells;
+
+	FORCEINLINE FIntPoint GetCellCoord(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	/** Returns the cell containing Location, or nullptr if no traffic lanes are centered in it */
+	FORCEINLINE const FCell* FindCell(const FVector& Location) const
+	{
+		const int32* CellIndex = CellLookup.Find(GetCellCoord(Location));
+		return CellIndex ? &Cells[*CellIndex] : nullptr;
+	}
+
+	/** Returns the index of the cell containing Location, adding it if needed */
+	int32 FindOrAddCell(const FVector& Location);
+
+	FORCEINLINE void AddVehicles(const int32 CellIndex, const int32 NumVehiclesToAdd)
+	{
+		Cells[CellIndex].NumVehicles += NumVehiclesToAdd;
+	}
+
+	/** Samples the speed of a vehicle in CellIndex, weighted by the time since it was last sampled */
+	void SampleVehicle(const int32 CellIndex, const float Speed, const float DeltaTime, const float StoppedSpeed);
+
+	/** Blends the samples taken since the last update into the sampled cells' averages */
+	void UpdateAverages(const float SmoothingTime);
+
+	/** Removes all cells. Must only be done before any lanes are added, as lanes cache their cell index. */
+	void Reset(const float InCellSize);
+
+	SIZE_T GetAllocatedSize() const;
+};
+
 /**
  * Container for the traffic lane data associated to a specific registered ZoneGraph data.
  */
@@ -563,9 +744,20 @@ struct MASSTRAFFIC_API FMassTrafficZoneGraphData
 {
 	void Reset()
 	{
+		// The density grid outlives our lanes, so remove their vehicles from it. (See all DENSITYGRID.)
+		for (const FZoneGraphTrafficLaneData& TrafficLaneData : TrafficLaneDataArray)
+		{
+			if (TrafficLaneData.DensityGrid)
+			{
+				TrafficLaneData.DensityGrid->AddVehicles(TrafficLaneData.DensityGridCell, -TrafficLaneData.NumVehiclesOnLane);
+			}
+		}
+
 		DataHandle.Reset();
 		TrafficLaneDataArray.Reset();
 		TrafficLaneDataLookup.Reset();
+		DensityBuckets.Reset();
+		Occlusion = nullptr;
 	}
 
 	/* Handle of the storage the data was initialized from. */
@@ -577,6 +769,12 @@ struct MASSTRAFFIC_API FMassTrafficZoneGraphData
 	/* ZoneGraph lane index -> TrafficLaneDataArray entry. Array size matches ZoneGraph storage */   
 	TArray<FZoneGraphTrafficLaneData*> TrafficLaneDataLookup;
 
+	/* TrafficLaneDataArray lanes bucketed by density. (See all DENSITYBUCKETS.) */
+	FMassTrafficLaneDensityBuckets DensityBuckets;
+
+	/* Lane occlusion baked for this zone graph, if any. Owned by UMassTrafficSubsystem's occlusion data assets. (See all OCCLUSIONPVS.) */
+	const FMassTrafficBakedZoneGraphOcclusion* Occlusion = nullptr;
+
 	FORCEINLINE const FZoneGraphTrafficLaneData* GetTrafficLaneData(const FZoneGraphLaneHandle LaneHandle) const
 	{
 		return TrafficLaneDataLookup[LaneHandle.Index];
@@ -88,6 +88,31 @@ namespace UE::MassTraffic
 	};
 
 
+	/**
+	 * 2D spatial hash of obstacle locations, with a cell size equal to the exclusion radius, so testing a location
+	 * only needs to look at the obstacles in the 3x3 cells around it rather than every obstacle. 
+	 * Read only once built, so can be queried from multiple threads.
+	 */
+	class MASSTRAFFIC_API FObstacleExclusionGrid
+	{
+	public:
+		FObstacleExclusionGrid(TConstArrayView<FVector> ObstacleLocations, const float InExclusionRadius);
+
+		/** @return true if Location is within the exclusion radius of any obstacle. */
+		bool IsExcluded(const FVector& Location) const;
+
+	private:
+		FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+		{
+			return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+		}
+
+		TMap<FIntPoint, TArray<FVector, TInlineAllocator<4>>> Cells;
+		float ExclusionRadiusSquared = 0.0f;
+		float InvCellSize = 0.0f;
+	};
+
+
 	/** Used for spawning. */
 	MASSTRAFFIC_API void FindNearestVehiclesInLane(const FMassEntityManager& EntityManager,
 													const FZoneGraphTrafficLaneData& TrafficLaneData,
@@ -114,6 +139,12 @@ namespace UE::MassTraffic
 
 	MASSTRAFFIC_API LaneTurnType GetLaneTurnType(const uint32 LaneIndex, const FZoneGraphStorage& ZoneGraphStorage);
 
+	/** Returns a hash of ZoneGraphStorage's lane layout and tags, used to detect when data baked from it is out of date */
+	MASSTRAFFIC_API uint32 GetZoneGraphStorageHash(const FZoneGraphStorage& ZoneGraphStorage);
+
+	/** Returns a hash of the lane filter and densities used to choose traffic lanes, for combining with GetZoneGraphStorageHash */
+	MASSTRAFFIC_API uint32 GetTrafficLaneSettingsHash(const FZoneGraphTagFilter& LaneFilter, TConstArrayView<FMassTrafficLaneDensity> LaneDensities);
+
 
 	/** Lane search functions. */
 	MASSTRAFFIC_API bool PointIsNearSegment(
@@ -136,4 +167,53 @@ namespace UE::MassTraffic
 		const float SpeedScale = 1.0f - FMath::Clamp(TimeLeftOnLane / TimeToBlendFromLaneEnd, 0.0f, 1.0f);
 		return FMath::Lerp(SpeedLimit, MinNextLaneSpeedLimit, SpeedScale);
 	}
+
+	/** A promotion of an LOD fragment to a higher LOD, where lower Priority is more significant. (See all LODPROMOTIONBUDGET.) */
+	template <typename TLODFragment>
+	struct TLODPromotion
+	{
+		TLODFragment* LODFragment = nullptr;
+		float Priority = 0.0f;
+
+		/** Optional flag set if the promotion is reverted, e.g: to have its LOD recalculated sooner */
+		bool* RevertedFlag = nullptr;
+	};
+
+	/**
+	 * Keeps the MaxPromotions most significant of Promotions and reverts the rest to their previous LOD, to be
+	 * reconsidered the next time their LOD is calculated, setting their RevertedFlag. Promotions no longer pending are
+	 * ignored.
+	 * (See all LODPROMOTIONBUDGET.)
+	 * @return Number of promotions reverted
+	 */
+	template <typename TLODFragment>
+	int32 LimitLODPromotions(TArray<TLODPromotion<TLODFragment>>& Promotions, const int32 MaxPromotions)
+	{
+		if (Promotions.Num() <= MaxPromotions)
+		{
+			return 0;
+		}
+
+		Promotions.Sort([](const TLODPromotion<TLODFragment>& A, const TLODPromotion<TLODFragment>& B)
+		{
+			return A.Priority < B.Priority;
+		});
+
+		int32 NumReverted = 0;
+		for (int32 PromotionIndex = MaxPromotions; PromotionIndex < Promotions.Num(); ++PromotionIndex)
+		{
+			const TLODPromotion<TLODFragment>& Promotion = Promotions[PromotionIndex];
+			TLODFragment& LODFragment = *Promotion.LODFragment;
+			if (LODFragment.LOD < LODFragment.PrevLOD)
+			{
+				LODFragment.LOD = LODFragment.PrevLOD;
+				if (Promotion.RevertedFlag)
+				{
+					*Promotion.RevertedFlag = true;
+				}
+				++NumReverted;
+			}
+		}
+		return NumReverted;
+	}
 }
\ No newline at end of file
@@ -30,6 +30,9 @@ protected:
 private:
 	FMassEntityQuery EntityQuery_Conditional;
 
+	/** Vehicle validation progress over entity buckets. @see UMassTrafficProcessorBase::ForTimeSlicedEntityBuckets */
+	FMassTrafficTimeSliceCursor VehicleTimeSliceCursor;
+
 	// Density debugging
 	bool bInitDensityDebug = true;
 	TArray<float> Densities;
@@ -35,10 +35,12 @@ protected:
 		FMassTrafficLaneOffsetFragment& LaneOffsetFragment,
 		FMassTrafficObstacleAvoidanceFragment& AvoidanceFragment,
 		FMassTrafficVehicleLaneChangeFragment* LaneChangeFragment,
+		FMassTrafficAnalyticMotionFragment* AnalyticMotionFragment,
 		const FMassTrafficNextVehicleFragment& NextVehicleFragment, const bool bVisLog = false) const;
 
 	void PIDVehicleControl(
 		const FMassEntityManager& EntityManager,
+		UMassTrafficSubsystem& MassTrafficSubsystem,
 		const FMassExecutionContext& Context,
 		const int32 EntityIndex,
 		const FZoneGraphStorage& ZoneGraphStorage,
@@ -54,6 +56,7 @@ protected:
 		FMassTrafficPIDVehicleControlFragment& PIDVehicleControlFragment,
 		FMassTrafficPIDControlInterpolationFragment& VehiclePIDMovementInterpolationFragment,
 		const FMassTrafficNextVehicleFragment& NextVehicleFragment,
+		const FMassTrafficVehiclePhysicsFragment* SimplePhysicsVehicleFragment,
 		const bool bVisLog = false) const;
 
 	FMassEntityQuery SimpleVehicleControlEntityQuery_Conditional;
@@ -84,6 +84,34 @@ protected:
 		const FVector& NewVehicleWorldCenterOfMass,
 		const FQuat& NewVehicleWorldRotationOfMass);
 
+	/**
+	 * Fixed timestep substepping: Replaces the interpolated transform & velocity presented in TransformFragment &
+	 * VelocityFragment with the last simulated fixed step's, ready to be stepped. If TransformFragment no longer
+	 * matches what was presented at PresentedInterpolationAlpha, the vehicle has been moved externally (e.g: teleported,
+	 * or synced from a high LOD actor) and the simulated state is re-initialized from it instead.
+	 */
+	static void RestoreSimulatedState(
+		FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+		FTransformFragment& TransformFragment,
+		FMassVelocityFragment& VelocityFragment,
+		const float PresentedInterpolationAlpha);
+
+	/** Fixed timestep substepping: Captures the result of a fixed step as the latest simulated state */
+	static void RecordSimulatedState(
+		FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+		const FTransformFragment& TransformFragment,
+		const FMassVelocityFragment& VelocityFragment);
+
+	/**
+	 * Fixed timestep substepping: Presents the transform & velocity interpolated between the last two simulated fixed
+	 * steps in TransformFragment & VelocityFragment.
+	 */
+	static void PresentSimulatedState(
+		const FMassTrafficVehiclePhysicsFragment& SimplePhysicsVehicleFragment,
+		FTransformFragment& TransformFragment,
+		FMassVelocityFragment& VelocityFragment,
+		const float InterpolationAlpha);
+
 	FMassEntityQuery SimplePhysicsVehiclesQuery;
 
 	Chaos::FPBDJointSolverSettings ChaosConstraintSolverSettings;
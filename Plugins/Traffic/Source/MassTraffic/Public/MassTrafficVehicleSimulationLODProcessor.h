@@ -4,6 +4,7 @@
 
 #include "MassTrafficFragments.h"
 #include "MassTrafficSubsystem.h"
+#include "MassTrafficUtils.h"
 #include "MassProcessor.h"
 #include "MassLODCalculator.h"
 #include "MassLODTickRateController.h"
@@ -45,6 +46,25 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
 	float BufferHysteresisOnDistancePercentage = 10.0f;
 
+	/**
+	 * Seconds a vehicle must keep calculating a lower LOD before it's demoted, on top of the distance hysteresis.
+	 * Promotions are never delayed, and are made ahead of need by UMassTrafficPredictiveLODProcessor, so vehicles
+	 * near LOD boundaries or briefly behind a turning viewer don't thrash fragments in and out. Demotions forced by
+	 * LODMaxCount aren't delayed. (See all PREDICTIVELOD.)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
+	float DemotionDelay = 1.0f;
+
+	/**
+	 * Most vehicles promoted to a higher LOD per frame, or 0 for no limit. Vehicles closest to a viewer are promoted
+	 * first, with visible vehicles ranked as if half as far away. The rest are held at their current LOD and their
+	 * chunks' LOD recalculated next frame, to compete for the next frame's budget. This spreads out fragment additions
+	 * when many vehicles change LOD at once, e.g: when a viewer teleports.
+	 * (See all LODPROMOTIONBUDGET.)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0", UIMin = "0"), config)
+	int32 MaxPromotionsPerFrame = 50;
+
 	/** Maximum limit of entity per LOD */
 	UPROPERTY(EditAnywhere, Category = "Mass|LOD", config)
 	int32 LODMaxCount[EMassLOD::Max];
@@ -57,8 +77,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0.0", UIMin = "0.0"), config)
 	float DistanceToFrustumHysteresis = 0.0f;
 
+	/** Cached UMassTrafficSettings::bArchetypeStableSimulationLOD */
+	bool bArchetypeStableSimulationLOD = false;
+
 	TMassLODCalculator<FTrafficSimulationLODLogic> LODCalculator;
 
+	/** Promotions calculated this frame, limited to MaxPromotionsPerFrame. (See all LODPROMOTIONBUDGET.) */
+	TArray<UE::MassTraffic::TLODPromotion<FMassTrafficSimulationLODFragment>> LODPromotions;
+
 	FMassEntityQuery EntityQuery;
 	FMassEntityQuery EntityQueryCalculateLOD;
 	FMassEntityQuery EntityQueryAdjustDistances;
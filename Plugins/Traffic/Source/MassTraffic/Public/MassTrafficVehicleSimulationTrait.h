@@ -10,6 +10,8 @@
 #include "WheeledVehiclePawn.h"
 #include "MassTrafficVehicleSimulationTrait.generated.h"
 
+class UMassTrafficVehiclePhysicsDataAsset;
+
 USTRUCT()
 struct MASSTRAFFIC_API FMassTrafficVehicleSimulationParameters : public FMassConstSharedFragment
 {
@@ -30,9 +32,23 @@ struct MASSTRAFFIC_API FMassTrafficVehicleSimulationParameters : public FMassCon
 	UPROPERTY(EditAnywhere, Category = "Restrictions")
 	bool bRestrictedToTrunkLanesOnly = false;
 
+	/**
+	 * If true, unobstructed Low & Off LOD vehicles on free flowing lanes follow a closed form trajectory, skipping
+	 * full vehicle control. Adds FMassTrafficAnalyticMotionFragment. (See all ANALYTICMOTION.)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Simulation")
+	bool bAnalyticMotion = true;
+
 	/** Actor class of this agent when spawned in high resolution */
 	UPROPERTY(EditAnywhere, Category = "Physics")
 	TSubclassOf<AWheeledVehiclePawn> PhysicsVehicleTemplateActor;
+
+	/**
+	 * Optional physics config pre-extracted from PhysicsVehicleTemplateActor. Avoids spawning a temporary
+	 * PhysicsVehicleTemplateActor at runtime to extract the medium LOD physics config from.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Physics")
+	TObjectPtr<const UMassTrafficVehiclePhysicsDataAsset> PhysicsVehicleData = nullptr;
 };
 
 UCLASS(meta=(DisplayName="Traffic Vehicle Simulation"))
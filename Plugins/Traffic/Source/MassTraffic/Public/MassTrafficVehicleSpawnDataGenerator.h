@@ -10,6 +10,9 @@
 #include "ZoneGraphTypes.h"
 #include "MassTrafficVehicleSpawnDataGenerator.generated.h"
 
+class UMassTrafficSpawnPointsDataAsset;
+struct FMassTrafficBakedZoneGraphSpawnPoints;
+
 USTRUCT(BlueprintType)
 struct MASSTRAFFIC_API FMassTrafficVehicleSpacing
 {
@@ -64,12 +67,48 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	float ObstacleExclusionRadius = 5000.0f;
 
+	/**
+	 * Optional precomputed spawn points to sample from, rather than finding them along every lane at runtime. Zone
+	 * graphs without up to date baked points, or spacings not matching the baked ones, fall back to runtime generation.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TObjectPtr<const UMassTrafficSpawnPointsDataAsset> BakedSpawnPoints = nullptr;
+
+	/**
+	 * If true, rather than returning all vehicles to the spawner to create in one batch, spawn points are queued with
+	 * UMassTrafficSubsystem and spawned over multiple frames, whole lanes at a time, in rings expanding out from the
+	 * viewers. The whole population is still created, just spread over frames, and isn't topped up afterwards.
+	 *
+	 * Note: Vehicles spawned this way aren't tracked by the spawner, so won't be despawned by it. They are tracked by
+	 * UMassTrafficSubsystem instead, and destroyed when the spawner is or UMassTrafficSubsystem::DespawnStreamingSpawnedVehicles
+	 * is called for it.
+	 * (See all STREAMINGSPAWN.)
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Streaming Spawn")
+	bool bStreamingSpawn = false;
+
+	/** Width of each viewer distance ring, in cm. Rings closest to the viewers are populated first. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Streaming Spawn", meta=(EditCondition="bStreamingSpawn", ClampMin=100.0, UIMin=100.0, ForceUnits="cm"))
+	float StreamingSpawnRingWidth = 20000.0f;
+
+	/** Maximum number of vehicles to spawn per frame. Lanes are spawned whole, so this may be exceeded by one lane's worth. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Streaming Spawn", meta=(EditCondition="bStreamingSpawn", ClampMin=1, UIMin=1))
+	int32 MaxStreamingSpawnVehiclesPerFrame = 100;
+
 	/** Generate "Count" number of SpawnPoints and return as a list of position
 	 * @param Count of point to generate
 	 * @param FinishedGeneratingSpawnPointsDelegate is the callback to call once the generation is done
 	 */
 	virtual void Generate(UObject& QueryOwner, TConstArrayView<FMassSpawnedEntityType> EntityTypes, int32 Count, FFinishedGeneratingSpawnDataSignature& FinishedGeneratingSpawnPointsDelegate) const override;
 
+	/**
+	 * Finds spawn points along all lanes passing LaneFilter, spaced by Spacings and scaled by LaneDensities.
+	 * 
+	 * Lanes are processed in parallel (see MassTraffic.ParallelSpawnPointGeneration), each with its own random stream
+	 * seeded from RandomStream and the lane index, so the output doesn't depend on the number of worker threads.
+	 * LaneFilterFunction is called on the calling thread, but LaneLocationFilterFunction may be called concurrently
+	 * from multiple threads and must be thread safe.
+	 */
 	static bool FindNonOverlappingLanePoints(
 		const FZoneGraphStorage& ZoneGraphStorage,
 		const FZoneGraphTagFilter& LaneFilter,
@@ -82,4 +121,22 @@ public:
 		bool bShufflePoints = true,
 		TFunction<bool(const FZoneGraphStorage&, int32 LaneIndex)> LaneFilterFunction = nullptr,
 		TFunction<bool(const FZoneGraphLaneLocation& LaneLocation)> LaneLocationFilterFunction = nullptr);
+
+	/**
+	 * Samples spawn points for Spacings from points precomputed by BakedSpawnPoints, interleaving the spacings along
+	 * each lane by their Proportion and keeping at least MinGapBetweenSpaces between consecutive spaces.
+	 * 
+	 * @return false if Spacings with Proportion > 0 don't all match a baked spacing by Name and Space, in which case
+	 *		   FindNonOverlappingLanePoints should be used instead. 
+	 */
+	static bool SampleBakedLanePoints(
+		const FZoneGraphStorage& ZoneGraphStorage,
+		const UMassTrafficSpawnPointsDataAsset& BakedSpawnPoints,
+		const FMassTrafficBakedZoneGraphSpawnPoints& ZoneGraphSpawnPoints,
+		const FRandomStream& RandomStream,
+		const TArray<FMassTrafficVehicleSpacing>& Spacings,
+		const float MinGapBetweenSpaces,
+		TArray<TArray<FZoneGraphLaneLocation>>& OutSpawnPointsPerSpacing,
+		TFunction<bool(const FZoneGraphStorage&, int32 LaneIndex)> LaneFilterFunction = nullptr,
+		TFunction<bool(const FZoneGraphLaneLocation& LaneLocation)> LaneLocationFilterFunction = nullptr);
 };
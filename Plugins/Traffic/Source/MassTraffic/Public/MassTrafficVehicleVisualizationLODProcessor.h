@@ -4,10 +4,13 @@
 
 #include "MassTrafficFragments.h"
 #include "MassTrafficSubsystem.h"
+#include "MassTrafficUtils.h"
 #include "MassVisualizationLODProcessor.h"
 #include "MassLODCollectorProcessor.h"
 #include "MassTrafficVehicleVisualizationLODProcessor.generated.h"
 
+struct FMassTrafficBakedOcclusionCell;
+
 struct FTrafficViewerLODLogic : public FLODDefaultLogic
 {
 	enum
@@ -31,6 +34,36 @@ protected:
 	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
+	/**
+	 * Treats vehicles on lanes baked as occluded from every viewer as outside the view frustum, so they're given the
+	 * cheaper not visible LOD distances. Their original frustum distances are kept in OccludedViewerInfos and restored
+	 * once this frame's LOD has been calculated. (See all OCCLUSIONPVS.)
+	 */
+	void ApplyOcclusion(FMassExecutionContext& ExecutionContext);
+
+	/**
+	 * Most vehicles promoted to a higher visualization LOD per frame, or 0 for no limit. The most significant vehicles
+	 * are promoted first, with the rest held at their current LOD until the next frame. This spreads out actor spawns
+	 * and mesh instance changes when many vehicles change LOD at once, e.g: when a viewer teleports. Only applies to
+	 * vehicles whose LOD is calculated every frame, i.e: not far vehicles. (See all LODPROMOTIONBUDGET.)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Mass|LOD", meta = (ClampMin = "0", UIMin = "0"), config)
+	int32 MaxPromotionsPerFrame = 50;
+
+	/** Promotions calculated this frame, limited to MaxPromotionsPerFrame. (See all LODPROMOTIONBUDGET.) */
+	TArray<UE::MassTraffic::TLODPromotion<FMassRepresentationLODFragment>> LODPromotions;
+
+	/**
+	 * Baked occlusion cell containing each viewer this frame, indexed by zone graph data handle index. Empty for zone
+	 * graphs without baked occlusion, or with any viewer outside their baked cells or height bands. (See all OCCLUSIONPVS.)
+	 */
+	TArray<TArray<const FMassTrafficBakedOcclusionCell*, TInlineAllocator<4>>> ZoneGraphViewerCells;
+
+	/** Viewer info of vehicles occluded this frame, and their frustum distance before occlusion. (See all OCCLUSIONPVS.) */
+	TArray<TPair<FMassViewerInfoFragment*, float>> OccludedViewerInfos;
+
+	FMassEntityQuery OcclusionEntityQuery;
+
 #if WITH_MASSTRAFFIC_DEBUG
 	TWeakObjectPtr<UObject> LogOwner;
 #endif // WITH_MASSTRAFFIC_DEBUG
@@ -4,6 +4,7 @@
 
 #include "MassRepresentationProcessor.h"
 #include "MassTrafficFragments.h"
+#include "MassTrafficInstanceGatherer.h"
 #include "MassTrafficVehicleVisualizationProcessor.generated.h"
 
 
@@ -86,6 +87,12 @@ struct MASSTRAFFIC_API FMassTrafficPackedVehicleInstanceCustomData
 	
 	FMassTrafficPackedVehicleInstanceCustomData(const FMassTrafficVehicleInstanceCustomData& UnpackedCustomData);
 
+	/** PackedParam1 as the bits it really is, for exact comparison */
+	uint32 GetPackedParam1Bits() const
+	{
+		return reinterpret_cast<const uint32&>(PackedParam1);
+	}
+
 	/**
 	 * Bit packed param with EMassTrafficVehicleVisualizationFlags and RandomFraction packed into the least significant
 	 * bits
@@ -111,7 +118,9 @@ public:
 };
 
 /**
- * Custom visualization updates for TrafficVehicle
+ * Custom visualization updates for TrafficVehicle. Actor custom data is only written when it has changed since it was
+ * last written to the same actor. Instanced static mesh custom data is still gathered for every instance, every frame.
+ * (See all DIRTYCUSTOMDATA.)
  */
  UCLASS()
 class MASSTRAFFIC_API UMassTrafficVehicleUpdateCustomVisualizationProcessor : public UMassProcessor
@@ -129,6 +138,9 @@ protected:
 
 	FMassEntityQuery EntityQuery;
 
+	/** (See all PARALLELISMGATHER.) */
+	TMassTrafficInstanceGatherer<FMassTrafficPackedVehicleInstanceCustomData> InstanceGatherer;
+
 #if WITH_MASSTRAFFIC_DEBUG
 	FMassEntityQuery DebugEntityQuery;
 	TWeakObjectPtr<UObject> LogOwner;